@@ -295,6 +295,7 @@ src/C4Surface.cpp
 src/C4Surface.h
 src/C4SurfaceFile.cpp
 src/C4SurfaceFile.h
+src/C4SyncHash.h
 src/C4Teams.cpp
 src/C4Teams.h
 src/C4Texture.cpp
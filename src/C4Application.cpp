@@ -29,6 +29,7 @@
 #include <C4Console.h>
 #include <C4Startup.h>
 #include <C4Log.h>
+#include <C4Stat.h>
 #include <C4GamePadCon.h>
 #include <C4GameLobby.h>
 #include "C4Toast.h"
@@ -39,6 +40,7 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <string>
 
 constexpr unsigned int defaultGameTickDelay = 16;
 
@@ -251,7 +253,7 @@ bool C4Application::PreInit()
 #ifdef ENABLE_SOUND
 	try
 	{
-		if (!AudioSystem)
+		if (!AudioSystem && !Game.FastReplay)
 		{
 			AudioSystem.reset(C4AudioSystem::NewInstance(
 				Config.Sound.MaxChannels,
@@ -380,6 +382,7 @@ void C4Application::QuitGame()
 		if (fWasNetworkActive) password.Copy(Game.Network.GetPassword());
 		// the rest isn't changed by Clear()
 		decltype(Game.DefinitionFilenames) defs{Game.DefinitionFilenames};
+		const int32_t seekFrame{Game.SeekFrame};
 		// stop game
 		Game.Clear();
 		Game.Default();
@@ -394,6 +397,7 @@ void C4Application::QuitGame()
 			Game.DefinitionFilenames = defs;
 			Game.FixedDefinitions = true;
 			Game.fObserve = false;
+			Game.SeekFrame = seekFrame;
 			NextMission.Clear();
 		}
 	}
@@ -449,6 +453,16 @@ void C4Application::Execute()
 		break;
 	case C4AS_Game:
 	{
+		if (Game.FastReplay)
+		{
+			if (iRecursionCount <= 1) ExecuteFastReplay();
+			break;
+		}
+		if (Game.SeekFrame || !Game.SeekRestart.empty())
+		{
+			if (iRecursionCount <= 1) ExecuteSeek();
+			break;
+		}
 		uint32_t iThisGameTick = timeGetTime();
 		// Game (do additional timing check)
 		if (Game.IsRunning && iRecursionCount <= 1) if (Game.GameGo || !iExtraGameTickDelay || (iThisGameTick > iLastGameTick + iExtraGameTickDelay))
@@ -486,6 +500,70 @@ void C4Application::Execute()
 	--iRecursionCount;
 }
 
+void C4Application::ExecuteFastReplay()
+{
+	if (!Game.IsRunning) return;
+	if (!fastReplayStart)
+	{
+		if (!Game.Control.isReplay())
+		{
+			LogNTr(spdlog::level::err, "Fast replay: no record is being played back");
+			Quit();
+			return;
+		}
+		fastReplayStart = std::chrono::steady_clock::now();
+		fastReplayStartFrame = Game.FrameCounter;
+		C4ST_RESET
+	}
+	// execute frames without timing, graphics or sound; only return to the message loop now and then
+	const auto sliceEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds{100};
+	while (Game.Control.isReplay() && std::chrono::steady_clock::now() < sliceEnd)
+		if (!Game.Execute())
+			break;
+	if (Game.Control.isReplay()) return;
+	// record finished: show results and quit
+	const auto frames = Game.FrameCounter - fastReplayStartFrame;
+	const auto seconds = std::chrono::duration<double>{std::chrono::steady_clock::now() - *fastReplayStart}.count();
+	LogNTr("Fast replay: {} frames in {:.2f}s ({:.1f} FPS)", frames, seconds, seconds > 0 ? frames / seconds : 0.0);
+	C4ST_SHOWSTAT
+	Quit();
+}
+
+void C4Application::ExecuteSeek()
+{
+	// restart from the keyframe chosen by C4Playback::Seek
+	if (!Game.SeekRestart.empty())
+	{
+		const std::string filename{std::move(Game.SeekRestart)};
+		const int32_t seekFrame{Game.SeekFrame};
+		Game.SeekRestart.clear();
+		if (isFullScreen)
+		{
+			// QuitGame keeps SeekFrame for the next mission
+			SetNextMission(filename.c_str());
+			QuitGame();
+		}
+		// console mode reopens games from a command line
+		else if (Console.OpenGame(std::format("\"{}\"", filename).c_str()))
+		{
+			Game.SeekFrame = seekFrame;
+		}
+		return;
+	}
+	if (!Game.IsRunning) return;
+	// fast forward to the frame requested by C4Playback::Seek; only return to the message loop now and then
+	const auto sliceEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds{100};
+	while (Game.Control.isReplay() && Game.FrameCounter < Game.SeekFrame && std::chrono::steady_clock::now() < sliceEnd)
+		if (!Game.Execute())
+		{
+			// halted
+			Game.SeekFrame = 0;
+			return;
+		}
+	if (!Game.Control.isReplay() || Game.FrameCounter >= Game.SeekFrame)
+		Game.SeekFrame = 0;
+}
+
 void C4Application::OnNetworkEvents()
 {
 	InteractiveThread.ProcessEvents();
@@ -31,6 +31,7 @@
 #include "StdApp.h"
 #include <StdWindow.h>
 
+#include <chrono>
 #include <optional>
 
 class C4ToastSystem;
@@ -113,6 +114,9 @@ public:
 	C4Network2IRCClient IRCClient;
 	// Tick timing
 	unsigned int iLastGameTick, iGameTickDelay, iExtraGameTickDelay;
+	// Fast replay timing
+	std::optional<std::chrono::steady_clock::time_point> fastReplayStart;
+	int32_t fastReplayStartFrame;
 	class CStdDDraw *DDraw;
 	virtual int32_t &ScreenWidth() override { return Config.Graphics.ResX; }
 	virtual int32_t &ScreenHeight() override { return Config.Graphics.ResY; }
@@ -133,6 +137,8 @@ protected:
 	virtual void DoInit() override;
 	bool OpenGame();
 	bool PreInit();
+	void ExecuteFastReplay();
+	void ExecuteSeek();
 	virtual void OnNetworkEvents() override;
 	static bool ProcessCallback(const char *szMessage, int iProcess);
 
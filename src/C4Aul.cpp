@@ -483,6 +483,8 @@ void C4AulScriptEngine::UnLink()
 	C4AulScript::UnLink();
 	// clear string table ("hold" strings only)
 	Strings.Clear();
+	// cached callback functions are about to be deleted
+	++LinkCounter;
 	// Do not clear global variables and constants, because they are registered by the
 	// preparser. Note that keeping those fields means that you cannot delete a global
 	// variable or constant at runtime by removing it from the script.
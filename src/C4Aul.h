@@ -218,6 +218,12 @@ enum C4AulBCCType
 	AB_FOREACH_NEXT,     // foreach: next element in array
 	AB_FOREACH_MAP_NEXT, // foreach: next key-value pair in map
 	AB_RETURN,           // return statement
+
+	// superinstructions, only generated by OptimizeFn; the fused instructions stay in place as operands
+	AB_VARN_CMP_CONDN,   // VARN_V, INT/VARN_V/PARN_V, relational operator, CONDN
+	AB_PARN_CMP_CONDN,   // PARN_V, INT/VARN_V/PARN_V, relational operator, CONDN
+	AB_VARN_INC,         // VARN_R, [INT], ++/--/+=/-=, STACK (result discarded)
+
 	AB_ERR,              // parse error at this position
 	AB_EOFN,             // end of function
 	AB_EOF,              // end of file
@@ -248,6 +254,8 @@ struct C4AulBCC
 	const char *SPos;
 };
 
+const char *GetTTName(C4AulBCCType e); // opcode name for debug output
+
 // call context
 struct C4AulContext
 {
@@ -269,6 +277,7 @@ struct C4AulScriptContext : public C4AulContext
 	C4ValueList NumVars;
 	C4AulBCC *CPos;
 	time_t tTime; // initialized only by profiler if active
+	std::size_t ProfilerStack; // call stack node; initialized only by bytecode profiler if active
 
 	size_t ParCnt() const { return Vars - Pars; }
 	void dump(std::string Dump = "");
@@ -406,6 +415,10 @@ enum C4AulScriptState
 // script profiler entry
 class C4AulProfiler
 {
+public:
+	// callback function lookups through C4ScriptHost::GetCallbackFunc
+	static inline std::uint64_t CallbackLookupsCached{0}, CallbackLookupsResolved{0};
+
 private:
 	// map entry
 	struct Entry
@@ -425,10 +438,12 @@ public:
 
 	void CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime);
 	void Show();
+	const std::shared_ptr<spdlog::logger> &GetLogger() const { return logger; }
 
 	static void Abort();
-	static void StartProfiling(C4AulScript *pScript);
+	static void StartProfiling(C4AulScript *pScript, bool fBytecode = false);
 	static void StopProfiling();
+	static std::uint64_t GetOpCount(); // instructions executed since bytecode profiling was started; 0 if it isn't running
 };
 
 C4LOGGERCONFIG_NAME_TYPE(C4AulProfiler);
@@ -483,6 +498,7 @@ protected:
 	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, const char *SPos = nullptr); // add byte code chunk and advance
 	bool Preparse(); // preparse script; return if successful
 	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
+	void OptimizeFn(size_t iStart); // fold constants and fuse instruction sequences of the function just parsed
 
 	bool Parse(); // parse preparsed script; return if successful
 	void ParseDescs(); // parse function descs
@@ -545,6 +561,7 @@ public:
 	int warnCnt, errCnt; // number of warnings/errors
 	int nonStrictCnt; // number of non-strict scripts
 	int lineCnt; // line count parsed
+	std::uint32_t LinkCounter{0}; // incremented whenever scripts are linked or unlinked; invalidates cached callback functions
 
 	C4ValueList Global;
 	C4ValueMapNames GlobalNamedNames;
@@ -24,8 +24,16 @@
 #include <C4Game.h>
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
+#include <CStdFile.h>
 
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <format>
+#include <map>
+#include <memory>
+#include <optional>
+#include <unordered_map>
 
 C4AulExecError::C4AulExecError(C4Object *pObj, const std::string_view error)
 	: cObj(pObj)
@@ -141,14 +149,54 @@ private:
 	time_t tDirectExecStart, tDirectExecTotal; // profiler time for DirectExec
 	C4AulScript *pProfiledScript;
 
+	// bytecode profiler: execution counts and self times in ns per opcode, source line and call stack
+	struct BytecodeProfile
+	{
+		struct Counter
+		{
+			std::uint64_t Count{0};
+			std::uint64_t Time{0};
+		};
+
+		struct LineCounter : Counter
+		{
+			std::string Where; // "Script:Line", resolved on first execution
+		};
+
+		struct StackNode
+		{
+			std::size_t Parent;
+			std::string Name;
+			std::uint64_t Time{0};
+		};
+
+		std::array<Counter, AB_EOF + 1> Ops;
+		std::unordered_map<const char *, LineCounter> Lines;
+		std::vector<StackNode> Stacks{{0, "", 0}}; // node 0 is the root
+		std::map<std::pair<std::size_t, C4AulScriptFunc *>, std::size_t> StackIndex;
+
+		// instruction currently being timed
+		C4AulBCC *CurOp{nullptr};
+		std::size_t CurStack{0};
+		C4AulScript *CurScript{nullptr}; // nullptr for temporary scripts, which are not line-profiled
+		std::chrono::steady_clock::time_point CurStart;
+
+		std::size_t GetStack(std::size_t parent, C4AulScriptFunc *func);
+		void FinishOp(std::chrono::steady_clock::time_point now);
+		void Show(spdlog::logger &logger) const;
+		bool SaveFolded(const char *filename) const;
+	};
+	std::unique_ptr<BytecodeProfile> pBytecodeProfile; // only set while bytecode profiling is active
+
 public:
 	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
 
 	void StartTrace();
-	void StartProfiling(C4AulScript *pScript); // resets profling times and starts recording the times
+	void StartProfiling(C4AulScript *pScript, bool fBytecode); // resets profling times and starts recording the times
 	void StopProfiling(); // stop the profiler and displays results
-	void AbortProfiling() { fProfiling = false; }
+	void AbortProfiling() { fProfiling = false; pBytecodeProfile.reset(); }
+	std::uint64_t GetBytecodeOpCount() const;
 	inline void StartDirectExec() { if (fProfiling) tDirectExecStart = timeGetTime(); }
 	inline void StopDirectExec() { if (fProfiling) tDirectExecTotal += timeGetTime() - tDirectExecStart; }
 
@@ -167,6 +215,8 @@ private:
 		}
 		// Profiler: Safe time to measure difference afterwards
 		if (fProfiling) pCurCtx->tTime = timeGetTime();
+		if (pBytecodeProfile)
+			pCurCtx->ProfilerStack = pBytecodeProfile->GetStack(pCurCtx > Contexts ? pCurCtx[-1].ProfilerStack : 0, pCurCtx->Func);
 	}
 
 	void PopContext()
@@ -194,6 +244,20 @@ private:
 		pCurCtx--;
 	}
 
+	// finishes timing the previous instruction and starts timing pCPos
+	void ProfileOp(C4AulBCC *pCPos)
+	{
+		const auto now = std::chrono::steady_clock::now();
+		pBytecodeProfile->FinishOp(now);
+		pBytecodeProfile->CurOp = pCPos;
+		if (pCPos)
+		{
+			pBytecodeProfile->CurStack = pCurCtx->ProfilerStack;
+			pBytecodeProfile->CurScript = pCurCtx->TemporaryScript ? nullptr : pCurCtx->Func->pOrgScript;
+		}
+		pBytecodeProfile->CurStart = now;
+	}
+
 	void CheckOverflow(intptr_t iCnt)
 	{
 		if (ValueStackSize() + iCnt > MAX_VALUE_STACK)
@@ -337,6 +401,21 @@ private:
 			CheckOpPar<false>(pCurVal, C4ScriptOpMap[iOpID].Type1, C4ScriptOpMap[iOpID].Identifier);
 	}
 
+	// operand of a superinstruction if it is a plain integer, otherwise the unfused instructions have to handle it
+	std::optional<C4ValueInt> GetFusedIntOperand(C4AulBCCType eType, std::intptr_t iX)
+	{
+		C4Value *pValue;
+		switch (eType)
+		{
+		case AB_INT: return static_cast<C4ValueInt>(iX);
+		case AB_VARN_V: pValue = &pCurCtx->Vars[iX]; break;
+		case AB_PARN_V: pValue = &pCurCtx->Pars[iX]; break;
+		default: return std::nullopt;
+		}
+		if (pValue->IsRef() || pValue->GetType() != C4V_Int) return std::nullopt;
+		return pValue->_getInt();
+	}
+
 	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
 };
 
@@ -375,62 +454,112 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value *
 	PushContext(ctx);
 
 	// Execute
-	return Exec(pSFunc->Code, fPassErrors);
+	C4Value result{Exec(pSFunc->Code, fPassErrors)};
+	// maps can only be compacted once no script loop could be iterating over them anymore
+	if (pCurVal < Values) C4ValueHash::CompactPending();
+	return result;
 }
 
+// threaded dispatch: every instruction jumps to the next handler directly instead of going through the switch
+#if defined(USE_THREADED_DISPATCH) && defined(__GNUC__)
+#define C4AUL_THREADED_DISPATCH 1
+#define C4AUL_OP(op) case op: Label_##op
+#define C4AUL_LABEL(op) &&Label_##op
+#else
+#define C4AUL_THREADED_DISPATCH 0
+#define C4AUL_OP(op) case op
+#endif
+
 C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 {
 	// Save start context
 	C4AulScriptContext *pOldCtx = pCurCtx;
 
+#if C4AUL_THREADED_DISPATCH
+	// in C4AulBCCType order
+	static void *const DispatchTable[] =
+	{
+		C4AUL_LABEL(AB_DEREF), C4AUL_LABEL(AB_MAPA_R), C4AUL_LABEL(AB_MAPA_V), C4AUL_LABEL(AB_ARRAYA_R),
+		C4AUL_LABEL(AB_ARRAYA_V), C4AUL_LABEL(AB_ARRAY_APPEND), C4AUL_LABEL(AB_VARN_R), C4AUL_LABEL(AB_VARN_V),
+		C4AUL_LABEL(AB_PARN_R), C4AUL_LABEL(AB_PARN_V), C4AUL_LABEL(AB_LOCALN_R), C4AUL_LABEL(AB_LOCALN_V),
+		C4AUL_LABEL(AB_GLOBALN_R), C4AUL_LABEL(AB_GLOBALN_V), C4AUL_LABEL(AB_VAR_R), C4AUL_LABEL(AB_VAR_V),
+		C4AUL_LABEL(AB_PAR_R), C4AUL_LABEL(AB_PAR_V), C4AUL_LABEL(AB_FUNC), C4AUL_LABEL(AB_Inc1),
+		C4AUL_LABEL(AB_Dec1), C4AUL_LABEL(AB_BitNot), C4AUL_LABEL(AB_Not), C4AUL_LABEL(AB_Neg),
+		C4AUL_LABEL(AB_Inc1_Postfix), C4AUL_LABEL(AB_Dec1_Postfix), C4AUL_LABEL(AB_Pow), C4AUL_LABEL(AB_Div),
+		C4AUL_LABEL(AB_Mul), C4AUL_LABEL(AB_Mod), C4AUL_LABEL(AB_Sub), C4AUL_LABEL(AB_Sum),
+		C4AUL_LABEL(AB_LeftShift), C4AUL_LABEL(AB_RightShift), C4AUL_LABEL(AB_LessThan), C4AUL_LABEL(AB_LessThanEqual),
+		C4AUL_LABEL(AB_GreaterThan), C4AUL_LABEL(AB_GreaterThanEqual), C4AUL_LABEL(AB_Concat), C4AUL_LABEL(AB_EqualIdent),
+		C4AUL_LABEL(AB_Equal), C4AUL_LABEL(AB_NotEqualIdent), C4AUL_LABEL(AB_NotEqual), C4AUL_LABEL(AB_SEqual),
+		C4AUL_LABEL(AB_SNEqual), C4AUL_LABEL(AB_BitAnd), C4AUL_LABEL(AB_BitXOr), C4AUL_LABEL(AB_BitOr),
+		C4AUL_LABEL(AB_And), C4AUL_LABEL(AB_Or), C4AUL_LABEL(AB_NilCoalescing), C4AUL_LABEL(AB_PowIt),
+		C4AUL_LABEL(AB_MulIt), C4AUL_LABEL(AB_DivIt), C4AUL_LABEL(AB_ModIt), C4AUL_LABEL(AB_Inc),
+		C4AUL_LABEL(AB_Dec), C4AUL_LABEL(AB_LeftShiftIt), C4AUL_LABEL(AB_RightShiftIt), C4AUL_LABEL(AB_ConcatIt),
+		C4AUL_LABEL(AB_AndIt), C4AUL_LABEL(AB_OrIt), C4AUL_LABEL(AB_XOrIt), C4AUL_LABEL(AB_NilCoalescingIt),
+		C4AUL_LABEL(AB_Set), C4AUL_LABEL(AB_CALLGLOBAL), C4AUL_LABEL(AB_CALL), C4AUL_LABEL(AB_CALLFS),
+		C4AUL_LABEL(AB_CALLNS), C4AUL_LABEL(AB_STACK), C4AUL_LABEL(AB_NIL), C4AUL_LABEL(AB_INT),
+		C4AUL_LABEL(AB_BOOL), C4AUL_LABEL(AB_STRING), C4AUL_LABEL(AB_C4ID), C4AUL_LABEL(AB_ARRAY),
+		C4AUL_LABEL(AB_MAP), C4AUL_LABEL(AB_IVARN), C4AUL_LABEL(AB_JUMP), C4AUL_LABEL(AB_JUMPAND),
+		C4AUL_LABEL(AB_JUMPOR), C4AUL_LABEL(AB_JUMPNIL), C4AUL_LABEL(AB_JUMPNOTNIL), C4AUL_LABEL(AB_CONDN),
+		C4AUL_LABEL(AB_FOREACH_NEXT), C4AUL_LABEL(AB_FOREACH_MAP_NEXT), C4AUL_LABEL(AB_RETURN), C4AUL_LABEL(AB_VARN_CMP_CONDN),
+		C4AUL_LABEL(AB_PARN_CMP_CONDN), C4AUL_LABEL(AB_VARN_INC), C4AUL_LABEL(AB_ERR), C4AUL_LABEL(AB_EOFN),
+		C4AUL_LABEL(AB_EOF),
+	};
+	static_assert(std::size(DispatchTable) == AB_EOF + 1);
+
+	// the switch loop is kept as a fallback which can be selected at runtime
+	const bool fThreadedDispatch{Config.Developer.ThreadedDispatch};
+#endif
+
 	try
 	{
 		for (;;)
 		{
+			if (pBytecodeProfile) ProfileOp(pCPos);
+
 			bool fJump = false;
 			switch (pCPos->bccType)
 			{
-			case AB_NIL:
+			C4AUL_OP(AB_NIL):
 				PushValue(C4VNull);
 				break;
 
-			case AB_INT:
+			C4AUL_OP(AB_INT):
 				PushValue(C4VInt(static_cast<C4ValueInt>(pCPos->bccX)));
 				break;
 
-			case AB_BOOL:
+			C4AUL_OP(AB_BOOL):
 				PushValue(C4VBool(!!pCPos->bccX));
 				break;
 
-			case AB_STRING:
+			C4AUL_OP(AB_STRING):
 				PushString(reinterpret_cast<C4String *>(pCPos->bccX));
 				break;
 
-			case AB_C4ID:
+			C4AUL_OP(AB_C4ID):
 				PushValue(C4VID(static_cast<C4ID>(pCPos->bccX)));
 				break;
 
-			case AB_EOFN:
+			C4AUL_OP(AB_EOFN):
 				throw C4AulExecError(pCurCtx->Obj, "function didn't return");
 
-			case AB_ERR:
+			C4AUL_OP(AB_ERR):
 				throw C4AulExecError(pCurCtx->Obj, "syntax error: see previous parser error for details.");
 
-			case AB_PARN_R:
+			C4AUL_OP(AB_PARN_R):
 				PushValueRef(pCurCtx->Pars[pCPos->bccX]);
 				break;
-			case AB_PARN_V:
+			C4AUL_OP(AB_PARN_V):
 				PushValue(pCurCtx->Pars[pCPos->bccX]);
 				break;
 
-			case AB_VARN_R:
+			C4AUL_OP(AB_VARN_R):
 				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
 				break;
-			case AB_VARN_V:
+			C4AUL_OP(AB_VARN_V):
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
 				break;
 
-			case AB_LOCALN_R: case AB_LOCALN_V:
+			C4AUL_OP(AB_LOCALN_R): C4AUL_OP(AB_LOCALN_V):
 				if (!pCurCtx->Obj)
 					throw C4AulExecError(pCurCtx->Obj, "can't access local variables in a definition call!");
 				if (pCurCtx->Func->Owner->Def != pCurCtx->Obj->Def)
@@ -455,37 +584,37 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					PushValue(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
 				break;
 
-			case AB_GLOBALN_R:
+			C4AUL_OP(AB_GLOBALN_R):
 				PushValueRef(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
 				break;
-			case AB_GLOBALN_V:
+			C4AUL_OP(AB_GLOBALN_V):
 				PushValue(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
 				break;
 			// prefix
-			case AB_Inc1: // ++
+			C4AUL_OP(AB_Inc1): // ++
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				++pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
 				break;
-			case AB_Dec1: // --
+			C4AUL_OP(AB_Dec1): // --
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				--pCurVal->GetData().Int;
 				pCurVal->HintType(C4V_Int);
 				break;
-			case AB_BitNot: // ~
+			C4AUL_OP(AB_BitNot): // ~
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(~pCurVal->_getInt());
 				break;
-			case AB_Not: // !
+			C4AUL_OP(AB_Not): // !
 				CheckOpPar(pCPos->bccX);
 				pCurVal->SetBool(!pCurVal->_getRaw());
 				break;
-			case AB_Neg: // -
+			C4AUL_OP(AB_Neg): // -
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(-pCurVal->_getInt());
 				break;
 			// postfix (whithout second statement)
-			case AB_Inc1_Postfix: // ++
+			C4AUL_OP(AB_Inc1_Postfix): // ++
 			{
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
@@ -494,7 +623,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				orig.HintType(C4V_Int);
 				break;
 			}
-			case AB_Dec1_Postfix: // --
+			C4AUL_OP(AB_Dec1_Postfix): // --
 			{
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
 				auto &orig = pCurVal->GetRefVal();
@@ -504,7 +633,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 			// postfix
-			case AB_Pow: // **
+			C4AUL_OP(AB_Pow): // **
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -512,7 +641,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Div: // /
+			C4AUL_OP(AB_Div): // /
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -523,7 +652,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Mul: // *
+			C4AUL_OP(AB_Mul): // *
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -531,7 +660,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Mod: // %
+			C4AUL_OP(AB_Mod): // %
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -542,7 +671,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Sub: // -
+			C4AUL_OP(AB_Sub): // -
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -550,7 +679,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Sum: // +
+			C4AUL_OP(AB_Sum): // +
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -558,7 +687,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_LeftShift: // <<
+			C4AUL_OP(AB_LeftShift): // <<
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -566,7 +695,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_RightShift: // >>
+			C4AUL_OP(AB_RightShift): // >>
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -574,7 +703,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_LessThan: // <
+			C4AUL_OP(AB_LessThan): // <
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -582,7 +711,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_LessThanEqual: // <=
+			C4AUL_OP(AB_LessThanEqual): // <=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -590,7 +719,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_GreaterThan: // >
+			C4AUL_OP(AB_GreaterThan): // >
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -598,7 +727,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_GreaterThanEqual: // >=
+			C4AUL_OP(AB_GreaterThanEqual): // >=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -606,8 +735,8 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Concat: // ..
-			case AB_ConcatIt: // ..=
+			C4AUL_OP(AB_Concat): // ..
+			C4AUL_OP(AB_ConcatIt): // ..=
 			{
 				const auto operatorName = C4ScriptOpMap[pCPos->bccX].Identifier;
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
@@ -664,14 +793,14 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 						}
 
 						par1String->Append(*par2String);
-						pPar1->SetString(new C4String(std::move(*par1String), &pCurCtx->Func->Owner->GetEngine()->Strings));
+						pPar1->SetString(pCurCtx->Func->Owner->GetEngine()->Strings.RegString(std::move(*par1String)));
 						PopValue();
 						break;
 					}
 				}
 				break;
 			}
-			case AB_EqualIdent: // old ==
+			C4AUL_OP(AB_EqualIdent): // old ==
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -679,7 +808,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Equal: // new ==
+			C4AUL_OP(AB_Equal): // new ==
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -687,7 +816,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_NotEqualIdent: // old !=
+			C4AUL_OP(AB_NotEqualIdent): // old !=
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -695,7 +824,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_NotEqual: // new !=
+			C4AUL_OP(AB_NotEqual): // new !=
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -703,25 +832,23 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_SEqual: // S=, eq
+			C4AUL_OP(AB_SEqual): // S=, eq
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(SEqual(pPar1->_getStr() ? pPar1->_getStr()->Data.getData() : "",
-					pPar2->_getStr() ? pPar2->_getStr()->Data.getData() : ""));
+				pPar1->SetBool(C4String::Equals(pPar1->_getStr(), pPar2->_getStr()));
 				PopValue();
 				break;
 			}
-			case AB_SNEqual: // ne
+			C4AUL_OP(AB_SNEqual): // ne
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
-				pPar1->SetBool(!SEqual(pPar1->_getStr() ? pPar1->_getStr()->Data.getData() : "",
-					pPar2->_getStr() ? pPar2->_getStr()->Data.getData() : ""));
+				pPar1->SetBool(!C4String::Equals(pPar1->_getStr(), pPar2->_getStr()));
 				PopValue();
 				break;
 			}
-			case AB_BitAnd: // &
+			C4AUL_OP(AB_BitAnd): // &
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -729,7 +856,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_BitXOr: // ^
+			C4AUL_OP(AB_BitXOr): // ^
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -737,7 +864,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_BitOr: // |
+			C4AUL_OP(AB_BitOr): // |
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -745,7 +872,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_And: // &&
+			C4AUL_OP(AB_And): // &&
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -753,7 +880,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Or: // ||
+			C4AUL_OP(AB_Or): // ||
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -762,7 +889,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_PowIt: // **=
+			C4AUL_OP(AB_PowIt): // **=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -771,7 +898,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_MulIt: // *=
+			C4AUL_OP(AB_MulIt): // *=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -780,7 +907,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_DivIt: // /=
+			C4AUL_OP(AB_DivIt): // /=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -789,7 +916,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_ModIt: // %=
+			C4AUL_OP(AB_ModIt): // %=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -798,7 +925,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Inc: // +=
+			C4AUL_OP(AB_Inc): // +=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -807,7 +934,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_Dec: // -=
+			C4AUL_OP(AB_Dec): // -=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -816,7 +943,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_LeftShiftIt: // <<=
+			C4AUL_OP(AB_LeftShiftIt): // <<=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -825,7 +952,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_RightShiftIt: // >>=
+			C4AUL_OP(AB_RightShiftIt): // >>=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -834,7 +961,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_AndIt: // &=
+			C4AUL_OP(AB_AndIt): // &=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -843,7 +970,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_OrIt: // |=
+			C4AUL_OP(AB_OrIt): // |=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -852,7 +979,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_XOrIt: // ^=
+			C4AUL_OP(AB_XOrIt): // ^=
 			{
 				CheckOpPars<C4V_Int, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -861,7 +988,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_NilCoalescingIt:
+			C4AUL_OP(AB_NilCoalescingIt):
 			{
 				if (pCurVal[0].GetType() != C4V_Any)
 				{
@@ -870,7 +997,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 			}
-			case AB_Set: // =
+			C4AUL_OP(AB_Set): // =
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -878,7 +1005,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_ARRAY:
+			C4AUL_OP(AB_ARRAY):
 			{
 				// Create array
 				C4ValueArray *pArray = new C4ValueArray(pCPos->bccX);
@@ -899,7 +1026,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_MAP:
+			C4AUL_OP(AB_MAP):
 			{
 				C4ValueHash *map = new C4ValueHash;
 				for (int i = 0; i < pCPos->bccX; ++i)
@@ -918,7 +1045,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_ARRAYA_R: case AB_ARRAYA_V:
+			C4AUL_OP(AB_ARRAYA_R): C4AUL_OP(AB_ARRAYA_V):
 			{
 				C4Value &Container = pCurVal[-1].GetRefVal();
 				C4Value &Index = pCurVal[0];
@@ -955,7 +1082,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					{
 						StdStrBuf result;
 						result.AppendChar(str.getData()[index]);
-						pCurVal[-1].SetString(new C4String(std::move(result), &pCurCtx->Func->Owner->GetEngine()->Strings));
+						pCurVal[-1].SetString(pCurCtx->Func->Owner->GetEngine()->Strings.RegString(std::move(result)));
 					}
 					PopValue();
 					break;
@@ -964,7 +1091,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					throw C4AulExecError(pCurCtx->Obj, std::format("indexed access: can't access {} by index!", Container.GetTypeName()));
 			}
 
-			case AB_MAPA_R: case AB_MAPA_V:
+			C4AUL_OP(AB_MAPA_R): C4AUL_OP(AB_MAPA_V):
 			{
 				C4Value &Map = pCurVal->GetRefVal();
 				if (Map.GetType() == C4V_Any)
@@ -983,7 +1110,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_ARRAY_APPEND:
+			C4AUL_OP(AB_ARRAY_APPEND):
 			{
 				C4Value &Array = pCurVal[0].GetRefVal();
 				// Typcheck
@@ -996,23 +1123,23 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_DEREF:
+			C4AUL_OP(AB_DEREF):
 				pCurVal[0].Deref();
 				[[fallthrough]];
 
-			case AB_STACK:
+			C4AUL_OP(AB_STACK):
 				if (pCPos->bccX < 0)
 					PopValues(-pCPos->bccX);
 				else
 					PushNullVals(pCPos->bccX);
 				break;
 
-			case AB_JUMP:
+			C4AUL_OP(AB_JUMP):
 				fJump = true;
 				pCPos += pCPos->bccX;
 				break;
 
-			case AB_JUMPAND:
+			C4AUL_OP(AB_JUMPAND):
 				if (!pCurVal[0])
 				{
 					fJump = true;
@@ -1024,7 +1151,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPOR:
+			C4AUL_OP(AB_JUMPOR):
 				if (pCurVal[0])
 				{
 					fJump = true;
@@ -1036,7 +1163,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPNIL:
+			C4AUL_OP(AB_JUMPNIL):
 				if (pCurVal[0].GetType() == C4V_Any)
 				{
 					pCurVal[0].Deref();
@@ -1045,7 +1172,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_JUMPNOTNIL:
+			C4AUL_OP(AB_JUMPNOTNIL):
 				if (pCurVal[0].GetType() != C4V_Any)
 				{
 					fJump = true;
@@ -1057,7 +1184,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_CONDN:
+			C4AUL_OP(AB_CONDN):
 				if (!pCurVal[0])
 				{
 					fJump = true;
@@ -1066,7 +1193,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 
-			case AB_RETURN:
+			C4AUL_OP(AB_RETURN):
 			{
 				// Resolve reference
 				if (!pCurCtx->Func->SFunc()->bReturnRef)
@@ -1087,6 +1214,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					// Get return value and stop executing.
 					C4Value rVal = *pCurVal;
 					PopValuesUntil(pCurCtx->Pars - 1);
+					if (pBytecodeProfile) ProfileOp(nullptr);
 					PopContext();
 					return rVal;
 				}
@@ -1108,7 +1236,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_FUNC:
+			C4AUL_OP(AB_FUNC):
 			{
 				// Get function call data
 				C4AulFunc *pFunc = reinterpret_cast<C4AulFunc *>(pCPos->bccX);
@@ -1130,7 +1258,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_VAR_R: case AB_VAR_V:
+			C4AUL_OP(AB_VAR_R): C4AUL_OP(AB_VAR_V):
 				if (!pCurVal->ConvertTo(C4V_Int))
 					throw C4AulExecError(pCurCtx->Obj, std::format("Var: index of type {}, int expected!", pCurVal->GetTypeName()));
 				// Push reference to variable on the stack
@@ -1140,7 +1268,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					pCurVal->Set(pCurCtx->NumVars.GetItem(pCurVal->_getInt()));
 				break;
 
-			case AB_PAR_R: case AB_PAR_V:
+			C4AUL_OP(AB_PAR_R): C4AUL_OP(AB_PAR_V):
 				if (!pCurVal->ConvertTo(C4V_Int))
 					throw C4AulExecError(pCurCtx->Obj, std::format("Par: index of type {}, int expected!", pCurVal->GetTypeName()));
 				// Push reference to parameter on the stack
@@ -1155,7 +1283,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					pCurVal->Set0();
 				break;
 
-			case AB_FOREACH_NEXT:
+			C4AUL_OP(AB_FOREACH_NEXT):
 			{
 				// This should always hold
 				assert(pCurVal->ConvertTo(C4V_Int));
@@ -1182,56 +1310,97 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_FOREACH_MAP_NEXT:
+			C4AUL_OP(AB_FOREACH_MAP_NEXT):
 			{
 				// This should always hold
 				assert(pCurVal[-1].ConvertTo(C4V_Int));
-				using Iterator = C4ValueHash::Iterator;
-				auto iterator = reinterpret_cast<Iterator *>(pCurVal[0]._getRef());
+				// The cursor is a plain index into the map's entries, so leaving the loop early doesn't need any cleanup
+				std::size_t index{static_cast<std::size_t>(pCurVal[0]._getInt())};
 				// Check map the first time only
-				if (!iterator)
+				if (!index)
 				{
 					if (!pCurVal[-2].ConvertTo(C4V_Map))
-						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got {}!", pCurVal[-1].GetTypeName()));
+						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got {}!", pCurVal[-2].GetTypeName()));
 					if (!pCurVal[-2]._getMap())
 						throw C4AulExecError(pCurCtx->Obj, std::format("for: map expected, but got nil!"));
 				}
 				C4ValueHash *map = pCurVal[-2]._getMap();
-				if (!iterator)
-				{
-					iterator = new Iterator (map->begin());
-					pCurVal[0].SetInt(1);
-					pCurVal[0].GetData().Ref = reinterpret_cast<C4Value *>(iterator);
-				}
+				C4Value *key, *value;
 				// No more entries?
-				if (*iterator == map->end())
+				if (!map->nextEntry(index, key, value))
 				{
-					delete iterator;
 					break;
 				}
 				// Get next
-				pCurCtx->Vars[pCPos->bccX] = (**iterator).first;
-				pCurCtx->Vars[pCurVal[-1]._getInt()] = (**iterator).second;
-
-				++(*iterator);
+				pCurCtx->Vars[pCPos->bccX] = *key;
+				pCurCtx->Vars[pCurVal[-1]._getInt()] = *value;
+				pCurVal[0].SetInt(static_cast<C4ValueInt>(index));
 				// Jump over next instruction
 				pCPos += 2;
 				fJump = true;
 				break;
 			}
 
-			case AB_IVARN:
+			C4AUL_OP(AB_VARN_CMP_CONDN): C4AUL_OP(AB_PARN_CMP_CONDN):
+			{
+				const bool fVar = pCPos->bccType == AB_VARN_CMP_CONDN;
+				const auto iLeft = GetFusedIntOperand(fVar ? AB_VARN_V : AB_PARN_V, pCPos->bccX);
+				const auto iRight = GetFusedIntOperand(pCPos[1].bccType, pCPos[1].bccX);
+				if (!iLeft || !iRight)
+				{
+					// generic path: execute the first instruction, the others follow unfused
+					PushValue(fVar ? pCurCtx->Vars[pCPos->bccX] : pCurCtx->Pars[pCPos->bccX]);
+					break;
+				}
+				bool fCondition;
+				switch (pCPos[2].bccType)
+				{
+				case AB_LessThan: fCondition = *iLeft < *iRight; break;
+				case AB_LessThanEqual: fCondition = *iLeft <= *iRight; break;
+				case AB_GreaterThan: fCondition = *iLeft > *iRight; break;
+				case AB_GreaterThanEqual: fCondition = *iLeft >= *iRight; break;
+				default: assert(false); fCondition = false; break;
+				}
+				fJump = true;
+				pCPos += fCondition ? 4 : 3 + pCPos[3].bccX;
+				break;
+			}
+
+			C4AUL_OP(AB_VARN_INC):
+			{
+				C4Value &rVar = pCurCtx->Vars[pCPos->bccX].GetRefVal();
+				if (rVar.GetType() != C4V_Int)
+				{
+					PushValueRef(pCurCtx->Vars[pCPos->bccX]);
+					break;
+				}
+				C4AulBCC *pOp = pCPos + 1;
+				C4ValueInt iBy = 1;
+				if (pOp->bccType == AB_INT)
+					iBy = static_cast<C4ValueInt>((pOp++)->bccX);
+				if (pOp->bccType == AB_Dec1 || pOp->bccType == AB_Dec1_Postfix || pOp->bccType == AB_Dec)
+					rVar.GetData().Int -= iBy;
+				else
+					rVar.GetData().Int += iBy;
+				// the stack instruction would also have popped the reference
+				PopValues(-pOp[1].bccX - 1);
+				fJump = true;
+				pCPos = pOp + 2;
+				break;
+			}
+
+			C4AUL_OP(AB_IVARN):
 				pCurCtx->Vars[pCPos->bccX] = pCurVal[0];
 				PopValue();
 				break;
 
-			case AB_CALLNS:
+			C4AUL_OP(AB_CALLNS):
 				// Ignore. TODO: Fix this.
 				break;
 
-			case AB_CALL:
-			case AB_CALLFS:
-			case AB_CALLGLOBAL:
+			C4AUL_OP(AB_CALL):
+			C4AUL_OP(AB_CALLFS):
+			C4AUL_OP(AB_CALLGLOBAL):
 			{
 				const auto isGlobal = pCPos->bccType == AB_CALLGLOBAL;
 				C4Value *pPars = pCurVal - C4AUL_MAX_Par + 1;
@@ -1322,17 +1491,27 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			}
 
 			default:
-			case AB_NilCoalescing:
+			C4AUL_OP(AB_NilCoalescing): C4AUL_OP(AB_EOF):
 				assert(false);
 			}
 
 			// Continue
 			if (!fJump)
 				pCPos++;
+
+#if C4AUL_THREADED_DISPATCH
+			if (fThreadedDispatch)
+			{
+				if (pBytecodeProfile) ProfileOp(pCPos);
+				fJump = false;
+				goto *DispatchTable[pCPos->bccType];
+			}
+#endif
 		}
 	}
 	catch (const C4AulError &e)
 	{
+		if (pBytecodeProfile) ProfileOp(nullptr);
 		// Save current position
 		pOldCtx->CPos = pCPos;
 		// Pass?
@@ -1358,6 +1537,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 	return C4VNull;
 }
 
+#undef C4AUL_LABEL
+#undef C4AUL_OP
+#undef C4AUL_THREADED_DISPATCH
+
 static void ErrorOrWarning(C4Object *context, const std::string_view message, bool warning)
 {
 	if (warning)
@@ -1553,7 +1736,7 @@ void C4AulExec::StartTrace()
 	}
 }
 
-void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
+void C4AulExec::StartProfiling(C4AulScript *pProfiledScript, bool fBytecode)
 {
 	// stop previous profiler run
 	if (fProfiling) AbortProfiling();
@@ -1564,8 +1747,16 @@ void C4AulExec::StartProfiling(C4AulScript *pProfiledScript)
 	tDirectExecStart = tNow; // in case profiling is started from DirectExec
 	tDirectExecTotal = 0;
 	pProfiledScript->ResetProfilerTimes();
+	C4AulProfiler::CallbackLookupsCached = C4AulProfiler::CallbackLookupsResolved = 0;
 	for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
 		pCtx->tTime = tNow;
+	// bytecode profiling: also needs stack nodes for the contexts already running
+	if (fBytecode)
+	{
+		pBytecodeProfile = std::make_unique<BytecodeProfile>();
+		for (C4AulScriptContext *pCtx = Contexts; pCtx <= pCurCtx; ++pCtx)
+			pCtx->ProfilerStack = pBytecodeProfile->GetStack(pCtx > Contexts ? pCtx[-1].ProfilerStack : 0, pCtx->Func);
+	}
 }
 
 void C4AulExec::StopProfiling()
@@ -1578,11 +1769,107 @@ void C4AulExec::StopProfiling()
 	Profiler.CollectEntry(nullptr, tDirectExecTotal);
 	pProfiledScript->CollectProfilerTimes(Profiler);
 	Profiler.Show();
+	// bytecode profiler results
+	if (pBytecodeProfile)
+	{
+		const std::unique_ptr<BytecodeProfile> profile{std::move(pBytecodeProfile)};
+		profile->FinishOp(std::chrono::steady_clock::now());
+		profile->Show(*Profiler.GetLogger());
+		const char *const filename{Config.AtExePath(C4CFN_ScriptProfile)};
+		if (profile->SaveFolded(filename))
+			Profiler.GetLogger()->info("Folded call stacks saved to {}", filename);
+		else
+			Profiler.GetLogger()->error("Could not save folded call stacks to {}", filename);
+	}
+}
+
+std::uint64_t C4AulExec::GetBytecodeOpCount() const
+{
+	if (!pBytecodeProfile) return 0;
+	std::uint64_t count{0};
+	for (const auto &op : pBytecodeProfile->Ops)
+		count += op.Count;
+	return count;
+}
+
+std::size_t C4AulExec::BytecodeProfile::GetStack(const std::size_t parent, C4AulScriptFunc *const func)
+{
+	const auto [it, inserted] = StackIndex.try_emplace({parent, func}, Stacks.size());
+	if (inserted)
+		Stacks.push_back({parent, func && *func->Name ? func->GetFullName() : "DirectExec", 0});
+	return it->second;
+}
+
+void C4AulExec::BytecodeProfile::FinishOp(const std::chrono::steady_clock::time_point now)
+{
+	if (!CurOp) return;
+	const auto time = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - CurStart).count());
+	Counter &op{Ops[CurOp->bccType]};
+	++op.Count;
+	op.Time += time;
+	Stacks[CurStack].Time += time;
+	if (CurScript && CurOp->SPos)
+	{
+		const auto [it, inserted] = Lines.try_emplace(CurOp->SPos);
+		if (inserted)
+			it->second.Where = std::format("{}:{}", CurScript->ScriptName, SGetLine(CurScript->GetScript(), CurOp->SPos));
+		++it->second.Count;
+		it->second.Time += time;
+	}
+	CurOp = nullptr;
+}
+
+void C4AulExec::BytecodeProfile::Show(spdlog::logger &logger) const
+{
+	// opcodes, sorted by time
+	std::vector<std::pair<const char *, Counter>> ops;
+	for (std::size_t i = 0; i < Ops.size(); ++i)
+		if (Ops[i].Count)
+			ops.emplace_back(GetTTName(static_cast<C4AulBCCType>(i)), Ops[i]);
+	std::ranges::sort(ops, std::greater{}, [](const auto &entry) { return entry.second.Time; });
+	logger.info("Opcode statistics:");
+	logger.info("==============================");
+	for (const auto &[name, counter] : ops)
+		logger.info("{:>12}ns\t{:>10}x\t{}", counter.Time, counter.Count, name);
+	logger.info("==============================");
+
+	// source lines; the same line may have been compiled to several positions
+	std::map<std::string_view, Counter> lines;
+	for (const auto &[pos, counter] : Lines)
+	{
+		Counter &line{lines[counter.Where]};
+		line.Count += counter.Count;
+		line.Time += counter.Time;
+	}
+	std::vector<std::pair<std::string_view, Counter>> sortedLines{lines.begin(), lines.end()};
+	std::ranges::sort(sortedLines, std::greater{}, [](const auto &entry) { return entry.second.Time; });
+	logger.info("Line statistics:");
+	logger.info("==============================");
+	for (const auto &[where, counter] : sortedLines)
+		logger.info("{:>12}ns\t{:>10}x\t{}", counter.Time, counter.Count, where);
+	logger.info("==============================");
+}
+
+bool C4AulExec::BytecodeProfile::SaveFolded(const char *const filename) const
+{
+	// one line per call stack: "Outer;Inner;Innermost <self time in ns>"
+	std::string folded;
+	for (std::size_t i = 1; i < Stacks.size(); ++i)
+	{
+		if (!Stacks[i].Time) continue;
+		std::string stack{Stacks[i].Name};
+		for (std::size_t parent = Stacks[i].Parent; parent; parent = Stacks[parent].Parent)
+			stack.insert(0, Stacks[parent].Name + ';');
+		folded += std::format("{} {}\n", stack, Stacks[i].Time);
+	}
+
+	CStdFile file;
+	return file.Create(filename) && file.Write(folded.data(), folded.size()) && file.Close();
 }
 
-void C4AulProfiler::StartProfiling(C4AulScript *pScript)
+void C4AulProfiler::StartProfiling(C4AulScript *pScript, bool fBytecode)
 {
-	AulExec.StartProfiling(pScript);
+	AulExec.StartProfiling(pScript, fBytecode);
 }
 
 void C4AulProfiler::StopProfiling()
@@ -1595,6 +1882,11 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
+std::uint64_t C4AulProfiler::GetOpCount()
+{
+	return AulExec.GetBytecodeOpCount();
+}
+
 void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
 {
 	// zero entries are not collected to have a cleaner list
@@ -1620,6 +1912,7 @@ void C4AulProfiler::Show()
 		logger->info("{:05}ms\t{}", e.tProfileTime, e.pFunc ? (e.pFunc->GetFullName().c_str()) : "Direct exec");
 	}
 	logger->info("==============================");
+	logger->info("Callback lookups: {} cached, {} resolved by name", CallbackLookupsCached, CallbackLookupsResolved);
 	// done!
 }
 
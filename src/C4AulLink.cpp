@@ -256,6 +256,9 @@ bool C4AulScript::ReloadScript(const char *szPath)
 
 void C4AulScriptEngine::Link(C4DefList *rDefs)
 {
+	// functions are about to be replaced
+	++LinkCounter;
+
 	try
 	{
 		// resolve appends
@@ -19,11 +19,16 @@
 
 #include <C4Aul.h>
 
+#include <C4Config.h>
 #include <C4Def.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
 #include <cinttypes>
+#include <limits>
+#include <optional>
+#include <vector>
 
 #define DEBUG_BYTECODE_DUMP 0
 
@@ -818,7 +823,7 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, std::intptr_t *pInt,
 	}
 }
 
-[[maybe_unused]] static const char *GetTTName(C4AulBCCType e)
+const char *GetTTName(C4AulBCCType e)
 {
 	switch (e)
 	{
@@ -916,6 +921,9 @@ C4AulTokenType C4AulParseState::GetNextToken(char *pToken, std::intptr_t *pInt,
 	case AB_FOREACH_NEXT:     return "AB_FOREACH_NEXT";     // foreach: next element
 	case AB_FOREACH_MAP_NEXT: return "AB_FOREACH_MAP_NEXT"; // foreach: next element
 	case AB_RETURN:           return "AB_RETURN";           // return statement
+	case AB_VARN_CMP_CONDN:   return "AB_VARN_CMP_CONDN";   // superinstruction: compare named var and branch
+	case AB_PARN_CMP_CONDN:   return "AB_PARN_CMP_CONDN";   // superinstruction: compare named par and branch
+	case AB_VARN_INC:         return "AB_VARN_INC";         // superinstruction: increment named var
 	case AB_ERR:              return "AB_ERR";              // parse error at this position
 	case AB_EOFN:             return "AB_EOFN";             // end of function
 	case AB_EOF:              return "AB_EOF";
@@ -1425,10 +1433,174 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 		state.SetNoRef();
 		AddBCC(AB_RETURN, 0, state.SPos);
 	}
+	// optimize
+	if (Config.Developer.OptimizeBytecode)
+		OptimizeFn(reinterpret_cast<std::intptr_t>(Fn->Code));
 	// done
 	return;
 }
 
+namespace
+{
+	void DumpBytecode(spdlog::logger &logger, const C4AulBCC *code, const size_t size)
+	{
+		for (const C4AulBCC *pBCC = code; pBCC < code + size; pBCC++)
+		{
+			const C4AulBCCType eType = pBCC->bccType;
+			const auto X = pBCC->bccX;
+			switch (eType)
+			{
+			case AB_FUNC: case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+				logger.info("{}\t'{}'", GetTTName(eType), X ? (reinterpret_cast<C4AulFunc *>(X))->Name : ""); break;
+			case AB_STRING:
+				logger.info("{}\t'{}'", GetTTName(eType), X ? (reinterpret_cast<C4String *>(X))->Data.getData() : ""); break;
+			default:
+				logger.info("{}\t{}", GetTTName(eType), X); break;
+			}
+		}
+	}
+
+	// evaluates integer operators on constant operands; nullopt if the result is not known at parse time
+	std::optional<C4ValueInt> FoldConstant(const C4AulBCCType eType, const std::int64_t iLeft, const std::int64_t iRight)
+	{
+		std::int64_t iResult;
+		switch (eType)
+		{
+		case AB_Sum: iResult = iLeft + iRight; break;
+		case AB_Sub: iResult = iLeft - iRight; break;
+		case AB_Mul: iResult = iLeft * iRight; break;
+		// division by zero yields 0 or nil depending on the strictness, so leave it to the runtime
+		case AB_Div: if (!iRight) return std::nullopt; iResult = iLeft / iRight; break;
+		case AB_Mod: if (!iRight) return std::nullopt; iResult = iLeft % iRight; break;
+		case AB_BitAnd: iResult = iLeft & iRight; break;
+		case AB_BitOr: iResult = iLeft | iRight; break;
+		case AB_BitXOr: iResult = iLeft ^ iRight; break;
+		default: return std::nullopt;
+		}
+		// overflow behaves differently at runtime
+		if (!Inside<std::int64_t>(iResult, std::numeric_limits<C4ValueInt>::min(), std::numeric_limits<C4ValueInt>::max()))
+			return std::nullopt;
+		return static_cast<C4ValueInt>(iResult);
+	}
+
+	bool IsRelationalOperator(const C4AulBCCType eType) noexcept
+	{
+		return eType == AB_LessThan || eType == AB_LessThanEqual || eType == AB_GreaterThan || eType == AB_GreaterThanEqual;
+	}
+}
+
+void C4AulScript::OptimizeFn(const size_t iStart)
+{
+	C4AulBCC *const pCode = Code + iStart;
+	const size_t iSize = CodeSize - iStart;
+
+	const auto logger = Config.Developer.DumpBytecode ? Application.LogSystem.CreateLogger(Config.Logging.AulExec) : nullptr;
+	if (logger)
+	{
+		logger->info("{} before optimization:", ScriptName);
+		DumpBytecode(*logger, pCode, iSize);
+	}
+
+	// instructions that can be jumped to must stay the first one of any fused sequence
+	std::vector<bool> fTarget(iSize + 1, false);
+	fTarget[0] = true;
+	for (size_t i = 0; i < iSize; ++i)
+	{
+		if (IsJumpType(pCode[i].bccType))
+			fTarget[i + pCode[i].bccX] = true;
+		else if (pCode[i].bccType == AB_FOREACH_NEXT || pCode[i].bccType == AB_FOREACH_MAP_NEXT)
+			// jumps over the next instruction implicitly
+			fTarget[i + 1] = fTarget[i + 2] = true;
+	}
+
+	// constant folding, which removes instructions
+	std::vector<size_t> iNewPos(iSize + 1), iOrigin;
+	std::vector<bool> fNewTarget;
+	iOrigin.reserve(iSize);
+	fNewTarget.reserve(iSize + 1);
+	size_t iNewSize = 0;
+	for (size_t i = 0; i < iSize; ++i)
+	{
+		iNewPos[i] = iNewSize;
+		const C4AulBCC &bcc = pCode[i];
+		if (!fTarget[i] && iNewSize >= 1 && bcc.bccType == AB_Neg && pCode[iNewSize - 1].bccType == AB_INT && pCode[iNewSize - 1].bccX != std::numeric_limits<C4ValueInt>::min())
+		{
+			pCode[iNewSize - 1].bccX = -pCode[iNewSize - 1].bccX;
+			continue;
+		}
+		if (!fTarget[i] && iNewSize >= 2 && !fNewTarget[iNewSize - 1] && pCode[iNewSize - 2].bccType == AB_INT && pCode[iNewSize - 1].bccType == AB_INT)
+		{
+			if (const auto iResult = FoldConstant(bcc.bccType, pCode[iNewSize - 2].bccX, pCode[iNewSize - 1].bccX); iResult)
+			{
+				pCode[iNewSize - 2].bccX = *iResult;
+				iOrigin.pop_back();
+				fNewTarget.pop_back();
+				--iNewSize;
+				continue;
+			}
+		}
+		pCode[iNewSize++] = bcc;
+		iOrigin.push_back(i);
+		fNewTarget.push_back(fTarget[i]);
+	}
+	iNewPos[iSize] = iNewSize;
+	fNewTarget.push_back(fTarget[iSize]);
+
+	// translate jump distances; jumps themselves are never removed
+	if (iNewSize != iSize)
+	{
+		for (size_t i = 0; i < iNewSize; ++i)
+			if (IsJumpType(pCode[i].bccType))
+				pCode[i].bccX = static_cast<std::intptr_t>(iNewPos[iOrigin[i] + pCode[i].bccX]) - static_cast<std::intptr_t>(i);
+		CodeSize = static_cast<int>(iStart + iNewSize);
+		CPos = Code + CodeSize;
+	}
+
+	// superinstructions
+	for (size_t i = 0; i < iNewSize; ++i)
+	{
+		C4AulBCC *const pBCC = pCode + i;
+		const auto fFusable = [&](const size_t iCount) { return i + iCount <= iNewSize && std::find(fNewTarget.begin() + i + 1, fNewTarget.begin() + i + iCount, true) == fNewTarget.begin() + i + iCount; };
+		switch (pBCC->bccType)
+		{
+		case AB_VARN_V: case AB_PARN_V:
+			// compare and branch
+			if (fFusable(4) && (pBCC[1].bccType == AB_INT || pBCC[1].bccType == AB_VARN_V || pBCC[1].bccType == AB_PARN_V)
+				&& IsRelationalOperator(pBCC[2].bccType) && pBCC[3].bccType == AB_CONDN)
+			{
+				pBCC->bccType = pBCC->bccType == AB_VARN_V ? AB_VARN_CMP_CONDN : AB_PARN_CMP_CONDN;
+				i += 3;
+			}
+			break;
+
+		case AB_VARN_R:
+		{
+			// increment with discarded result
+			if (i + 1 >= iNewSize) break;
+			const size_t iOp = pBCC[1].bccType == AB_INT ? 2 : 1;
+			if (!fFusable(iOp + 2)) break;
+			const C4AulBCCType eOp = pBCC[iOp].bccType;
+			if ((iOp == 1 ? (eOp == AB_Inc1 || eOp == AB_Inc1_Postfix || eOp == AB_Dec1 || eOp == AB_Dec1_Postfix) : (eOp == AB_Inc || eOp == AB_Dec))
+				&& pBCC[iOp + 1].bccType == AB_STACK && pBCC[iOp + 1].bccX < 0)
+			{
+				pBCC->bccType = AB_VARN_INC;
+				i += iOp + 1;
+			}
+			break;
+		}
+
+		default:
+			break;
+		}
+	}
+
+	if (logger)
+	{
+		logger->info("{} after optimization ({} -> {} instructions):", ScriptName, iSize, iNewSize);
+		DumpBytecode(*logger, pCode, iNewSize);
+	}
+}
+
 void C4AulParseState::Parse_Script()
 {
 	bool fDone = false;
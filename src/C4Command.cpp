@@ -183,6 +183,7 @@ void C4Command::Default()
 	Next = nullptr;
 	iExec = 0;
 	BaseMode = C4CMD_Mode_SilentSub;
+	PathSearch.reset();
 }
 
 static bool ObjectAddWaypoint(int32_t iX, int32_t iY, intptr_t iTransferTarget, intptr_t ipObject)
@@ -235,12 +236,27 @@ void C4Command::MoveTo()
 					// Path not free: find path
 					if (!PathFree(cx, cy, Tx._getInt(), Ty))
 					{
-						Game.PathFinder.EnableTransferZones(!cObj->Def->NoTransferZones);
-						Game.PathFinder.SetLevel(cObj->Def->Pathfinder);
-						if (!Game.PathFinder.Find(cObj->x, cObj->y,
-							Tx._getInt(), Ty,
-							&ObjectAddWaypoint,
-							reinterpret_cast<intptr_t>(cObj))) // intptr for 64bit?
+						// Target changed: drop the unfinished search
+						if (PathSearch && !PathSearch->IsSearchingFor(Tx._getInt(), Ty)) PathSearch.reset();
+						const int32_t iMaxSteps = Game.C4S.Game.PathfinderSteps;
+						C4PathFinder::Result result;
+						if (PathSearch)
+						{
+							result = PathSearch->Resume(iMaxSteps);
+						}
+						else
+						{
+							Game.PathFinder.EnableTransferZones(!cObj->Def->NoTransferZones);
+							Game.PathFinder.SetLevel(cObj->Def->Pathfinder);
+							result = Game.PathFinder.Start(cObj->x, cObj->y,
+								Tx._getInt(), Ty,
+								&ObjectAddWaypoint,
+								reinterpret_cast<intptr_t>(cObj), iMaxSteps); // intptr for 64bit?
+							// Budget used up: continue next frame
+							if (result == C4PathFinder::Result::Pending) PathSearch = Game.PathFinder.Suspend();
+						}
+						if (result != C4PathFinder::Result::Pending) PathSearch.reset();
+						if (result == C4PathFinder::Result::Failed)
 						{
 							/* Path not found: react? */ PathChecked = true; /* recheck delay */
 						}
@@ -248,7 +264,10 @@ void C4Command::MoveTo()
 					}
 					// Path free: recheck delay
 					else
+					{
+						PathSearch.reset();
 						PathChecked = true;
+					}
 				}
 	// Path recheck
 	if (!Tick35) PathChecked = false;
@@ -1093,7 +1112,7 @@ bool C4Command::GetTryEnter()
 	// No minimum con knowledge vehicles/items: fail
 	if (Target->Contained && CheckMinimumCon(Target)) { /* fail??! */ return false; }
 	// Target contained and container has RejectContents: fail
-	if (Target->Contained && Target->Contained->Call(PSF_RejectContents)) { Finish(); return false; }
+	if (Target->Contained && Target->Contained->Call(PSC_RejectContents)) { Finish(); return false; }
 	// Collection limit: drop other object
 	// return after drop, so multiple objects may be dropped
 	if (cObj->Def->CollectionLimit && (cObj->Contents.ObjectCount() >= cObj->Def->CollectionLimit))
@@ -1688,6 +1707,12 @@ void C4Command::Clear()
 	UpdateInterval = 0;
 	Text.clear();
 	BaseMode = C4CMD_Mode_SilentSub;
+	PathSearch.reset();
+}
+
+void C4Command::ClearPathSearch()
+{
+	PathSearch.reset();
 }
 
 void C4Command::Construct()
@@ -22,6 +22,7 @@
 #include "C4ResStrTable.h"
 #include "C4Value.h"
 
+#include <memory>
 #include <string>
 
 const int32_t C4CMD_None      =  0,
@@ -74,6 +75,8 @@ const char *CommandName(int32_t iCommand);
 C4ResStrTableKey CommandNameID(int32_t iCommand);
 int32_t CommandByName(const char *szCommand);
 
+class C4PathFinder;
+
 class C4Command
 {
 public:
@@ -94,12 +97,14 @@ public:
 	C4Command *Next;
 	int32_t iExec; // 0 = not executing, 1 = executing, 2 = executing, command should delete himself on finish
 	int32_t BaseMode; // 0: subcommand/unmarked base (if failing, base will fail, too); 1: base command; 2: silent base command
+	std::unique_ptr<C4PathFinder> PathSearch; // NoSave - path search continued in later frames
 
 public:
 	void Set(int32_t iCommand, C4Object *pObj, C4Object *pTarget, C4Value iTx, int32_t iTy, C4Object *pTarget2, int32_t iData, int32_t iUpdateInterval, bool fEvaluated, int32_t iRetries, const char *szText, int32_t iBaseMode);
 	void Clear();
 	void Execute();
 	void ClearPointers(C4Object *pObj);
+	void ClearPathSearch();
 	void Default();
 	void EnumeratePointers();
 	void DenumeratePointers();
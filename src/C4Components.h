@@ -62,6 +62,8 @@
 #define C4CFN_MassMover        "MassMover.c4b"
 #define C4CFN_CtrlRec          "CtrlRec.c4b"
 #define C4CFN_CtrlRecText      "CtrlRec.txt"
+#define C4CFN_RecKeyframe      "Keyframe{:08}.c4s"
+#define C4CFN_RecKeyframes     "Keyframe*.c4s"
 #define C4CFN_TexMap           "TexMap.txt"
 #define C4CFN_MatMap           "MatMap.txt"
 #define C4CFN_Title            "Title{}.txt|Title.txt"
@@ -86,6 +88,7 @@
 #define C4CFN_PortraitOverlay  "PortraitOverlay.png"
 #define C4CFN_Portrait_Old     "Portrait.bmp"
 #define C4CFN_Portraits        "Portrait*.*"
+#define C4CFN_PortraitPNGs     "Portrait*.png"
 #define C4CFN_MoreMusic        "MoreMusic.txt"
 #define C4CFN_DynLandscape     "Landscape.txt"
 #define C4CFN_ClonkNames       "ClonkNames{}.txt|ClonkNames.txt"
@@ -112,6 +115,7 @@
 
 #define C4CFN_Log    "Clonk.log"
 #define C4CFN_LogEx  "Clonk{}.log" // created if regular logfile is in use
+#define C4CFN_ScriptProfile "ScriptProfile.folded" // call stacks of the bytecode profiler
 #define C4CFN_Names  "Names.txt"
 #define C4CFN_Titles "Title*.txt|Title.txt"
 
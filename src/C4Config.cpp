@@ -88,6 +88,7 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 #endif
 	pComp->Value(mkNamingAdapt(FPS,                     "FPS",                     false,         false, true));
 	pComp->Value(mkNamingAdapt(Record,                  "Record",                  false,         false, true));
+	pComp->Value(mkNamingAdapt(RecordKeyframeInterval,  "RecordKeyframeInterval",  0));
 	pComp->Value(mkNamingAdapt(ScreenshotFolder,        "ScreenshotFolder",        "Screenshots", false, true));
 	pComp->Value(mkNamingAdapt(FairCrew,                "NoCrew",                  false,         false, true));
 	pComp->Value(mkNamingAdapt(FairCrewStrength,        "DefCrewStrength",         1000,          false, true));
@@ -141,6 +142,9 @@ void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
 	pComp->Value(mkNamingAdapt(ConsoleScriptStrictness, "ConsoleScriptStrictness", ConsoleScriptStrictnessWrapper{ConsoleScriptStrictnessWrapper::MaxStrictSentinel}));
+	pComp->Value(mkNamingAdapt(OptimizeBytecode, "OptimizeBytecode", true));
+	pComp->Value(mkNamingAdapt(DumpBytecode, "DumpBytecode", false));
+	pComp->Value(mkNamingAdapt(ThreadedDispatch, "ThreadedDispatch", true));
 }
 
 void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
@@ -67,6 +67,7 @@ public:
 	char MissionAccess[CFG_MaxString + 1];
 	bool FPS;
 	bool Record;
+	int32_t RecordKeyframeInterval; // frames between savegame keyframes in records of games hosted by this client, which allow seeking in replays; 0 for none
 	bool FairCrew;   // don't use permanent crew physicals
 	int32_t FairCrewStrength; // strength of clonks in fair crew mode
 	int32_t MouseAScroll; // auto scroll strength
@@ -116,6 +117,9 @@ public:
 public:
 	bool AutoFileReload;
 	ConsoleScriptStrictnessWrapper ConsoleScriptStrictness;
+	bool OptimizeBytecode; // fold constants and fuse common instruction sequences after parsing
+	bool DumpBytecode; // log script bytecode before and after optimization
+	bool ThreadedDispatch; // use computed goto dispatch in the script interpreter if it was compiled in (USE_THREADED_DISPATCH)
 
 	void CompileFunc(StdCompiler *pComp);
 };
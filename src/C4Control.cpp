@@ -454,6 +454,70 @@ void C4ControlSyncCheck::Set()
 	ObjectCount = Game.Objects.ObjectCount();
 	ObjectEnumerationIndex = Game.ObjectEnumerationIndex;
 	SectShapeSum = Game.Objects.Sectors.getShapeSum();
+	PXSHash = Game.PXS.GetSyncHash();
+	MassMoverHash = Game.MassMover.GetSyncHash();
+	SetObjectHashes();
+	SetLandscapeHashes();
+}
+
+void C4ControlSyncCheck::SetObjectHashes()
+{
+	ObjectHash = 0;
+	std::fill_n(ObjectRegionHashes, C4SyncCheckRegions, 0);
+	const int32_t enumerationIndex = std::max<int32_t>(ObjectEnumerationIndex, 1);
+	for (C4ObjectLink *clnk = Game.Objects.First; clnk; clnk = clnk->Next)
+	{
+		C4Object &obj = *clnk->Obj;
+		const uint32_t hash = C4SyncHashOf(obj.Number, obj.id, obj.Status, obj.GetCon(),
+			obj.fix_x.val, obj.fix_y.val, obj.fix_r.val, obj.xdir.val, obj.ydir.val,
+			obj.Action.Act, obj.Action.Dir, obj.Action.Phase);
+		ObjectHash += hash;
+		ObjectRegionHashes[C4SyncCheckRegionOf(obj.Number, enumerationIndex)] += hash;
+	}
+}
+
+void C4ControlSyncCheck::SetLandscapeHashes()
+{
+	// the landscape keeps its tile hashes up to date; only the strips need to be summed up here
+	LandscapeHash = Game.Landscape.GetSyncHash();
+	const std::vector<uint32_t> &tileHashes = Game.Landscape.GetSyncTileHashes();
+	const int32_t tileCols = Game.Landscape.GetSyncTileCols();
+	const auto tileRows = static_cast<int32_t>(tileCols ? tileHashes.size() / tileCols : 0);
+	for (int32_t region = 0; region < C4SyncCheckRegions; ++region)
+	{
+		LandscapeRegionHashes[region] = 0;
+		for (int32_t i = C4SyncCheckRegionBegin(tileRows, region) * tileCols; i < C4SyncCheckRegionBegin(tileRows, region + 1) * tileCols; ++i)
+			LandscapeRegionHashes[region] += tileHashes[i];
+	}
+}
+
+void C4ControlSyncCheck::LogSyncDifferences(const C4ControlSyncCheck &other) const
+{
+	LogFatalNTr("Network: Hashes Lsc {:08x}/{:08x} Obj {:08x}/{:08x} PXS {:08x}/{:08x} MMs {:08x}/{:08x}", LandscapeHash, other.LandscapeHash, ObjectHash, other.ObjectHash, PXSHash, other.PXSHash, MassMoverHash, other.MassMoverHash);
+
+	const int32_t enumerationIndex = std::max<int32_t>(ObjectEnumerationIndex, 1);
+	for (int32_t region = 0; region < C4SyncCheckRegions; ++region)
+		if (ObjectRegionHashes[region] != other.ObjectRegionHashes[region])
+		{
+			LogFatalNTr("Network: Objects differ in number range {}-{}", C4SyncCheckRegionBegin(enumerationIndex, region), C4SyncCheckRegionBegin(enumerationIndex, region + 1) - 1);
+		}
+
+	// the tiles aren't part of the sync check, so dump the current ones of the local landscape
+	const std::vector<uint32_t> &tileHashes = Game.Landscape.GetSyncTileHashes();
+	const int32_t tileCols = Game.Landscape.GetSyncTileCols();
+	const auto tileRows = static_cast<int32_t>(tileCols ? tileHashes.size() / tileCols : 0);
+	for (int32_t region = 0; region < C4SyncCheckRegions; ++region)
+		if (LandscapeRegionHashes[region] != other.LandscapeRegionHashes[region])
+		{
+			LogFatalNTr("Network: Landscape differs in strip {}", region);
+			for (int32_t row = C4SyncCheckRegionBegin(tileRows, region); row < C4SyncCheckRegionBegin(tileRows, region + 1); ++row)
+			{
+				std::string tiles;
+				for (int32_t col = 0; col < tileCols; ++col)
+					tiles += std::format(" {:08x}", tileHashes[row * tileCols + col]);
+				LogFatalNTr("Network: Local landscape tiles at y={} in frame {}:{}", row * C4LS_SyncHashTileSize, Game.FrameCounter, tiles);
+			}
+		}
 }
 
 int32_t C4ControlSyncCheck::GetAllCrewPosX()
@@ -488,7 +552,11 @@ void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 		|| MassMoverIndex         != pSyncCheck->MassMoverIndex
 		|| ObjectCount            != pSyncCheck->ObjectCount
 		|| ObjectEnumerationIndex != pSyncCheck->ObjectEnumerationIndex
-		|| SectShapeSum           != pSyncCheck->SectShapeSum)
+		|| SectShapeSum           != pSyncCheck->SectShapeSum
+		|| LandscapeHash          != pSyncCheck->LandscapeHash
+		|| ObjectHash             != pSyncCheck->ObjectHash
+		|| PXSHash                != pSyncCheck->PXSHash
+		|| MassMoverHash          != pSyncCheck->MassMoverHash)
 	{
 		const char *szThis = "Client", *szOther = Game.Control.isReplay() ? "Rec " : "Host";
 		if (iByClient != Game.Control.ClientID())
@@ -499,6 +567,7 @@ void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 		LogFatalNTr("Network: Synchronization loss!");
 		LogFatalNTr("Network: {} Frm {} Ctrl {} Rnc {} Rn3 {} Cpx {} PXS {} MMi {} Obc {} Oei {} Sct {}", szThis,            Frame,           ControlTick,           RandomCount,           Random3,           AllCrewPosX,           PXSCount,           MassMoverIndex,           ObjectCount,           ObjectEnumerationIndex,           SectShapeSum);
 		LogFatalNTr("Network: {} Frm {} Ctrl {} Rnc {} Rn3 {} Cpx {} PXS {} MMi {} Obc {} Oei {} Sct {}", szOther, SyncCheck.Frame, SyncCheck.ControlTick, SyncCheck.RandomCount, SyncCheck.Random3, SyncCheck.AllCrewPosX, SyncCheck.PXSCount, SyncCheck.MassMoverIndex, SyncCheck.ObjectCount, SyncCheck.ObjectEnumerationIndex, SyncCheck.SectShapeSum);
+		LogSyncDifferences(SyncCheck);
 		StartSoundEffect("SyncError");
 #ifndef NDEBUG
 		// Debug safe
@@ -530,6 +599,12 @@ void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectCount),            "ObjectCount",             0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(ObjectEnumerationIndex), "ObjectEnumerationIndex",  0));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(SectShapeSum),           "SectShapeSum",            0));
+	pComp->Value(mkNamingAdapt(LandscapeHash,                          "LandscapeHash",           0u));
+	pComp->Value(mkNamingAdapt(ObjectHash,                             "ObjectHash",              0u));
+	pComp->Value(mkNamingAdapt(PXSHash,                                "PXSHash",                 0u));
+	pComp->Value(mkNamingAdapt(MassMoverHash,                          "MassMoverHash",           0u));
+	pComp->Value(mkNamingAdapt(mkArrayAdapt(LandscapeRegionHashes, 0u), "LandscapeRegionHashes"));
+	pComp->Value(mkNamingAdapt(mkArrayAdapt(ObjectRegionHashes, 0u),    "ObjectRegionHashes"));
 	C4ControlPacket::CompileFunc(pComp);
 }
 
@@ -24,9 +24,11 @@
 #include "C4PacketBase.h"
 #include "C4PlayerInfo.h"
 #include "C4Client.h"
+#include "C4SyncHash.h"
 
 #include <format>
 #include <string>
+#include <vector>
 
 class C4Record;
 
@@ -214,6 +216,12 @@ protected:
 	int32_t ObjectCount;
 	int32_t ObjectEnumerationIndex;
 	int32_t SectShapeSum;
+	uint32_t LandscapeHash;
+	uint32_t ObjectHash;
+	uint32_t PXSHash;
+	uint32_t MassMoverHash;
+	uint32_t LandscapeRegionHashes[C4SyncCheckRegions]; // horizontal landscape strips
+	uint32_t ObjectRegionHashes[C4SyncCheckRegions]; // object number ranges
 
 public:
 	void Set();
@@ -223,6 +231,9 @@ public:
 
 protected:
 	static int32_t GetAllCrewPosX();
+	void SetObjectHashes();
+	void SetLandscapeHashes();
+	void LogSyncDifferences(const C4ControlSyncCheck &other) const;
 };
 
 class C4ControlSynchronize : public C4ControlPacket // sync
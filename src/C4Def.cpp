@@ -22,6 +22,8 @@
 #include <C4FileMonitor.h>
 
 #include <C4SurfaceFile.h>
+#include <C4Surface.h>
+#include <C4ThreadPool.h>
 #include <C4Log.h>
 #include <C4Components.h>
 #include <C4Config.h>
@@ -31,6 +33,7 @@
 #include "C4Network2Res.h"
 
 #include <algorithm>
+#include <optional>
 #include <ranges>
 
 // Default Action Procedures
@@ -617,6 +620,19 @@ bool C4Def::Load(C4Group &hGroup,
 		return false;
 	}
 
+	// Decode graphics and portraits on the thread pool; they directly follow the DefCore in packed groups
+	std::optional<C4PNGPreloader> preloader;
+	if ((dwLoadWhat & C4D_Load_Bitmap) && C4ThreadPool::Global)
+	{
+		preloader.emplace(hGroup);
+		char szFilename[_MAX_FNAME + 1] = "";
+		hGroup.ResetSearch();
+		while (hGroup.FindNextEntry("*.png", szFilename, nullptr, nullptr, !!*szFilename))
+			if (WildcardMatch(C4CFN_DefGraphicsExPNG, szFilename) || WildcardMatch(C4CFN_PortraitPNGs, szFilename)
+				|| (ColorByOwner && WildcardMatch(C4CFN_ClrByOwnerExPNG, szFilename)))
+				preloader->Add(szFilename);
+	}
+
 	// Read surface bitmap
 	if (dwLoadWhat & C4D_Load_Bitmap)
 		if (!Graphics.LoadAllGraphics(hGroup, !!ColorByOwner))
@@ -632,6 +648,8 @@ bool C4Def::Load(C4Group &hGroup,
 			DebugLog(spdlog::level::err, "Error loading portrait graphics of {} ({})", hGroup.GetFullName().getData(), C4IdText(id));
 			return false;
 		}
+	// free images that haven't been used, e.g. overlays without graphics
+	preloader.reset();
 
 	// Read ActMap
 	if (dwLoadWhat & C4D_Load_ActMap)
@@ -1028,6 +1046,8 @@ int32_t C4DefList::Load(const char *szSearch,
 		LoadFailure = true;
 		return iResult;
 	}
+	// decompress in the background while definitions are being parsed
+	hGroup.StartReadAhead();
 	iResult += Load(hGroup, dwLoadWhat, szLanguage, pSoundSystem, fOverload, true, iMinProgress, iMaxProgress);
 	hGroup.Close();
 
@@ -62,10 +62,10 @@ void C4DefGraphics::Clear()
 bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const char *szFilenamePNG, const char *szOverlayPNG, bool fColorByOwner)
 {
 	// try png
-	if (szFilenamePNG && hGroup.AccessEntry(szFilenamePNG))
+	if (szFilenamePNG && hGroup.FindEntry(szFilenamePNG))
 	{
 		Bitmap = new C4Surface();
-		if (!Bitmap->ReadPNG(hGroup)) return false;
+		if (!Bitmap->LoadPNG(hGroup, szFilenamePNG)) return false;
 	}
 	else
 	{
@@ -80,9 +80,9 @@ bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const
 		// Create additionmal bitmap
 		BitmapClr = new C4Surface();
 		// if overlay-surface is present, load from that
-		if (szOverlayPNG && hGroup.AccessEntry(szOverlayPNG))
+		if (szOverlayPNG && hGroup.FindEntry(szOverlayPNG))
 		{
-			if (!BitmapClr->ReadPNG(hGroup))
+			if (!BitmapClr->LoadPNG(hGroup, szOverlayPNG))
 				return false;
 			// set as Clr-surface, also checking size
 			if (!BitmapClr->SetAsClrByOwnerOf(Bitmap))
@@ -820,7 +820,7 @@ int32_t FnFxFireStop(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_t
 
 C4String *FnFxFireInfo(C4AulContext *ctx, C4Object *pObj, int32_t iNumber)
 {
-	return new C4String(LoadResStr(C4ResStrTableKey::IDS_OBJ_BURNS), &Game.ScriptEngine.Strings);
+	return Game.ScriptEngine.Strings.RegString(LoadResStr(C4ResStrTableKey::IDS_OBJ_BURNS));
 }
 
 // Some other, internal effects
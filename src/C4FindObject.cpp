@@ -34,6 +34,21 @@ C4FindObject::~C4FindObject()
 }
 
 C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject **ppSortObj)
+{
+	C4SortObject *pSortObj = nullptr;
+	C4FindObject *pFO = CompileByValue(DataVal, ppSortObj ? &pSortObj : nullptr);
+	// Read parameters
+	if (pFO)
+		BindByValue(pFO, DataVal);
+	if (pSortObj)
+	{
+		C4SortObject::BindByValue(pSortObj, DataVal);
+		*ppSortObj = pSortObj;
+	}
+	return pFO;
+}
+
+C4FindObject *C4FindObject::CompileByValue(const C4Value &DataVal, C4SortObject **ppSortObj)
 {
 	// Must be an array
 	C4ValueArray *pArray = C4Value(DataVal).getArray();
@@ -47,7 +62,7 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 		// sort condition not desired here?
 		if (!ppSortObj) return nullptr;
 		// otherwise, create it!
-		*ppSortObj = C4SortObject::CreateByValue(iType, Data);
+		*ppSortObj = C4SortObject::CompileByValue(iType, Data);
 		// done
 		return nullptr;
 	}
@@ -57,7 +72,7 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 	case C4FO_Not:
 	{
 		// Create child condition
-		C4FindObject *pCond = C4FindObject::CreateByValue(Data[1]);
+		C4FindObject *pCond = C4FindObject::CompileByValue(Data[1]);
 		if (!pCond) return nullptr;
 		// wrap
 		return new C4FindObjectNot(pCond);
@@ -67,99 +82,93 @@ C4FindObject *C4FindObject::CreateByValue(const C4Value &DataVal, C4SortObject *
 	{
 		// Trivial case (one condition)
 		if (Data.GetSize() == 2)
-			return C4FindObject::CreateByValue(Data[1]);
+			return C4FindObject::CompileByValue(Data[1]);
 		// Create all childs
-		C4FindObject **ppConds = new C4FindObject *[Data.GetSize() - 1];
-		for (int32_t i = 0; i < Data.GetSize() - 1; i++)
-			ppConds[i] = C4FindObject::CreateByValue(Data[i + 1]);
-		// Count real entries, move them to start of list
-		int32_t iSize = 0;
+		std::vector<C4FindObject *> conds;
+		conds.reserve(Data.GetSize() - 1);
 		for (int32_t i = 0; i < Data.GetSize() - 1; i++)
-			if (ppConds[i])
-				if (iSize++ != i)
-					ppConds[iSize - 1] = ppConds[i];
+			conds.push_back(C4FindObject::CompileByValue(Data[i + 1]));
 		// Create
 		if (iType == C4FO_And)
-			return new C4FindObjectAnd(iSize, ppConds);
+			return new C4FindObjectAnd(std::move(conds));
 		else
-			return new C4FindObjectOr(iSize, ppConds);
+			return new C4FindObjectOr(std::move(conds));
 	}
 
 	case C4FO_Exclude:
-		return new C4FindObjectExclude(Data[1].getObj());
+		return new C4FindObjectExclude();
 
 	case C4FO_ID:
-		return new C4FindObjectID(Data[1].getC4ID());
+		return new C4FindObjectID();
 
 	case C4FO_InRect:
-		return new C4FindObjectInRect(C4Rect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt()));
+		return new C4FindObjectInRect();
 
 	case C4FO_AtPoint:
-		return new C4FindObjectAtPoint(Data[1].getInt(), Data[2].getInt());
+		return new C4FindObjectAtPoint();
 
 	case C4FO_AtRect:
-		return new C4FindObjectAtRect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+		return new C4FindObjectAtRect();
 
 	case C4FO_OnLine:
-		return new C4FindObjectOnLine(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+		return new C4FindObjectOnLine();
 
 	case C4FO_Distance:
-		return new C4FindObjectDistance(Data[1].getInt(), Data[2].getInt(), Data[3].getInt());
+		return new C4FindObjectDistance();
 
 	case C4FO_OCF:
-		return new C4FindObjectOCF(Data[1].getInt());
+		return new C4FindObjectOCF();
 
 	case C4FO_Category:
-		return new C4FindObjectCategory(Data[1].getInt());
+		return new C4FindObjectCategory();
 
 	case C4FO_Action:
-	{
-		C4String *pStr = Data[1].getStr();
-		if (!pStr) return nullptr;
-		// Don't copy, it should be safe
-		return new C4FindObjectAction(pStr->Data.getData());
-	}
+		// Action must be given as string
+		if (!Data[1].getStr()) return nullptr;
+		return new C4FindObjectAction();
 
 	case C4FO_Func:
-	{
-		// Get function name
-		C4String *pStr = Data[1].getStr();
-		if (!pStr) return nullptr;
-		// Construct
-		C4FindObjectFunc *pFO = new C4FindObjectFunc(pStr->Data.getData());
-		// Add parameters
-		for (int i = 2; i < Data.GetSize(); i++)
-			pFO->SetPar(i - 2, Data[i]);
-		// Done
-		return pFO;
-	}
+		// Function name must be given as string
+		if (!Data[1].getStr()) return nullptr;
+		return new C4FindObjectFunc();
 
 	case C4FO_ActionTarget:
-	{
-		int32_t index = 0;
-		if (Data.GetSize() >= 3)
-			index = static_cast<decltype(index)>(BoundBy<C4ValueInt>(Data[2].getInt(), 0, 1));
-		return new C4FindObjectActionTarget(Data[1].getObj(), index);
-	}
+		return new C4FindObjectActionTarget();
 
 	case C4FO_Container:
-		return new C4FindObjectContainer(Data[1].getObj());
+		return new C4FindObjectContainer();
 
 	case C4FO_AnyContainer:
 		return new C4FindObjectAnyContainer();
 
 	case C4FO_Owner:
-		return new C4FindObjectOwner(Data[1].getInt());
+		return new C4FindObjectOwner();
 
 	case C4FO_Controller:
-		return new C4FindObjectController(Data[1].getInt());
+		return new C4FindObjectController();
 
 	case C4FO_Layer:
-		return new C4FindObjectLayer(Data[1].getObj());
+		return new C4FindObjectLayer();
 	}
 	return nullptr;
 }
 
+void C4FindObject::BindByValue(C4FindObject *pFO, const C4Value &DataVal)
+{
+	// No condition compiled for this value?
+	if (!pFO) return;
+	C4ValueArray *pArray = C4Value(DataVal).getArray();
+	assert(pArray);
+	if (!pArray) return;
+
+	const C4ValueArray &Data = *pArray;
+	const auto iType = Data[0].getInt();
+	// Combinators of a single condition have been replaced by the condition
+	if ((iType == C4FO_And || iType == C4FO_Or) && Data.GetSize() == 2)
+		return BindByValue(pFO, Data[1]);
+	pFO->Bind(Data);
+}
+
 int32_t C4FindObject::Count(const C4ObjectList &Objs)
 {
 	// Trivial cases
@@ -246,15 +255,23 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 		// Create marker, count over all areas
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
 		int32_t iCount = 0;
+		std::vector<C4Object *> objects;
 		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
-			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
-				if (pLnk->Obj->Status)
-					if (pLnk->Obj->Marker != iMarker)
+		{
+			// iterate over a copy: Check might call script, which may change the sector lists
+			const std::vector<C4Object *> &flat = pSct->ObjectShapes.GetFlat();
+			objects.assign(flat.begin(), flat.end());
+			for (C4Object *const pObj : objects)
+			{
+				if (pObj->Status)
+					if (pObj->Marker != iMarker)
 					{
-						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+						pObj->Marker = iMarker;
+						if (Check(pObj))
 							iCount++;
 					}
+			}
+		}
 		return iCount;
 	}
 	else
@@ -348,29 +365,49 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 		// Set up array
 		// Create marker, search all areas
 		uint32_t iMarker = ::Game.Objects.GetNextMarker();
+		std::vector<C4Object *> objects;
 		for (; pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
-			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
-				if (pLnk->Obj->Status)
-					if (pLnk->Obj->Marker != iMarker)
+		{
+			// iterate over a copy: Check might call script, which may change the sector lists
+			const std::vector<C4Object *> &flat = pSct->ObjectShapes.GetFlat();
+			objects.assign(flat.begin(), flat.end());
+			for (C4Object *const pObj : objects)
+			{
+				if (pObj->Status)
+					if (pObj->Marker != iMarker)
 					{
-						pLnk->Obj->Marker = iMarker;
-						if (Check(pLnk->Obj))
+						pObj->Marker = iMarker;
+						if (Check(pObj))
 						{
-							result.push_back(pLnk->Obj);
+							result.push_back(pObj);
 						}
 					}
+			}
+		}
 	}
 	else
 	{
 		// Search
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
+		// objects moved to another sector by script may be encountered again, so mark them as well
+		uint32_t iMarker = ::Game.Objects.GetNextMarker();
+		std::vector<C4Object *> objects;
 		for (C4ObjectList *pLst = Area.FirstObjects(&pSct); pLst; pLst = Area.NextObjects(pLst, &pSct))
-			for (C4ObjectLink *pLnk = pLst->First; pLnk; pLnk = pLnk->Next)
-				if (pLnk->Obj->Status)
-					if (Check(pLnk->Obj))
+		{
+			// iterate over a copy: Check might call script, which may change the sector lists
+			const std::vector<C4Object *> &flat = pSct->Objects.GetFlat();
+			objects.assign(flat.begin(), flat.end());
+			for (C4Object *const pObj : objects)
+				if (pObj->Status)
+					if (pObj->Marker != iMarker)
 					{
-						result.push_back(pLnk->Obj);
+						pObj->Marker = iMarker;
+						if (Check(pObj))
+						{
+							result.push_back(pObj);
+						}
 					}
+		}
 	}
 	// Recheck object status (may shrink array again)
 	CheckObjectStatus(result);
@@ -413,29 +450,72 @@ bool C4FindObjectNot::Check(C4Object *pObj)
 
 // *** C4FindObjectAnd
 
-C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFreeArray)
-	: iCnt(inCnt), ppConds(ppConds), fFreeArray(fFreeArray), fUseShapes(false), fHasBounds(false)
+C4FindObjectAnd::C4FindObjectAnd(std::vector<C4FindObject *> conds)
+	: Conds(std::move(conds)), fUseShapes(false), fHasBounds(false), iCheckCost(C4FO_CostField)
 {
-	// Filter ensured entries
-	for (int32_t i = 0; i < iCnt;)
-		if (ppConds[i]->IsEnsured())
+	for (C4FindObject *pCond : Conds)
+		if (pCond)
 		{
-			delete ppConds[i];
-			iCnt--;
-			for (int32_t j = i; j < iCnt; j++)
-				ppConds[j] = ppConds[j + 1];
+			CheckConds.push_back(pCond);
+			iCheckCost = std::max(iCheckCost, pCond->GetCheckCost());
 		}
-		else
-			i++;
+	// Check cheap conditions first. Conditions calling script stay in place,
+	// so they are still called for exactly the same objects.
+	const auto callsScript = [](C4FindObject *const pCond) { return pCond->GetCheckCost() >= C4FO_CostScript; };
+	for (auto it = CheckConds.begin(); it != CheckConds.end(); )
+	{
+		const auto runEnd = std::find_if(it, CheckConds.end(), callsScript);
+		std::stable_sort(it, runEnd, [](C4FindObject *const pCond1, C4FindObject *const pCond2) { return pCond1->GetCheckCost() < pCond2->GetCheckCost(); });
+		it = (runEnd != CheckConds.end() ? runEnd + 1 : runEnd);
+	}
+	ActiveConds.reserve(CheckConds.size());
+}
+
+C4FindObjectAnd::~C4FindObjectAnd()
+{
+	for (C4FindObject *pCond : Conds)
+		delete pCond;
+}
+
+void C4FindObjectAnd::Bind(const C4ValueArray &Data)
+{
+	for (std::size_t i = 0; i < Conds.size(); i++)
+		BindByValue(Conds[i], Data[static_cast<int32_t>(i) + 1]);
+	Update();
+}
+
+void C4FindObjectAnd::BindPars(const C4Value *pPars)
+{
+	for (std::size_t i = 0; i < Conds.size(); i++)
+		BindByValue(Conds[i], pPars[i].GetRefVal());
+	Update();
+}
+
+void C4FindObjectAnd::Unbind()
+{
+	for (C4FindObject *pCond : CheckConds)
+		pCond->Unbind();
+}
+
+void C4FindObjectAnd::Update()
+{
+	// Filter ensured entries
+	ActiveConds.clear();
+	for (C4FindObject *pCond : CheckConds)
+		if (!pCond->IsEnsured())
+			ActiveConds.push_back(pCond);
 	// Intersect all child bounds
-	for (int32_t i = 0; i < iCnt; i++)
+	// Use the original order, as the bounds decide which object is found first
+	fUseShapes = fHasBounds = false;
+	for (C4FindObject *pCond : Conds)
 	{
-		C4Rect *pChildBounds = ppConds[i]->GetBounds();
+		if (!pCond || pCond->IsEnsured()) continue;
+		C4Rect *pChildBounds = pCond->GetBounds();
 		if (pChildBounds)
 		{
 			// some objects might be in an rect and at a point not in that rect
 			// so do not intersect an atpoint bound with an rect bound
-			fUseShapes = ppConds[i]->UseShapes();
+			fUseShapes = pCond->UseShapes();
 			if (fUseShapes)
 			{
 				Bounds = *pChildBounds;
@@ -453,55 +533,58 @@ C4FindObjectAnd::C4FindObjectAnd(int32_t inCnt, C4FindObject **ppConds, bool fFr
 	}
 }
 
-C4FindObjectAnd::~C4FindObjectAnd()
-{
-	for (int32_t i = 0; i < iCnt; i++)
-		delete ppConds[i];
-	if (fFreeArray)
-		delete[] ppConds;
-}
-
 bool C4FindObjectAnd::Check(C4Object *pObj)
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		if (!ppConds[i]->Check(pObj))
+	for (C4FindObject *pCond : ActiveConds)
+		if (!pCond->Check(pObj))
 			return false;
 	return true;
 }
 
 bool C4FindObjectAnd::IsImpossible()
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		if (ppConds[i]->IsImpossible())
+	for (C4FindObject *pCond : ActiveConds)
+		if (pCond->IsImpossible())
 			return true;
 	return false;
 }
 
 // *** C4FindObjectOr
 
-C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
-	: iCnt(inCnt), ppConds(ppConds), fHasBounds(false)
+C4FindObjectOr::C4FindObjectOr(std::vector<C4FindObject *> conds)
+	: Conds(std::move(conds)), fHasBounds(false), iCheckCost(C4FO_CostField)
+{
+	for (C4FindObject *pCond : Conds)
+		if (pCond)
+			iCheckCost = std::max(iCheckCost, pCond->GetCheckCost());
+	ActiveConds.reserve(Conds.size());
+}
+
+C4FindObjectOr::~C4FindObjectOr()
+{
+	for (C4FindObject *pCond : Conds)
+		delete pCond;
+}
+
+void C4FindObjectOr::Bind(const C4ValueArray &Data)
 {
+	for (std::size_t i = 0; i < Conds.size(); i++)
+		BindByValue(Conds[i], Data[static_cast<int32_t>(i) + 1]);
 	// Filter impossible entries
-	for (int32_t i = 0; i < iCnt;)
-		if (ppConds[i]->IsImpossible())
-		{
-			delete ppConds[i];
-			iCnt--;
-			for (int32_t j = i; j < iCnt; j++)
-				ppConds[j] = ppConds[j + 1];
-		}
-		else
-			i++;
+	ActiveConds.clear();
+	for (C4FindObject *pCond : Conds)
+		if (pCond && !pCond->IsImpossible())
+			ActiveConds.push_back(pCond);
 	// Sum up all child bounds
-	for (int32_t i = 0; i < iCnt; i++)
+	fHasBounds = false;
+	for (C4FindObject *pCond : ActiveConds)
 	{
-		C4Rect *pChildBounds = ppConds[i]->GetBounds();
+		C4Rect *pChildBounds = pCond->GetBounds();
 		if (!pChildBounds) { fHasBounds = false; break; }
 		// Do not optimize atpoint: It could lead to having to search multiple
 		// sectors. An object's shape can be in multiple sectors. We do not want
 		// to find the same object twice.
-		if (ppConds[i]->UseShapes())
+		if (pCond->UseShapes())
 		{
 			fHasBounds = false; break;
 		}
@@ -515,25 +598,25 @@ C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
 	}
 }
 
-C4FindObjectOr::~C4FindObjectOr()
+void C4FindObjectOr::Unbind()
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		delete ppConds[i];
-	delete[] ppConds;
+	for (C4FindObject *pCond : Conds)
+		if (pCond)
+			pCond->Unbind();
 }
 
 bool C4FindObjectOr::Check(C4Object *pObj)
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		if (ppConds[i]->Check(pObj))
+	for (C4FindObject *pCond : ActiveConds)
+		if (pCond->Check(pObj))
 			return true;
 	return false;
 }
 
 bool C4FindObjectOr::IsEnsured()
 {
-	for (int32_t i = 0; i < iCnt; i++)
-		if (ppConds[i]->IsEnsured())
+	for (C4FindObject *pCond : ActiveConds)
+		if (pCond->IsEnsured())
 			return true;
 	return false;
 }
@@ -556,6 +639,11 @@ bool C4FindObjectID::IsImpossible()
 	return !pDef || !pDef->Count;
 }
 
+void C4FindObjectInRect::Bind(const C4ValueArray &Data)
+{
+	rect = C4Rect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+}
+
 bool C4FindObjectInRect::Check(C4Object *pObj)
 {
 	return rect.Contains(pObj->x, pObj->y);
@@ -566,11 +654,21 @@ bool C4FindObjectInRect::IsImpossible()
 	return !rect.Wdt || !rect.Hgt;
 }
 
+void C4FindObjectAtPoint::Bind(const C4ValueArray &Data)
+{
+	bounds = C4Rect(Data[1].getInt(), Data[2].getInt(), 1, 1);
+}
+
 bool C4FindObjectAtPoint::Check(C4Object *pObj)
 {
 	return pObj->Shape.Contains(bounds.x - pObj->x, bounds.y - pObj->y);
 }
 
+void C4FindObjectAtRect::Bind(const C4ValueArray &Data)
+{
+	bounds = C4Rect(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+}
+
 bool C4FindObjectAtRect::Check(C4Object *pObj)
 {
 	C4Rect rcShapeBounds = pObj->Shape;
@@ -578,11 +676,31 @@ bool C4FindObjectAtRect::Check(C4Object *pObj)
 	return !!rcShapeBounds.Overlap(bounds);
 }
 
+void C4FindObjectOnLine::Bind(const C4ValueArray &Data)
+{
+	Set(Data[1].getInt(), Data[2].getInt(), Data[3].getInt(), Data[4].getInt());
+}
+
+void C4FindObjectOnLine::Set(int32_t x, int32_t y, int32_t x2, int32_t y2)
+{
+	this->x = x; this->y = y; this->x2 = x2; this->y2 = y2;
+	bounds = C4Rect(x, y, 1, 1);
+	bounds.Add(C4Rect(x2, y2, 1, 1));
+}
+
 bool C4FindObjectOnLine::Check(C4Object *pObj)
 {
 	return pObj->Shape.IntersectsLine(x - pObj->x, y - pObj->y, x2 - pObj->x, y2 - pObj->y);
 }
 
+void C4FindObjectDistance::Bind(const C4ValueArray &Data)
+{
+	x = Data[1].getInt(); y = Data[2].getInt();
+	const int32_t r = Data[3].getInt();
+	r2 = r * r;
+	bounds = C4Rect(x - r, y - r, 2 * r + 1, 2 * r + 1);
+}
+
 bool C4FindObjectDistance::Check(C4Object *pObj)
 {
 	return (pObj->x - x) * (pObj->x - x) + (pObj->y - y) * (pObj->y - y) <= r2;
@@ -608,11 +726,26 @@ bool C4FindObjectCategory::IsEnsured()
 	return !iCategory;
 }
 
+void C4FindObjectAction::Bind(const C4ValueArray &Data)
+{
+	// Don't copy, it should be safe
+	C4String *pStr = Data[1].getStr();
+	szAction = pStr ? pStr->Data.getData() : "";
+}
+
 bool C4FindObjectAction::Check(C4Object *pObj)
 {
 	return SEqual(pObj->Action.Name, szAction);
 }
 
+void C4FindObjectActionTarget::Bind(const C4ValueArray &Data)
+{
+	pActionTarget = Data[1].getObj();
+	index = 0;
+	if (Data.GetSize() >= 3)
+		index = static_cast<decltype(index)>(BoundBy<C4ValueInt>(Data[2].getInt(), 0, 1));
+}
+
 bool C4FindObjectActionTarget::Check(C4Object *pObj)
 {
 	assert(index >= 0 && index <= 1);
@@ -658,7 +791,24 @@ bool C4FindObjectController::IsImpossible()
 
 C4FindObjectFunc::C4FindObjectFunc(const char *szFunc)
 {
-	pFunc = Game.ScriptEngine.GetFirstFunc(szFunc);
+	pFunc = szFunc ? Game.ScriptEngine.GetFirstFunc(szFunc) : nullptr;
+}
+
+void C4FindObjectFunc::Bind(const C4ValueArray &Data)
+{
+	// Look up the function again, scripts might have been reloaded
+	C4String *pStr = Data[1].getStr();
+	pFunc = pStr ? Game.ScriptEngine.GetFirstFunc(pStr->Data.getData()) : nullptr;
+	// Add parameters
+	for (int i = 2; i < Data.GetSize(); i++)
+		SetPar(i - 2, Data[i]);
+}
+
+void C4FindObjectFunc::Unbind()
+{
+	pFunc = nullptr;
+	for (C4Value &par : Pars.Par)
+		par.Set0();
 }
 
 void C4FindObjectFunc::SetPar(int i, const C4Value &Par)
@@ -700,22 +850,44 @@ bool C4FindObjectLayer::IsImpossible()
 // *** C4SortObject
 
 C4SortObject *C4SortObject::CreateByValue(const C4Value &DataVal)
+{
+	C4SortObject *pSO = CompileByValue(DataVal);
+	BindByValue(pSO, DataVal);
+	return pSO;
+}
+
+C4SortObject *C4SortObject::CompileByValue(const C4Value &DataVal)
 {
 	// Must be an array
 	const C4ValueArray *pArray = C4Value(DataVal).getArray();
 	if (!pArray) return nullptr;
 	const C4ValueArray &Data = *pArray;
-	return CreateByValue(Data[0].getInt(), Data);
+	return CompileByValue(Data[0].getInt(), Data);
 }
 
-C4SortObject *C4SortObject::CreateByValue(C4ValueInt iType, const C4ValueArray &Data)
+void C4SortObject::BindByValue(C4SortObject *pSO, const C4Value &DataVal)
+{
+	// No sort compiled for this value?
+	if (!pSO) return;
+	const C4ValueArray *pArray = C4Value(DataVal).getArray();
+	assert(pArray);
+	if (!pArray) return;
+
+	const C4ValueArray &Data = *pArray;
+	// Multiple sorts of a single sort have been replaced by the sort
+	if (Data[0].getInt() == C4SO_Multiple && Data.GetSize() == 2)
+		return BindByValue(pSO, Data[1]);
+	pSO->Bind(Data);
+}
+
+C4SortObject *C4SortObject::CompileByValue(C4ValueInt iType, const C4ValueArray &Data)
 {
 	switch (iType)
 	{
 	case C4SO_Reverse:
 	{
 		// create child sort
-		C4SortObject *pChildSort = C4SortObject::CreateByValue(Data[1]);
+		C4SortObject *pChildSort = C4SortObject::CompileByValue(Data[1]);
 		if (!pChildSort) return nullptr;
 		// wrap
 		return new C4SortObjectReverse(pChildSort);
@@ -726,26 +898,21 @@ C4SortObject *C4SortObject::CreateByValue(C4ValueInt iType, const C4ValueArray &
 		// Trivial case (one sort)
 		if (Data.GetSize() == 2)
 		{
-			return C4SortObject::CreateByValue(Data[1]);
+			return C4SortObject::CompileByValue(Data[1]);
 		}
 		// Create all children
-		C4SortObject **ppSorts = new C4SortObject *[Data.GetSize() - 1];
+		std::vector<C4SortObject *> sorts;
+		sorts.reserve(Data.GetSize() - 1);
 		for (int32_t i = 0; i < Data.GetSize() - 1; i++)
 		{
-			ppSorts[i] = C4SortObject::CreateByValue(Data[i + 1]);
+			sorts.push_back(C4SortObject::CompileByValue(Data[i + 1]));
 		}
-		// Count real entries, move them to start of list
-		int32_t iSize = 0;
-		for (int32_t i = 0; i < Data.GetSize() - 1; i++)
-			if (ppSorts[i])
-				if (iSize++ != i)
-					ppSorts[iSize - 1] = ppSorts[i];
 		// Create
-		return new C4SortObjectMultiple(iSize, ppSorts);
+		return new C4SortObjectMultiple(std::move(sorts));
 	}
 
 	case C4SO_Distance:
-		return new C4SortObjectDistance(Data[1].getInt(), Data[2].getInt());
+		return new C4SortObjectDistance();
 
 	case C4SO_Random:
 		return new C4SortObjectRandom();
@@ -760,18 +927,9 @@ C4SortObject *C4SortObject::CreateByValue(C4ValueInt iType, const C4ValueArray &
 		return new C4SortObjectValue();
 
 	case C4SO_Func:
-	{
-		// Get function name
-		C4String *pStr = Data[1].getStr();
-		if (!pStr) return nullptr;
-		// Construct
-		C4SortObjectFunc *pSO = new C4SortObjectFunc(pStr->Data.getData());
-		// Add parameters
-		for (int i = 2; i < Data.GetSize(); i++)
-			pSO->SetPar(i - 2, Data[i]);
-		// Done
-		return pSO;
-	}
+		// Function name must be given as string
+		if (!Data[1].getStr()) return nullptr;
+		return new C4SortObjectFunc();
 	}
 	return nullptr;
 }
@@ -889,16 +1047,33 @@ int32_t C4SortObjectReverse::CompareCache(int32_t iObj1, int32_t iObj2, C4Object
 
 C4SortObjectMultiple::~C4SortObjectMultiple()
 {
-	for (int32_t i = 0; i < iCnt; ++i) delete ppSorts[i];
-	if (fFreeArray) delete[] ppSorts;
+	for (C4SortObject *pSort : Sorts) delete pSort;
+}
+
+void C4SortObjectMultiple::Bind(const C4ValueArray &Data)
+{
+	for (std::size_t i = 0; i < Sorts.size(); ++i)
+		BindByValue(Sorts[i], Data[static_cast<int32_t>(i) + 1]);
+}
+
+void C4SortObjectMultiple::BindPars(const C4Value *pPars)
+{
+	for (std::size_t i = 0; i < Sorts.size(); ++i)
+		BindByValue(Sorts[i], pPars[i].GetRefVal());
+}
+
+void C4SortObjectMultiple::Unbind()
+{
+	for (C4SortObject *pSort : Sorts)
+		if (pSort) pSort->Unbind();
 }
 
 int32_t C4SortObjectMultiple::Compare(C4Object *pObj1, C4Object *pObj2)
 {
 	// return first comparison that's nonzero
 	int32_t iCmp;
-	for (int32_t i = 0; i < iCnt; ++i)
-		if ((iCmp = ppSorts[i]->Compare(pObj1, pObj2)))
+	for (C4SortObject *pSort : Sorts)
+		if (pSort && (iCmp = pSort->Compare(pObj1, pObj2)))
 			return iCmp;
 	// all comparisons equal
 	return 0;
@@ -907,8 +1082,8 @@ int32_t C4SortObjectMultiple::Compare(C4Object *pObj1, C4Object *pObj2)
 bool C4SortObjectMultiple::PrepareCache(std::vector<C4Object *> &objects)
 {
 	bool fCaches = false;
-	for (int32_t i = 0; i < iCnt; ++i)
-		fCaches |= ppSorts[i]->PrepareCache(objects);
+	for (C4SortObject *pSort : Sorts)
+		if (pSort) fCaches |= pSort->PrepareCache(objects);
 	// return wether a sort citerion uses a cache
 	return fCaches;
 }
@@ -917,8 +1092,8 @@ int32_t C4SortObjectMultiple::CompareCache(int32_t iObj1, int32_t iObj2, C4Objec
 {
 	// return first comparison that's nonzero
 	int32_t iCmp;
-	for (int32_t i = 0; i < iCnt; ++i)
-		if ((iCmp = ppSorts[i]->CompareCache(iObj1, iObj2, pObj1, pObj2)))
+	for (C4SortObject *pSort : Sorts)
+		if (pSort && (iCmp = pSort->CompareCache(iObj1, iObj2, pObj1, pObj2)))
 			return iCmp;
 	// all comparisons equal
 	return 0;
@@ -952,7 +1127,24 @@ int32_t C4SortObjectValue::CompareGetValue(C4Object *pFor)
 
 C4SortObjectFunc::C4SortObjectFunc(const char *szFunc)
 {
-	pFunc = Game.ScriptEngine.GetFirstFunc(szFunc);
+	pFunc = szFunc ? Game.ScriptEngine.GetFirstFunc(szFunc) : nullptr;
+}
+
+void C4SortObjectFunc::Bind(const C4ValueArray &Data)
+{
+	// Look up the function again, scripts might have been reloaded
+	C4String *pStr = Data[1].getStr();
+	pFunc = pStr ? Game.ScriptEngine.GetFirstFunc(pStr->Data.getData()) : nullptr;
+	// Add parameters
+	for (int i = 2; i < Data.GetSize(); i++)
+		SetPar(i - 2, Data[i]);
+}
+
+void C4SortObjectFunc::Unbind()
+{
+	pFunc = nullptr;
+	for (C4Value &par : Pars.Par)
+		par.Set0();
 }
 
 void C4SortObjectFunc::SetPar(int i, const C4Value &Par)
@@ -973,3 +1165,183 @@ int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
 	// Call
 	return pCallFunc->Exec(pObj, Pars, true).getInt();
 }
+
+// *** C4FindObjectCache
+
+namespace
+{
+	void AddKeyValue(std::string &key, const C4ValueInt value)
+	{
+		key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+}
+
+C4FindObjectCache::Binding::Binding(Criteria *pCriteria, std::unique_ptr<Criteria> pOwned)
+	: pCriteria(pCriteria), pOwned(std::move(pOwned)) {}
+
+C4FindObjectCache::Binding::~Binding()
+{
+	// Don't keep script values alive until the next call
+	if (pCriteria->pFind) pCriteria->pFind->Unbind();
+	if (pCriteria->pSort) pCriteria->pSort->Unbind();
+	pCriteria->fInUse = false;
+}
+
+C4FindObjectCache::Binding C4FindObjectCache::Bind(const C4Value *pPars, bool fAllowSort)
+{
+	// Build structure key, reading the parameters like Compile does
+	Key.clear();
+	Key += (fAllowSort ? 's' : 'c');
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		const C4Value &Data = pPars[i].GetRefVal();
+		if (!Data) break;
+		AddKey(Key, Data, fAllowSort);
+	}
+	// Look up compiled criteria
+	auto it = Entries.find(Key);
+	if (it == Entries.end() && Entries.size() < MaxEntries)
+		it = Entries.emplace(Key, Compile(pPars, fAllowSort)).first;
+	// Cache full or criteria already in use by an outer search (Find_Func calling FindObjects)?
+	if (it == Entries.end() || it->second->fInUse)
+	{
+		std::unique_ptr<Criteria> pCriteria = Compile(pPars, fAllowSort);
+		BindCriteria(*pCriteria, pPars);
+		Criteria *pBound = pCriteria.get();
+		return Binding{pBound, std::move(pCriteria)};
+	}
+	Criteria &criteria = *it->second;
+	criteria.fInUse = true;
+	BindCriteria(criteria, pPars);
+	return Binding{&criteria};
+}
+
+std::unique_ptr<C4FindObjectCache::Criteria> C4FindObjectCache::Compile(const C4Value *pPars, bool fAllowSort)
+{
+	auto criteria = std::make_unique<Criteria>();
+	std::vector<C4FindObject *> conds;
+	std::vector<C4SortObject *> sorts;
+	int32_t iCnt = 0; bool fHasSort = false;
+	// Read all parameters
+	for (int32_t i = 0; i < C4AUL_MAX_Par; i++)
+	{
+		const C4Value &Data = pPars[i].GetRefVal();
+		// No data given?
+		if (!Data) break;
+		// Construct
+		C4SortObject *pSO = nullptr;
+		C4FindObject *pFO = C4FindObject::CompileByValue(Data, fAllowSort ? &pSO : nullptr);
+		if (pFO)
+		{
+			criteria->iFindPar = i;
+			iCnt++;
+		}
+		conds.push_back(pFO);
+		sorts.push_back(pSO);
+		fHasSort |= (pSO != nullptr);
+	}
+	// No criterions?
+	if (!iCnt)
+	{
+		for (C4SortObject *pSO : sorts) delete pSO;
+		return criteria;
+	}
+	// Create search object
+	if (iCnt == 1)
+		criteria->pFind.reset(conds[criteria->iFindPar]);
+	else
+		criteria->pFind.reset(criteria->pAnd = new C4FindObjectAnd(std::move(conds)));
+	// create sort criterion
+	if (fHasSort)
+	{
+		criteria->pSort = new C4SortObjectMultiple(std::move(sorts));
+		criteria->pFind->SetSort(criteria->pSort);
+	}
+	return criteria;
+}
+
+void C4FindObjectCache::BindCriteria(Criteria &criteria, const C4Value *pPars)
+{
+	if (criteria.pAnd)
+		criteria.pAnd->BindPars(pPars);
+	else if (criteria.pFind)
+		C4FindObject::BindByValue(criteria.pFind.get(), pPars[criteria.iFindPar].GetRefVal());
+	if (criteria.pSort)
+		criteria.pSort->BindPars(pPars);
+}
+
+void C4FindObjectCache::AddKey(std::string &key, const C4Value &DataVal, bool fAllowSort)
+{
+	// Everything C4FindObject::CompileByValue decides on goes into the key
+	C4ValueArray *pArray = C4Value(DataVal).getArray();
+	if (!pArray)
+	{
+		key += 'n';
+		return;
+	}
+
+	const C4ValueArray &Data = *pArray;
+	const auto iType = Data[0].getInt();
+	key += 'a';
+	AddKeyValue(key, iType);
+	if (Inside<decltype(iType)>(iType, C4SO_First, C4SO_Last))
+	{
+		if (fAllowSort)
+			AddSortKey(key, iType, Data);
+		return;
+	}
+
+	switch (iType)
+	{
+	case C4FO_Not:
+		AddKey(key, Data[1], false);
+		break;
+
+	case C4FO_And: case C4FO_Or:
+		AddKeyValue(key, Data.GetSize());
+		for (int32_t i = 1; i < Data.GetSize(); i++)
+			AddKey(key, Data[i], false);
+		break;
+
+	case C4FO_Action: case C4FO_Func:
+		key += (Data[1].getStr() ? 's' : 'n');
+		break;
+	}
+}
+
+void C4FindObjectCache::AddSortKey(std::string &key, const C4Value &DataVal)
+{
+	const C4ValueArray *pArray = C4Value(DataVal).getArray();
+	if (!pArray)
+	{
+		key += 'n';
+		return;
+	}
+
+	const C4ValueArray &Data = *pArray;
+	const auto iType = Data[0].getInt();
+	key += 'a';
+	AddKeyValue(key, iType);
+	AddSortKey(key, iType, Data);
+}
+
+void C4FindObjectCache::AddSortKey(std::string &key, C4ValueInt iType, const C4ValueArray &Data)
+{
+	// Everything C4SortObject::CompileByValue decides on goes into the key
+	switch (iType)
+	{
+	case C4SO_Reverse:
+		AddSortKey(key, Data[1]);
+		break;
+
+	case C4SO_Multiple:
+		AddKeyValue(key, Data.GetSize());
+		for (int32_t i = 1; i < Data.GetSize(); i++)
+			AddSortKey(key, Data[i]);
+		break;
+
+	case C4SO_Func:
+		key += (Data[1].getStr() ? 's' : 'n');
+		break;
+	}
+}
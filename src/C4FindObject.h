@@ -22,6 +22,11 @@
 #include "C4Value.h"
 #include "C4Aul.h"
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -62,6 +67,16 @@ enum C4SortObjectCondID
 	C4SO_Last = 200, // no sort condition larger than this
 };
 
+// Rough cost of a condition check; cheaper checks of an And are done first
+enum C4FindObjectCheckCost
+{
+	C4FO_CostField = 1, // compares an object property
+	C4FO_CostPosition = 2, // compares the object position or rarely rejects
+	C4FO_CostShape = 3, // intersects the object shape
+	C4FO_CostString = 4, // compares strings
+	C4FO_CostScript = 100, // calls script - never reordered with other checks
+};
+
 // Base class
 class C4FindObject
 {
@@ -76,6 +91,11 @@ public:
 	virtual ~C4FindObject();
 
 	static C4FindObject *CreateByValue(const C4Value &Data, C4SortObject **ppSortObj = nullptr); // createFindObject or SortObject - if ppSortObj==nullptr, SortObject is not allowed
+	static C4FindObject *CompileByValue(const C4Value &Data, C4SortObject **ppSortObj = nullptr); // like CreateByValue, but does not read any parameters; bind before use
+	static void BindByValue(C4FindObject *pFO, const C4Value &Data); // (re)reads the parameters of a compiled condition from a value of the same structure
+
+	virtual void Bind(const C4ValueArray &Data) {} // reads the parameters from the condition array
+	virtual void Unbind() {} // releases script values held since the last Bind
 
 	int32_t Count(const C4ObjectList &Objs); // Counts objects for which the condition is true
 	C4Object *Find(const C4ObjectList &Objs);   // Returns first object for which the condition is true
@@ -94,6 +114,7 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual int32_t GetCheckCost() { return C4FO_CostField; }
 
 private:
 	void CheckObjectStatus(std::vector<C4Object *> &objects);
@@ -108,6 +129,9 @@ public:
 		: pCond(pCond) {}
 	virtual ~C4FindObjectNot();
 
+	virtual void Bind(const C4ValueArray &Data) override { BindByValue(pCond, Data[1]); }
+	virtual void Unbind() override { pCond->Unbind(); }
+
 private:
 	C4FindObject *pCond;
 
@@ -115,65 +139,86 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override { return pCond->IsEnsured(); }
 	virtual bool IsEnsured() override { return pCond->IsImpossible(); }
+	virtual int32_t GetCheckCost() override { return pCond->GetCheckCost(); }
 };
 
 class C4FindObjectAnd : public C4FindObject
 {
 public:
-	C4FindObjectAnd(int32_t iCnt, C4FindObject **ppConds, bool fFreeArray = true);
+	C4FindObjectAnd(std::vector<C4FindObject *> conds); // conds[i] is read from parameter i; nullptr entries are ignored
 	virtual ~C4FindObjectAnd();
 
+	virtual void Bind(const C4ValueArray &Data) override;
+	virtual void Unbind() override;
+	void BindPars(const C4Value *pPars); // binds the conditions to script function parameters instead of array entries
+
 private:
-	int32_t iCnt;
-	C4FindObject **ppConds; bool fFreeArray; bool fUseShapes;
+	std::vector<C4FindObject *> Conds; // by parameter
+	std::vector<C4FindObject *> CheckConds; // in check order: cheap conditions first, but never moved across script calls
+	std::vector<C4FindObject *> ActiveConds; // CheckConds without ensured conditions
+	bool fUseShapes;
 	C4Rect Bounds; bool fHasBounds;
+	int32_t iCheckCost;
+
+	void Update();
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool UseShapes() override { return fUseShapes; }
-	virtual bool IsEnsured() override { return !iCnt; }
+	virtual bool IsEnsured() override { return ActiveConds.empty(); }
 	virtual bool IsImpossible() override;
+	virtual int32_t GetCheckCost() override { return iCheckCost; }
 };
 
 class C4FindObjectOr : public C4FindObject
 {
 public:
-	C4FindObjectOr(int32_t iCnt, C4FindObject **ppConds);
+	C4FindObjectOr(std::vector<C4FindObject *> conds); // conds[i] is read from parameter i; nullptr entries are ignored
 	virtual ~C4FindObjectOr();
 
+	virtual void Bind(const C4ValueArray &Data) override;
+	virtual void Unbind() override;
+
 private:
-	int32_t iCnt;
-	C4FindObject **ppConds;
+	std::vector<C4FindObject *> Conds; // by parameter
+	std::vector<C4FindObject *> ActiveConds; // Conds without impossible conditions
 	C4Rect Bounds; bool fHasBounds;
+	int32_t iCheckCost;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured() override;
-	virtual bool IsImpossible() override { return !iCnt; }
+	virtual bool IsImpossible() override { return ActiveConds.empty(); }
+	virtual int32_t GetCheckCost() override { return iCheckCost; }
 };
 
 // Primitive conditions
 class C4FindObjectExclude : public C4FindObject
 {
 public:
-	C4FindObjectExclude(C4Object *pExclude)
+	C4FindObjectExclude(C4Object *pExclude = nullptr)
 		: pExclude(pExclude) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { pExclude = Data[1].getObj(); }
+
 private:
 	C4Object *pExclude;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCheckCost() override { return C4FO_CostPosition; }
 };
 
 class C4FindObjectID : public C4FindObject
 {
 public:
-	C4FindObjectID(C4ID id)
+	C4FindObjectID(C4ID id = C4ID_None)
 		: id(id) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { id = Data[1].getC4ID(); }
+
 private:
 	C4ID id;
 
@@ -185,9 +230,11 @@ protected:
 class C4FindObjectInRect : public C4FindObject
 {
 public:
-	C4FindObjectInRect(const C4Rect &rect)
+	C4FindObjectInRect(const C4Rect &rect = C4Rect(0, 0, 0, 0))
 		: rect(rect) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	C4Rect rect;
 
@@ -195,14 +242,17 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &rect; }
 	virtual bool IsImpossible() override;
+	virtual int32_t GetCheckCost() override { return C4FO_CostPosition; }
 };
 
 class C4FindObjectAtPoint : public C4FindObject
 {
 public:
-	C4FindObjectAtPoint(int32_t x, int32_t y)
+	C4FindObjectAtPoint(int32_t x = 0, int32_t y = 0)
 		: bounds(x, y, 1, 1) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	C4Rect bounds;
 
@@ -210,14 +260,17 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual int32_t GetCheckCost() override { return C4FO_CostShape; }
 };
 
 class C4FindObjectAtRect : public C4FindObject
 {
 public:
-	C4FindObjectAtRect(int32_t x, int32_t y, int32_t wdt, int32_t hgt)
+	C4FindObjectAtRect(int32_t x = 0, int32_t y = 0, int32_t wdt = 0, int32_t hgt = 0)
 		: bounds(x, y, wdt, hgt) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	C4Rect bounds;
 
@@ -225,33 +278,40 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual int32_t GetCheckCost() override { return C4FO_CostShape; }
 };
 
 class C4FindObjectOnLine : public C4FindObject
 {
 public:
-	C4FindObjectOnLine(int32_t x, int32_t y, int32_t x2, int32_t y2)
-		: x(x), y(y), x2(x2), y2(y2), bounds(x, y, 1, 1)
+	C4FindObjectOnLine(int32_t x = 0, int32_t y = 0, int32_t x2 = 0, int32_t y2 = 0)
 	{
-		bounds.Add(C4Rect(x2, y2, 1, 1));
+		Set(x, y, x2, y2);
 	}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	int32_t x, y, x2, y2;
 	C4Rect bounds;
 
+	void Set(int32_t x, int32_t y, int32_t x2, int32_t y2);
+
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
 	virtual bool UseShapes() override { return true; }
+	virtual int32_t GetCheckCost() override { return C4FO_CostShape; }
 };
 
 class C4FindObjectDistance : public C4FindObject
 {
 public:
-	C4FindObjectDistance(int32_t x, int32_t y, int32_t r)
+	C4FindObjectDistance(int32_t x = 0, int32_t y = 0, int32_t r = 0)
 		: x(x), y(y), r2(r * r), bounds(x - r, y - r, 2 * r + 1, 2 * r + 1) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	int32_t x, y, r2;
 	C4Rect bounds;
@@ -259,14 +319,17 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual C4Rect *GetBounds() override { return &bounds; }
+	virtual int32_t GetCheckCost() override { return C4FO_CostPosition; }
 };
 
 class C4FindObjectOCF : public C4FindObject
 {
 public:
-	C4FindObjectOCF(int32_t ocf)
+	C4FindObjectOCF(int32_t ocf = 0)
 		: ocf(ocf) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { ocf = Data[1].getInt(); }
+
 private:
 	int32_t ocf;
 
@@ -278,9 +341,11 @@ protected:
 class C4FindObjectCategory : public C4FindObject
 {
 public:
-	C4FindObjectCategory(int32_t iCategory)
+	C4FindObjectCategory(int32_t iCategory = 0)
 		: iCategory(iCategory) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { iCategory = Data[1].getInt(); }
+
 private:
 	int32_t iCategory;
 
@@ -292,22 +357,27 @@ protected:
 class C4FindObjectAction : public C4FindObject
 {
 public:
-	C4FindObjectAction(const char *szAction)
+	C4FindObjectAction(const char *szAction = "")
 		: szAction(szAction) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	const char *szAction;
 
 protected:
 	virtual bool Check(C4Object *pObj) override;
+	virtual int32_t GetCheckCost() override { return C4FO_CostString; }
 };
 
 class C4FindObjectActionTarget : public C4FindObject
 {
 public:
-	C4FindObjectActionTarget(C4Object *pActionTarget, int index)
+	C4FindObjectActionTarget(C4Object *pActionTarget = nullptr, int index = 0)
 		: pActionTarget(pActionTarget), index(index) {}
 
+	virtual void Bind(const C4ValueArray &Data) override;
+
 private:
 	C4Object *pActionTarget;
 	int index;
@@ -319,9 +389,11 @@ protected:
 class C4FindObjectContainer : public C4FindObject
 {
 public:
-	C4FindObjectContainer(C4Object *pContainer)
+	C4FindObjectContainer(C4Object *pContainer = nullptr)
 		: pContainer(pContainer) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { pContainer = Data[1].getObj(); }
+
 private:
 	C4Object *pContainer;
 
@@ -341,9 +413,11 @@ protected:
 class C4FindObjectOwner : public C4FindObject
 {
 public:
-	C4FindObjectOwner(int32_t iOwner)
+	C4FindObjectOwner(int32_t iOwner = NO_OWNER)
 		: iOwner(iOwner) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { iOwner = Data[1].getInt(); }
+
 private:
 	int32_t iOwner;
 
@@ -355,9 +429,12 @@ protected:
 class C4FindObjectFunc : public C4FindObject
 {
 public:
-	C4FindObjectFunc(const char *szFunc);
+	C4FindObjectFunc(const char *szFunc = nullptr);
 	void SetPar(int i, const C4Value &val);
 
+	virtual void Bind(const C4ValueArray &Data) override;
+	virtual void Unbind() override;
+
 private:
 	C4AulFunc *pFunc;
 	C4AulParSet Pars;
@@ -365,12 +442,15 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual int32_t GetCheckCost() override { return C4FO_CostScript; }
 };
 
 class C4FindObjectLayer : public C4FindObject
 {
 public:
-	C4FindObjectLayer(C4Object *pLayer) : pLayer(pLayer) {}
+	C4FindObjectLayer(C4Object *pLayer = nullptr) : pLayer(pLayer) {}
+
+	virtual void Bind(const C4ValueArray &Data) override { pLayer = Data[1].getObj(); }
 
 private:
 	C4Object *pLayer;
@@ -383,9 +463,11 @@ protected:
 class C4FindObjectController : public C4FindObject
 {
 public:
-	C4FindObjectController(int32_t controller)
+	C4FindObjectController(int32_t controller = NO_OWNER)
 		: controller(controller) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { controller = Data[1].getInt(); }
+
 private:
 	int32_t controller;
 
@@ -408,9 +490,14 @@ public:
 	virtual bool PrepareCache([[maybe_unused]] std::vector<C4Object *> &objects) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
 
+	virtual void Bind(const C4ValueArray &Data) {} // reads the parameters from the sort array
+	virtual void Unbind() {} // releases script values held since the last Bind
+
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data);
-	static C4SortObject *CreateByValue(C4ValueInt iType, const C4ValueArray &Data);
+	static C4SortObject *CompileByValue(const C4Value &Data); // like CreateByValue, but does not read any parameters; bind before use
+	static C4SortObject *CompileByValue(C4ValueInt iType, const C4ValueArray &Data);
+	static void BindByValue(C4SortObject *pSO, const C4Value &Data); // (re)reads the parameters of a compiled sort from a value of the same structure
 
 	void SortObjects(std::vector<C4Object *> &result);
 };
@@ -440,6 +527,9 @@ public:
 		: C4SortObject(), pSort(pSort) {}
 	virtual ~C4SortObjectReverse();
 
+	virtual void Bind(const C4ValueArray &Data) override { BindByValue(pSort, Data[1]); }
+	virtual void Unbind() override { pSort->Unbind(); }
+
 private:
 	C4SortObject *pSort;
 
@@ -453,14 +543,16 @@ protected:
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
 {
 public:
-	C4SortObjectMultiple(int32_t iCnt, C4SortObject **ppSorts, bool fFreeArray = true)
-		: C4SortObject(), fFreeArray(fFreeArray), iCnt(iCnt), ppSorts(ppSorts) {}
+	C4SortObjectMultiple(std::vector<C4SortObject *> sorts) // sorts[i] is read from parameter i; nullptr entries are ignored
+		: C4SortObject(), Sorts(std::move(sorts)) {}
 	virtual ~C4SortObjectMultiple();
 
+	virtual void Bind(const C4ValueArray &Data) override;
+	virtual void Unbind() override;
+	void BindPars(const C4Value *pPars); // binds the sorts to script function parameters instead of array entries
+
 private:
-	bool fFreeArray;
-	int32_t iCnt;
-	C4SortObject **ppSorts;
+	std::vector<C4SortObject *> Sorts; // by parameter
 
 protected:
 	int32_t Compare(C4Object *pObj1, C4Object *pObj2) override;
@@ -472,9 +564,11 @@ protected:
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
 {
 public:
-	C4SortObjectDistance(int iX, int iY)
+	C4SortObjectDistance(int iX = 0, int iY = 0)
 		: C4SortObjectByValue(), iX(iX), iY(iY) {}
 
+	virtual void Bind(const C4ValueArray &Data) override { iX = Data[1].getInt(); iY = Data[2].getInt(); }
+
 private:
 	int iX, iY;
 
@@ -521,9 +615,12 @@ protected:
 class C4SortObjectFunc : public C4SortObjectByValue // sort by script function
 {
 public:
-	C4SortObjectFunc(const char *szFunc);
+	C4SortObjectFunc(const char *szFunc = nullptr);
 	void SetPar(int i, const C4Value &val);
 
+	virtual void Bind(const C4ValueArray &Data) override;
+	virtual void Unbind() override;
+
 private:
 	C4AulFunc *pFunc;
 	C4AulParSet Pars;
@@ -531,3 +628,51 @@ private:
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
 };
+
+// Search criteria of FindObject2, FindObjects and ObjectCount2, compiled once per
+// structure of the criteria arrays and rebound to the parameter values on every call
+class C4FindObjectCache
+{
+private:
+	struct Criteria
+	{
+		std::unique_ptr<C4FindObject> pFind; // nullptr if no valid search criteria were given
+		C4FindObjectAnd *pAnd{nullptr}; // pFind if several criteria were given
+		int32_t iFindPar{0}; // parameter of pFind otherwise
+		C4SortObjectMultiple *pSort{nullptr}; // owned by pFind
+		bool fInUse{false};
+	};
+
+public:
+	// Criteria bound to the parameters of one call; released on destruction
+	class Binding
+	{
+	public:
+		Binding(Criteria *pCriteria, std::unique_ptr<Criteria> pOwned = nullptr);
+		~Binding();
+
+		Binding(const Binding &) = delete;
+		Binding &operator=(const Binding &) = delete;
+
+		C4FindObject *operator->() const { return pCriteria->pFind.get(); }
+		explicit operator bool() const { return pCriteria->pFind != nullptr; }
+
+	private:
+		Criteria *pCriteria;
+		std::unique_ptr<Criteria> pOwned; // set if the criteria were compiled for this call only
+	};
+
+	Binding Bind(const C4Value *pPars, bool fAllowSort);
+
+private:
+	static constexpr std::size_t MaxEntries = 256;
+
+	std::unordered_map<std::string, std::unique_ptr<Criteria>> Entries;
+	std::string Key; // reused to avoid allocations
+
+	static std::unique_ptr<Criteria> Compile(const C4Value *pPars, bool fAllowSort);
+	static void BindCriteria(Criteria &criteria, const C4Value *pPars);
+	static void AddKey(std::string &key, const C4Value &Data, bool fAllowSort);
+	static void AddSortKey(std::string &key, const C4Value &Data);
+	static void AddSortKey(std::string &key, C4ValueInt iType, const C4ValueArray &Data);
+};
@@ -26,6 +26,7 @@ class C4Fixed;
 class C4Game;
 class C4Graph;
 class C4Group;
+class C4Landscape;
 class C4Material;
 class C4MaterialMap;
 class C4Object;
@@ -49,6 +49,7 @@
 #include <C4ChatDlg.h>
 #include "C4KeyboardInput.h"
 #include "C4Thread.h"
+#include "C4ThreadPool.h"
 
 #include <StdFile.h>
 #include <StdGL.h>
@@ -56,8 +57,11 @@
 
 #include <format>
 #include <iterator>
+#include <latch>
 #include <sstream>
+#include <thread>
 #include <utility>
+#include <vector>
 
 constexpr unsigned int defaultIngameGameTickDelay = 28;
 
@@ -1573,6 +1577,9 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 			if ((*it)->RemovalDelay > 0) (*it)->RemovalDelay--;
 	}
 
+	// Particles of all objects
+	ExecObjectParticles();
+
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "ObjCC", 6);
 #endif
@@ -1600,6 +1607,54 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 	if (!Tick255) ObjectRemovalCheck();
 }
 
+void C4Game::ExecObjectParticles()
+{
+	// Particles are not synchronized and executing them only reads the game state besides the particles themselves,
+	// so the lists of different objects can be executed concurrently once all objects have moved
+	std::vector<C4Object *> particleObjects;
+	for (auto it = Objects.BeginLast(); it != std::default_sentinel; ++it)
+		if ((*it)->Status && ((*it)->BackParticles || (*it)->FrontParticles))
+			particleObjects.push_back(*it);
+
+	constexpr std::size_t MinObjectsPerBand{32};
+	std::size_t bandCount{1};
+	if (C4ThreadPool::Global)
+		bandCount = std::min<std::size_t>(std::thread::hardware_concurrency(), particleObjects.size() / MinObjectsPerBand);
+
+	if (bandCount <= 1)
+	{
+		for (C4Object *const obj : particleObjects)
+		{
+			if (obj->BackParticles) obj->BackParticles.Exec(obj);
+			if (obj->FrontParticles) obj->FrontParticles.Exec(obj);
+		}
+		return;
+	}
+
+	// Dead particles are collected per band and returned to the shared free list afterwards
+	std::vector<C4ParticleList> deadParticles(bandCount);
+	std::latch bandsDone{static_cast<std::ptrdiff_t>(bandCount)};
+	for (std::size_t band{0}; band < bandCount; ++band)
+	{
+		const std::size_t begin{particleObjects.size() * band / bandCount};
+		const std::size_t end{particleObjects.size() * (band + 1) / bandCount};
+		C4ThreadPool::Global->SubmitCallback([&particleObjects, &deadParticles, &bandsDone, band, begin, end]
+		{
+			for (std::size_t i{begin}; i < end; ++i)
+			{
+				C4Object *const obj{particleObjects[i]};
+				if (obj->BackParticles) obj->BackParticles.Exec(obj, deadParticles[band]);
+				if (obj->FrontParticles) obj->FrontParticles.Exec(obj, deadParticles[band]);
+			}
+			bandsDone.count_down();
+		});
+	}
+	bandsDone.wait();
+
+	for (auto &dead : deadParticles)
+		dead.Clear();
+}
+
 bool C4Game::CreateViewport(int32_t iPlayer, bool fSilent)
 {
 	return GraphicsSystem.CreateViewport(iPlayer, fSilent);
@@ -1758,6 +1813,9 @@ void C4Game::Default()
 	FPS = cFPS = 0;
 	fScriptCreatedObjects = false;
 	fLobby = fObserve = false;
+	FastReplay = false;
+	SeekFrame = 0;
+	SeekRestart.clear();
 	iLobbyTimeout = 0;
 	iTick2 = iTick3 = iTick5 = iTick10 = iTick35 = iTick255 = iTick500 = iTick1000 = 0;
 	ObjectEnumerationIndex = 0;
@@ -3174,6 +3232,9 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// record stream
 		if (SEqual2NoCase(szParameter, "/stream:"))
 			RecordStream.Copy(szParameter + 8);
+		// replay benchmark
+		if (SEqualNoCase(szParameter, "/fastreplay"))
+			FastReplay = true;
 		// startup start screen
 		if (SEqual2NoCase(szParameter, "/startup:"))
 			C4Startup::SetStartScreen(szParameter + 9);
@@ -3279,6 +3340,10 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 #endif
 	}
 
+	// fast replay runs offline
+	if (FastReplay)
+		NetworkActive = false;
+
 	// Check for fullscreen switch in command line
 	if (SSearchNoCase(szCmdLine, "/console"))
 		Application.isFullScreen = false;
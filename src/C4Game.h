@@ -56,6 +56,8 @@
 #include <C4NetworkRestartInfos.h>
 #include "C4FileMonitor.h"
 
+#include <string>
+
 class C4Game
 {
 private:
@@ -153,6 +155,9 @@ public:
 	int32_t iLobbyTimeout;
 	bool fObserve;
 	bool NetworkActive;
+	bool FastReplay; // replay the record as fast as possible without drawing and sound, then quit
+	int32_t SeekFrame; // replay frame to fast forward to without drawing (set by C4Playback::Seek); 0 if not seeking
+	std::string SeekRestart; // record or keyframe the replay is restarted from before fast forwarding to SeekFrame; empty if none
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
 	bool TempScenarioFile;
@@ -290,6 +295,7 @@ protected:
 	void CloseScenario();
 	void DeleteObjects(bool fDeleteInactive);
 	void ExecObjects();
+	void ExecObjectParticles();
 	void Ticks();
 	std::vector<std::string> FoldersWithLocalsDefs(std::string path);
 	bool CheckObjectEnumeration();
@@ -126,6 +126,12 @@ void C4GameControl::ChangeToLocal()
 
 void C4GameControl::OnGameSynchronizing()
 {
+	// save keyframe into running record
+	if (pRecord && Game.Parameters.RecordKeyframeInterval > 0)
+		if (!pRecord->SaveKeyframe())
+			logger->error("Could not save record keyframe at frame {}", Game.FrameCounter);
+	fKeyframeRequested = false;
+	iLastKeyframe = Game.FrameCounter;
 	// start record if desired
 	if (fRecordNeeded)
 	{
@@ -203,6 +209,12 @@ bool C4GameControl::RecAddFile(const char *szLocalFilename, const char *szAddAs)
 	return pRecord->AddFile(szLocalFilename, szAddAs);
 }
 
+bool C4GameControl::SeekReplay(int32_t iFrame)
+{
+	if (!isReplay() || !pPlayback) return false;
+	return pPlayback->Seek(iFrame);
+}
+
 void C4GameControl::Clear()
 {
 	StopRecord();
@@ -225,6 +237,8 @@ void C4GameControl::Default()
 	SyncRate = C4SyncCheckRate;
 	DoSync = false;
 	fRecordNeeded = false;
+	fKeyframeRequested = false;
+	iLastKeyframe = 0;
 	pExecutingControl = nullptr;
 }
 
@@ -305,6 +319,14 @@ void C4GameControl::Execute()
 	if (pRecord)
 		pRecord->Rec(Control, Game.FrameCounter);
 
+	// request periodic keyframe by session parameters; every recording client saves it when the synchronization is executed
+	if (fHost && !fKeyframeRequested && Game.Parameters.RecordKeyframeInterval > 0
+		&& Game.FrameCounter >= iLastKeyframe + Game.Parameters.RecordKeyframeInterval)
+	{
+		fKeyframeRequested = true;
+		DoInput(CID_Synchronize, new C4ControlSynchronize(false, false), CDT_Queue);
+	}
+
 	// debug: recheck PreExecute
 	assert(Control.PreExecute(logger));
 
@@ -58,6 +58,8 @@ protected:
 	bool fHost; // (set for local, too)
 	bool fActivated;
 	bool fRecordNeeded;
+	bool fKeyframeRequested;
+	int32_t iLastKeyframe; // frame of the last game synchronization, which is a keyframe in records
 	int32_t iClientID;
 
 	C4Record *pRecord;
@@ -108,6 +110,7 @@ public:
 	void RequestRuntimeRecord();
 	bool IsRuntimeRecordPossible() const;
 	bool RecAddFile(const char *szLocalFilename, const char *szAddAs);
+	bool SeekReplay(int32_t iFrame);
 
 	// execution
 	bool Prepare();
@@ -140,7 +143,7 @@ public:
 	// execute and record control (by self or C4GameControlNetwork)
 	void ExecControl(const C4Control &rCtrl);
 	void ExecControlPacket(C4PacketType eCtrlType, class C4ControlPacket *pPkt);
-	void OnGameSynchronizing(); // start record if desired
+	void OnGameSynchronizing(); // start record or save record keyframe if desired
 
 	const std::shared_ptr<spdlog::logger> &GetLogger() const noexcept { return logger; }
 
@@ -127,8 +127,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(PSC_RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(PSC_RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -164,7 +164,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+											if (!obj1->Call(PSC_QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -174,7 +174,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(PSC_CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -233,9 +233,9 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 C4Object *C4GameObjects::AtObject(int ctx, int cty, uint32_t &ocf, C4Object *exclude)
 {
 	uint32_t cocf;
-	C4Object *cObj; C4ObjectLink *clnk;
 
-	for (clnk = ObjectsAt(ctx, cty).First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
+	// At() doesn't call back into script, so the flat sector array can be used
+	for (C4Object *const cObj : Sectors.SectorAt(ctx, cty)->ObjectShapes.GetFlat())
 		if (!exclude || (cObj != exclude && exclude->pLayer == cObj->pLayer)) if (cObj->Status)
 		{
 			cocf = ocf | OCF_Exclusive;
@@ -22,6 +22,7 @@
 #include "C4Gui.h"
 #include "C4Wrappers.h"
 
+#include <algorithm>
 #include <iterator>
 
 // C4GameRes
@@ -438,6 +439,9 @@ bool C4GameParameters::Load(C4Group &hGroup, C4Scenario *pScenario, const char *
 
 		// Auto frame skip by options
 		AutoFrameSkip = ::Config.Graphics.AutoFrameSkip;
+
+		// Record keyframes by host options
+		RecordKeyframeInterval = std::max<int32_t>(::Config.General.RecordKeyframeInterval, 0);
 	}
 
 	// enforce league settings
@@ -561,6 +565,7 @@ void C4GameParameters::CompileFunc(StdCompiler *pComp, C4Scenario *pScenario)
 	pComp->Value(mkNamingAdapt(IsNetworkGame,      "IsNetworkGame",      false));
 	pComp->Value(mkNamingAdapt(ControlRate,        "ControlRate",        -1));
 	pComp->Value(mkNamingAdapt(AutoFrameSkip,      "AutoFrameSkip",      false));
+	pComp->Value(mkNamingAdapt(RecordKeyframeInterval, "RecordKeyframeInterval", 0));
 	pComp->Value(mkNamingAdapt(Rules,              "Rules",              !pScenario ? C4IDList() : pScenario->Game.Rules));
 	pComp->Value(mkNamingAdapt(Goals,              "Goals",              !pScenario ? C4IDList() : pScenario->Game.Goals));
 	pComp->Value(mkNamingAdapt(League,             "League",             StdStrBuf()));
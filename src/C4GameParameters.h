@@ -148,6 +148,9 @@ public:
 	// Automatic frame skip enabled for this game?
 	bool AutoFrameSkip;
 
+	// Frames between record keyframes, for which the host synchronizes the game; 0 for none
+	int32_t RecordKeyframeInterval;
+
 	// Allow debug mode?
 	bool AllowDebug;
 
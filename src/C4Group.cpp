@@ -26,6 +26,7 @@
 
 #ifdef C4ENGINE
 #include "C4Log.h"
+#include "C4Thread.h"
 #endif
 
 #ifdef _WIN32
@@ -42,8 +43,13 @@
 #include <StdSha1.h>
 #include <fcntl.h>
 
+#include <condition_variable>
 #include <cstring>
+#include <map>
+#include <mutex>
 #include <print>
+#include <thread>
+#include <vector>
 
 // File Sort Lists
 
@@ -602,6 +608,210 @@ void C4GroupEntry::Set(const DirectoryIterator &iter, const char *path)
 
 #endif
 
+// Decompresses a packed group file on its own thread
+// The reading thread waits only if it catches up with decompression
+// Up to MaxBlocks blocks around the reading position are kept, so going back a little costs nothing; going back further
+// continues decompressing from the closest chunk (seekable files) or checkpoint of the decompression state before it
+class C4GroupReadAhead
+{
+public:
+	C4GroupReadAhead(const char *filename, size_t position) : Filename{filename}, FirstNeeded{position / BlockSize}, Position{position} {}
+	~C4GroupReadAhead();
+
+	static constexpr size_t BlockSize{StdGzCompressedFile::ChunkSize};
+	static constexpr size_t MaxBlocks{128}; // kept at most, ahead of and behind the reading position
+	static constexpr size_t CheckpointBlocks{4}; // blocks between checkpoints; each one takes about 40 KB
+
+private:
+	std::string Filename;
+	std::mutex Mutex;
+	std::condition_variable Changed;
+	std::map<size_t, std::unique_ptr<uint8_t[]>> Blocks; // BlockSize each, except for the last block of the file
+	size_t FirstNeeded; // block at the reading position; never dropped
+	size_t TotalSize{SIZE_MAX}; // decompressed size, once known
+	bool Failed{false}; // worker has stopped because of an error
+	bool Cancelled{false};
+	size_t Position; // only accessed by the reading thread
+	std::thread Worker;
+
+public:
+	void Start();
+	bool Read(void *buffer, size_t size);
+	bool Advance(size_t offset);
+	void Seek(size_t position);
+
+private:
+	void Run(); // executed by Worker
+	void Cancel();
+	// with Mutex locked
+	bool NextMissing(size_t &block) const;
+	bool MakeRoom(size_t block);
+	void SetPosition(size_t position);
+};
+
+C4GroupReadAhead::~C4GroupReadAhead()
+{
+	Cancel();
+	if (Worker.joinable()) Worker.join();
+}
+
+void C4GroupReadAhead::Start()
+{
+#ifdef C4ENGINE
+	Worker = C4Thread::Create({"C4GroupReadAhead"}, [this] { Run(); });
+#endif
+}
+
+void C4GroupReadAhead::Run()
+{
+	try
+	{
+		StdGzCompressedFile::Read file{Filename};
+		std::vector<std::unique_ptr<StdGzCompressedFile::Read::Checkpoint>> checkpoints; // at every CheckpointBlocks blocks
+		size_t fileBlock{0}; // block at the file position
+		if (file.IsSeekable())
+		{
+			const std::lock_guard lock{Mutex};
+			TotalSize = file.UncompressedSize();
+		}
+
+		std::unique_ptr<uint8_t[]> data;
+		for (;;)
+		{
+			size_t block;
+			{
+				std::unique_lock lock{Mutex};
+				Changed.wait(lock, [this, &block] { return Cancelled || NextMissing(block); });
+				if (Cancelled) return;
+			}
+
+			// go back, or skip ahead if that saves decompressing
+			if (file.IsSeekable())
+			{
+				if (block != fileBlock && file.Seek(block * BlockSize)) fileBlock = block;
+			}
+			else if (const size_t checkpoint{block / CheckpointBlocks}; checkpoint < checkpoints.size() && (block < fileBlock || checkpoint * CheckpointBlocks > fileBlock))
+			{
+				file.RestoreCheckpoint(*checkpoints[checkpoint]);
+				fileBlock = checkpoint * CheckpointBlocks;
+			}
+
+			if (!file.IsSeekable() && fileBlock == checkpoints.size() * CheckpointBlocks)
+			{
+				checkpoints.emplace_back(file.SaveCheckpoint());
+			}
+
+			if (!data) data.reset(new uint8_t[BlockSize]);
+			const size_t read{file.ReadData(data.get(), BlockSize)};
+
+			const std::lock_guard lock{Mutex};
+			if (read < BlockSize)
+			{
+				TotalSize = fileBlock * BlockSize + read;
+			}
+			// blocks decompressed on the way to the one needed are kept as well, as the reader may go back to them
+			if (read && fileBlock + MaxBlocks > FirstNeeded && fileBlock < FirstNeeded + MaxBlocks && !Blocks.contains(fileBlock) && MakeRoom(fileBlock))
+			{
+				Blocks.emplace(fileBlock, std::move(data));
+			}
+			++fileBlock;
+			Changed.notify_all();
+		}
+	}
+	catch (const StdGzCompressedFile::Exception &)
+	{
+		// the reader will fail at the first block that is missing
+	}
+
+	const std::lock_guard lock{Mutex};
+	Failed = true;
+	Changed.notify_all();
+}
+
+bool C4GroupReadAhead::NextMissing(size_t &block) const
+{
+	for (block = FirstNeeded; block < FirstNeeded + MaxBlocks && block * BlockSize < TotalSize; ++block)
+	{
+		if (!Blocks.contains(block))
+		{
+			// there has to be room for it without dropping blocks nearer to the reading position
+			return Blocks.size() < MaxBlocks || Blocks.begin()->first < FirstNeeded || Blocks.rbegin()->first > block;
+		}
+	}
+	return false;
+}
+
+bool C4GroupReadAhead::MakeRoom(const size_t block)
+{
+	if (Blocks.size() < MaxBlocks) return true;
+
+	// drop the earliest block the reader has passed, or otherwise the one farthest ahead
+	if (const auto first = Blocks.begin(); first->first < std::min(block, FirstNeeded))
+	{
+		Blocks.erase(first);
+		return true;
+	}
+	if (const auto last = std::prev(Blocks.end()); block >= FirstNeeded && last->first > block)
+	{
+		Blocks.erase(last);
+		return true;
+	}
+	return false;
+}
+
+void C4GroupReadAhead::Cancel()
+{
+	const std::lock_guard lock{Mutex};
+	Cancelled = true;
+	Changed.notify_all();
+}
+
+void C4GroupReadAhead::SetPosition(const size_t position)
+{
+	Position = position;
+	FirstNeeded = position / BlockSize;
+	Changed.notify_all();
+}
+
+bool C4GroupReadAhead::Read(void *const buffer, size_t size)
+{
+	auto *target = static_cast<uint8_t *>(buffer);
+	std::unique_lock lock{Mutex};
+	while (size)
+	{
+		// wait for decompression to catch up
+		Changed.wait(lock, [this] { return Failed || Position >= TotalSize || Blocks.contains(FirstNeeded); });
+		const auto it = Blocks.find(FirstNeeded);
+		if (it == Blocks.end() || Position >= TotalSize) return false;
+
+		const size_t transfer{std::min(size, std::min(TotalSize, (FirstNeeded + 1) * BlockSize) - Position)};
+		const uint8_t *const block{it->second.get()};
+		lock.unlock();
+		std::memcpy(target, block + Position % BlockSize, transfer);
+		target += transfer;
+		size -= transfer;
+		lock.lock();
+
+		SetPosition(Position + transfer);
+	}
+	return true;
+}
+
+bool C4GroupReadAhead::Advance(const size_t offset)
+{
+	std::unique_lock lock{Mutex};
+	SetPosition(Position + offset);
+	// a block is only complete if it is not the last one
+	Changed.wait(lock, [this] { return Failed || TotalSize != SIZE_MAX || Blocks.contains(FirstNeeded); });
+	return Position <= TotalSize && (TotalSize != SIZE_MAX || Blocks.contains(FirstNeeded));
+}
+
+void C4GroupReadAhead::Seek(const size_t position)
+{
+	const std::lock_guard lock{Mutex};
+	SetPosition(position);
+}
+
 C4Group::C4Group()
 {
 	Init();
@@ -622,10 +832,13 @@ void C4Group::Init()
 	// File only
 	FilePtr = 0;
 	EntryOffset = 0;
+	CurrFileName[0] = 0;
 	Modified = false;
 	Head.Init();
 	FirstEntry = nullptr;
+	EntryIndex.clear();
 	SearchPtr = nullptr;
+	Seekable = false;
 	// Folder only
 	FolderSearch.Reset();
 	// Error status
@@ -757,6 +970,7 @@ bool C4Group::OpenRealGrpFile()
 
 	// Open StdFile
 	if (!StdFile.Open(FileName, true)) return Error("OpenRealGrpFile: Cannot open standard file");
+	Seekable = StdFile.IsSeekable();
 
 	// Read header
 	if (!StdFile.Read(reinterpret_cast<uint8_t *>(&Head), sizeof(C4GroupHeader))) return Error("OpenRealGrpFile: Error reading header");
@@ -787,6 +1001,21 @@ bool C4Group::OpenRealGrpFile()
 	return true;
 }
 
+bool C4Group::StartReadAhead()
+{
+#ifdef C4ENGINE
+	// packed top-level groups only; children read through their mother
+	if (Status != GRPF_File || Mother) return false;
+	if (ReadAhead) return true;
+
+	ReadAhead = std::make_shared<C4GroupReadAhead>(FileName, EntryOffset + FilePtr);
+	ReadAhead->Start();
+	return true;
+#else
+	return false;
+#endif
+}
+
 bool C4Group::AddEntry(int status,
 	bool childgroup,
 	const char *fname,
@@ -852,7 +1081,7 @@ bool C4Group::AddEntry(int status,
 
 	// Delete existing entries of same name
 	centry = GetEntry(GetFilename(entryname ? entryname : fname));
-	if (centry) { centry->Status = C4GRES_Deleted; Head.Entries--; }
+	if (centry) { centry->Status = C4GRES_Deleted; Head.Entries--; EntryIndex.erase(GetEntryIndexKey(centry->FileName)); }
 
 	// Allocate memory for new entry
 	nentry = new C4GroupEntry;
@@ -886,6 +1115,7 @@ bool C4Group::AddEntry(int status,
 	// Append entry to list
 	if (lentry) lentry->Next = nentry;
 	else FirstEntry = nentry;
+	EntryIndex[GetEntryIndexKey(nentry->FileName)] = nentry;
 
 	// Increase virtual file count of group
 	Head.Entries++;
@@ -896,6 +1126,9 @@ bool C4Group::AddEntry(int status,
 C4GroupEntry *C4Group::GetEntry(const char *szName)
 {
 	if (Status == GRPF_Folder) return nullptr;
+	// Exact names are looked up in the index, wildcards walk the list in group order
+	if (szName && !SCharCountEx(szName, "*?"))
+		return GetIndexedEntry(szName);
 	C4GroupEntry *centry;
 	for (centry = FirstEntry; centry; centry = centry->Next)
 		if (centry->Status != C4GRES_Deleted)
@@ -904,6 +1137,19 @@ C4GroupEntry *C4Group::GetEntry(const char *szName)
 	return nullptr;
 }
 
+C4GroupEntry *C4Group::GetIndexedEntry(const char *szName)
+{
+	const auto it = EntryIndex.find(GetEntryIndexKey(szName));
+	return it != EntryIndex.end() ? it->second : nullptr;
+}
+
+std::string C4Group::GetEntryIndexKey(const char *szName)
+{
+	std::string key{szName};
+	for (char &c : key) c = C4Strings::ToLower(c);
+	return key;
+}
+
 bool C4Group::Close()
 {
 	C4GroupEntry *centry;
@@ -994,8 +1240,9 @@ bool C4Group::Save(bool fReOpen)
 	}
 
 	// Create the new (temp) group file
+	// Child groups end up decompressed in their mother, so only top-level groups use the seekable format
 	CStdFile tfile;
-	if (!tfile.Create(szTempFileName, true))
+	if (!tfile.Create(szTempFileName, true, false, false, Seekable && !Mother))
 	{
 		delete[] save_core; return Error("Close: ...");
 	}
@@ -1004,7 +1251,8 @@ bool C4Group::Save(bool fReOpen)
 	C4GroupHeader headbuf = Head;
 	MemScramble(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader));
 	if (!tfile.Write(reinterpret_cast<uint8_t *>(&headbuf), sizeof(C4GroupHeader))
-		|| !tfile.Write(reinterpret_cast<uint8_t *>(save_core), Head.Entries * sizeof(C4GroupEntryCore)))
+		|| !tfile.Write(reinterpret_cast<uint8_t *>(save_core), Head.Entries * sizeof(C4GroupEntryCore))
+		|| !tfile.ChunkBoundary())
 	{
 		tfile.Close(); delete[] save_core; return Error("Close: ...");
 	}
@@ -1014,7 +1262,7 @@ bool C4Group::Save(bool fReOpen)
 	int iTotalSize = 0, iSizeDone = 0;
 	for (centry = FirstEntry; centry; centry = centry->Next) iTotalSize += centry->Size;
 	for (centry = FirstEntry; centry; centry = centry->Next)
-		if (AppendEntry2StdFile(centry, tfile))
+		if (AppendEntry2StdFile(centry, tfile) && tfile.ChunkBoundary())
 		{
 			iSizeDone += centry->Size; if (iTotalSize && fnProcessCallback) fnProcessCallback(centry->FileName, 100 * iSizeDone / iTotalSize);
 		}
@@ -1055,6 +1303,7 @@ void C4Group::Default()
 {
 	FirstEntry = nullptr;
 	StdFile.Default();
+	ReadAhead.reset();
 	Mother = nullptr;
 	ExclusiveChild = 0;
 	Init();
@@ -1064,6 +1313,7 @@ void C4Group::Clear()
 {
 	// Delete entries
 	C4GroupEntry *next;
+	EntryIndex.clear();
 	while (FirstEntry)
 	{
 		next = FirstEntry->Next;
@@ -1072,6 +1322,8 @@ void C4Group::Clear()
 	}
 	// Close std file
 	StdFile.Close();
+	// Stop read-ahead
+	ReadAhead.reset();
 	// Delete mother
 	if (Mother && ExclusiveChild)
 	{
@@ -1216,6 +1468,13 @@ C4GroupEntry *C4Group::SearchNextEntry(const char *szName)
 	switch (Status)
 	{
 	case GRPF_File:
+		// A fresh search for an exact name can use the index
+		if (szName && SearchPtr && SearchPtr == FirstEntry && !SCharCountEx(szName, "*?"))
+		{
+			pEntry = GetIndexedEntry(szName);
+			SearchPtr = pEntry ? pEntry->Next : nullptr;
+			return pEntry;
+		}
 		for (pEntry = SearchPtr; pEntry; pEntry = pEntry->Next)
 			if (pEntry->Status != C4GRES_Deleted)
 				if (WildcardMatch(szName, pEntry->FileName))
@@ -1283,7 +1542,7 @@ bool C4Group::Read(void *pBuffer, size_t iSize)
 		// Regular group: read from standard file
 		else
 		{
-			if (!StdFile.Read(pBuffer, iSize))
+			if (!(ReadAhead ? ReadAhead->Read(pBuffer, iSize) : StdFile.Read(pBuffer, iSize)))
 			{
 				RewindFilePtr(); return Error("Read:");
 			}
@@ -1313,7 +1572,7 @@ bool C4Group::AdvanceFilePtr(size_t iOffset, C4Group *pByChild)
 	// Regular group
 	else if (Status == GRPF_File)
 	{
-		if (!StdFile.Advance(iOffset))
+		if (!(ReadAhead ? ReadAhead->Advance(iOffset) : StdFile.Advance(iOffset)))
 			return false;
 	}
 	// Open folder
@@ -1333,7 +1592,7 @@ bool C4Group::RewindFilePtr()
 {
 #ifndef NDEBUG
 #ifdef C4ENGINE
-	if (szCurrAccessedEntry && !iC4GroupRewindFilePtrNoWarn)
+	if (szCurrAccessedEntry && !iC4GroupRewindFilePtrNoWarn && !StdFile.IsSeekable())
 	{
 		LogNTr(spdlog::level::debug, "C4Group::RewindFilePtr() for {} ({})", szCurrAccessedEntry ? szCurrAccessedEntry : "???", +FileName);
 		szCurrAccessedEntry = nullptr;
@@ -1349,6 +1608,11 @@ bool C4Group::RewindFilePtr()
 		if (!Mother->AdvanceFilePtr(EntryOffset, this)) // Advance data offset
 			return false;
 	}
+	// Read-ahead: just set position
+	else if (ReadAhead)
+	{
+		ReadAhead->Seek(EntryOffset);
+	}
 	// Regular group or open folder: rewind standard file
 	else
 	{
@@ -1611,6 +1875,7 @@ bool C4Group::DeleteEntry(const char *szFilename, bool fRecycle)
 		// (moved buffers are deleted by ~C4GroupEntry)
 		// Delete status and update virtual file count
 		pEntry->Status = C4GRES_Deleted;
+		EntryIndex.erase(GetEntryIndexKey(pEntry->FileName));
 		Head.Entries--;
 		break;
 	case GRPF_Folder:
@@ -1644,7 +1909,9 @@ bool C4Group::Rename(const char *szFile, const char *szNewName)
 		// Check double name
 		if (GetEntry(szNewName) && !SEqualNoCase(szNewName, szFile)) return Error("Rename: File exists already");
 		// Rename
+		EntryIndex.erase(GetEntryIndexKey(pEntry->FileName));
 		SCopy(szNewName, pEntry->FileName, _MAX_FNAME);
+		EntryIndex[GetEntryIndexKey(pEntry->FileName)] = pEntry;
 		Modified = true;
 		break;
 	case GRPF_Folder:
@@ -1928,6 +2195,7 @@ bool C4Group::AccessEntry(const char *szWildCard,
 	szCurrAccessedEntry = nullptr;
 #endif
 	if (!fResult) return false;
+	SCopy(fname, CurrFileName, _MAX_FNAME);
 	if (sFileName) SCopy(fname, sFileName);
 	if (iSize) *iSize = iCurrFileSize;
 	return true;
@@ -1947,6 +2215,7 @@ bool C4Group::AccessNextEntry(const char *szWildCard,
 	szCurrAccessedEntry = nullptr;
 #endif
 	if (!fResult) return false;
+	SCopy(fname, CurrFileName, _MAX_FNAME);
 	if (sFileName) SCopy(fname, sFileName);
 	if (iSize) *iSize = iCurrFileSize;
 	return true;
@@ -2246,6 +2515,60 @@ bool C4Group::LoadEntry(const char *szEntryName, StdBuf &Buf)
 	return true;
 }
 
+bool C4Group::LoadEntry(const char *szEntryName, C4GroupEntryView &View)
+{
+	if (!AccessEntry(szEntryName)) return Error("LoadEntry: Not found");
+	return ReadAccessedEntry(View);
+}
+
+bool C4Group::ReadAccessedEntry(C4GroupEntryView &View)
+{
+	View.Clear();
+	// Map contents that are stored uncompressed on disk
+	if (MapEntry(CurrFileName, iCurrFileSize, View.Mapping)) return true;
+	// Copy everything else
+	View.Buffer.New(iCurrFileSize);
+	if (!Read(View.Buffer.getMData(), iCurrFileSize))
+	{
+		View.Buffer.Clear();
+		return Error("LoadEntry: Reading error");
+	}
+	return true;
+}
+
+bool C4Group::MapEntry(const char *szName, size_t iSize, StdFileMapping &Mapping)
+{
+	switch (Status)
+	{
+	case GRPF_File:
+	{
+		C4GroupEntry *centry;
+		if (!(centry = GetEntry(szName)) || centry->Status != C4GRES_InGroup) return false;
+		// Get the offset in the uncompressed top-level group file
+		size_t iPosition = EntryOffset + centry->Offset;
+		const C4Group *pRoot = this;
+		for (; pRoot->Mother; pRoot = pRoot->Mother)
+		{
+			// Packed groups in folders are compressed files of their own
+			if (pRoot->Mother->Status != GRPF_File) return false;
+			iPosition += pRoot->MotherOffset + pRoot->Mother->EntryOffset;
+		}
+		// Only seekable group files store incompressible chunks as they are
+		uint64_t iFileOffset;
+		return pRoot->StdFile.GetStoredRange(iPosition, iSize, iFileOffset) && Mapping.Map(pRoot->FileName, iFileOffset, iSize);
+	}
+	case GRPF_Folder:
+	{
+		char szPath[_MAX_PATH + 1];
+		FormatWithNull(szPath, "{}" DirSep "{}", +FileName, szName);
+		// Packed groups are compressed
+		if (C4Group_IsGroup(szPath)) return false;
+		return Mapping.Map(szPath, 0, iSize);
+	}
+	}
+	return false;
+}
+
 bool C4Group::LoadEntryString(const char *szEntryName, StdStrBuf &Buf)
 {
 	size_t size;
@@ -2332,6 +2655,17 @@ bool C4Group::Sort(const char *szSortList)
 	return true;
 }
 
+bool C4Group::SetSeekable(const bool seekable)
+{
+	if (Status != GRPF_File || Mother) return Error("SetSeekable: Not a packed top-level group");
+	if (Seekable != seekable)
+	{
+		Seekable = seekable;
+		Modified = true;
+	}
+	return true;
+}
+
 C4Group *C4Group::GetMother()
 {
 	return Mother;
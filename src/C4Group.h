@@ -22,6 +22,10 @@
 #include <StdBuf.h>
 #include <StdCompiler.h>
 
+#include <memory>
+#include <string>
+#include <unordered_map>
+
 // C4Group-Rewind-warning:
 // The current C4Group-implementation cannot handle random file access very well,
 // because all files are written within a single zlib-stream.
@@ -38,8 +42,9 @@
 // sort order lists in C4Components.h accordingly, and enforce a reading order for that
 // component.
 //
-// Maybe some day, someone will write a C4Group-implementation that is probably capable of
-// random access...
+// Group files written in the seekable format (see C4Group::SetSeekable) compress their
+// contents in independent chunks with an index, so rewinds only need to decompress the chunk
+// the target entry starts in. Older engines cannot read this format, though.
 #ifndef NDEBUG
 extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_DISABLE_REWINDWARN ++iC4GroupRewindFilePtrNoWarn;
@@ -141,6 +146,24 @@ public:
 	void Set(const DirectoryIterator &iter, const char *szPath);
 };
 
+// Read-only contents of a group entry: mapped from disk if stored uncompressed there, copied otherwise
+class C4GroupEntryView
+{
+public:
+	const void *getData() const { return Mapping ? Mapping.GetData() : Buffer.getData(); }
+	size_t getSize() const { return Mapping ? Mapping.GetSize() : Buffer.getSize(); }
+	bool IsMapped() const { return !!Mapping; }
+	void Clear() { Mapping.Unmap(); Buffer.Clear(); }
+
+private:
+	StdFileMapping Mapping;
+	StdBuf Buffer;
+
+	friend class C4Group;
+};
+
+class C4GroupReadAhead;
+
 const int GRPF_Inactive = 0,
           GRPF_File = 1,
           GRPF_Folder = 2;
@@ -168,6 +191,7 @@ protected:
 	C4GroupEntry *SearchPtr;
 	CStdFile StdFile;
 	size_t iCurrFileSize; // size of last accessed file
+	char CurrFileName[_MAX_FNAME + 1]; // name of last accessed file
 	// File only
 	size_t FilePtr;
 	int MotherOffset;
@@ -175,6 +199,7 @@ protected:
 	bool Modified;
 	C4GroupHeader Head;
 	C4GroupEntry *FirstEntry;
+	std::unordered_map<std::string, C4GroupEntry *> EntryIndex; // non-deleted entries by lower case file name
 	// Folder only
 	DirectoryIterator FolderSearch;
 	C4GroupEntry FolderSearchEntry;
@@ -186,6 +211,9 @@ protected:
 	bool MadeOriginal;
 
 	bool NoSort; // If this flag is set, all entries will be marked NoSort in AddEntry
+	bool Seekable; // packed file is (to be) written in the seekable format
+
+	std::shared_ptr<C4GroupReadAhead> ReadAhead; // if set, packed contents are read from here instead of StdFile
 
 public:
 	bool Open(const char *szGroupName, bool fCreate = false, OpenFlags flags = OpenFlags::None);
@@ -194,6 +222,7 @@ public:
 	bool OpenAsChild(C4Group *pMother, const char *szEntryName, bool fExclusive = false);
 	bool OpenChild(const char *strEntry);
 	bool OpenMother();
+	bool StartReadAhead(); // decompress the packed file on its own thread ahead of reading
 	bool Add(const char *szFiles);
 	bool Add(const char *szFile, const char *szAddAs);
 	bool Add(const char *szName, void *pBuffer, size_t iSize, bool fChild = false, bool fHoldBuffer = false, time_t iTime = 0, bool fExecutable = false);
@@ -221,6 +250,8 @@ public:
 		size_t *ipSize = nullptr, int iAppendZeros = 0);
 	bool LoadEntry(const char *szEntryName, StdBuf &Buf);
 	bool LoadEntryString(const char *szEntryName, StdStrBuf &Buf);
+	bool LoadEntry(const char *szEntryName, C4GroupEntryView &View); // maps the entry instead of copying it where possible
+	bool ReadAccessedEntry(C4GroupEntryView &View); // whole entry of the last AccessEntry; the entry must not have been read from yet
 	bool FindEntry(const char *szWildCard,
 		char *sFileName = nullptr,
 		size_t *iSize = nullptr,
@@ -253,6 +284,8 @@ public:
 	inline bool IsPacked() { return Status == GRPF_File; }
 	inline bool HasPackedMother() { if (!Mother) return false; return Mother->IsPacked(); }
 	inline bool SetNoSort(bool fNoSort) { NoSort = fNoSort; return true; }
+	bool SetSeekable(bool seekable); // choose the file format of a packed top-level group; converts on close
+	bool IsSeekable() const { return Seekable; }
 #ifndef NDEBUG
 	void PrintInternals(const char *szIndent = nullptr);
 #endif
@@ -286,6 +319,9 @@ protected:
 	bool SetFilePtr2Entry(const char *szName, C4Group *pByChild = nullptr);
 	bool AppendEntry2StdFile(C4GroupEntry *centry, CStdFile &stdfile);
 	C4GroupEntry *GetEntry(const char *szName);
+	C4GroupEntry *GetIndexedEntry(const char *szName);
+	bool MapEntry(const char *szName, size_t iSize, StdFileMapping &Mapping);
+	static std::string GetEntryIndexKey(const char *szName);
 	C4GroupEntry *SearchNextEntry(const char *szName);
 	C4GroupEntry *GetNextFolderEntry();
 	bool CalcCRC32(C4GroupEntry *pEntry);
@@ -34,13 +34,17 @@
 #include <C4Game.h>
 #include <C4Application.h>
 #include <C4Wrappers.h>
+#include <C4ThreadPool.h>
 
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
 #include <cmath>
+#include <exception>
+#include <latch>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <utility>
 
 int32_t MVehic = MNone, MTunnel = MNone, MWater = MNone, MSnow = MNone, MEarth = MNone, MGranite = MNone;
@@ -108,28 +112,50 @@ void C4Landscape::ExecuteScan()
 	if (mat >= Game.Material.Num)
 		return;
 
+	// Temperature change activating or deactivating any conversion? Then every column has to be checked again
+	if (iTemperature != ScanTemperature)
+	{
+		if (TempConversionsChanged(ScanTemperature, iTemperature))
+			SetScanDirty(0, Width);
+		ScanTemperature = iTemperature;
+	}
+
 #ifdef DEBUGREC_MATSCAN
 	AddDbgRec(RCT_MatScan, &ScanX, sizeof(ScanX));
 #endif
 
 	for (int32_t cnt = 0; cnt < ScanSpeed; cnt++)
 	{
-		// Scan landscape column: sectors down
-		int32_t last_mat = -1;
-		for (cy = 0; cy < Height; cy++)
+		// Skip columns that haven't changed since they were last found to contain nothing to convert
+		// The result of scanning them again would be the same, so this doesn't affect sync
+		if (ScanColumnDirty[ScanX])
 		{
-			mat = _GetMat(ScanX, cy);
-			// material change?
-			if (last_mat != mat)
+			bool fConversionFound = false;
+			// Scan landscape column: sectors down
+			int32_t last_mat = -1;
+			for (cy = 0; cy < Height; cy++)
 			{
-				// upwards
-				if (last_mat != -1)
-					DoScan(ScanX, cy - 1, last_mat, 1);
-				// downwards
-				if (mat != -1)
-					cy += DoScan(ScanX, cy, mat, 0);
+				mat = _GetMat(ScanX, cy);
+				// material change?
+				if (last_mat != mat)
+				{
+					// upwards
+					if (last_mat != -1)
+					{
+						if (GetTempConvertTex(last_mat, 1, iTemperature)) fConversionFound = true;
+						DoScan(ScanX, cy - 1, last_mat, 1);
+					}
+					// downwards
+					if (mat != -1)
+					{
+						if (GetTempConvertTex(mat, 0, iTemperature)) fConversionFound = true;
+						cy += DoScan(ScanX, cy, mat, 0);
+					}
+				}
+				last_mat = mat;
 			}
-			last_mat = mat;
+			// column stays dirty as long as it might still convert, even if nothing was converted this time
+			ScanColumnDirty[ScanX] = fConversionFound;
 		}
 
 		// Scan advance & rewind
@@ -139,22 +165,44 @@ void C4Landscape::ExecuteScan()
 	}
 }
 
-#define PRETTY_TEMP_CONV
-
-int32_t C4Landscape::DoScan(int32_t cx, int32_t cy, int32_t mat, int32_t dir)
+int32_t C4Landscape::GetTempConvertTex(int32_t mat, int32_t dir, int32_t iTemperature)
 {
+	const C4Material &material = Game.Material.Map[mat];
 	int32_t conv_to_tex = 0;
-	int32_t iTemperature = Game.Weather.GetTemperature();
 	// Check below conv
-	if (Game.Material.Map[mat].BelowTempConvertDir == dir)
-		if (Game.Material.Map[mat].BelowTempConvertTo)
-			if (iTemperature < Game.Material.Map[mat].BelowTempConvert)
-				conv_to_tex = Game.Material.Map[mat].BelowTempConvertTo;
+	if (material.BelowTempConvertDir == dir)
+		if (material.BelowTempConvertTo)
+			if (iTemperature < material.BelowTempConvert)
+				conv_to_tex = material.BelowTempConvertTo;
 	// Check above conv
-	if (Game.Material.Map[mat].AboveTempConvertDir == dir)
-		if (Game.Material.Map[mat].AboveTempConvertTo)
-			if (iTemperature > Game.Material.Map[mat].AboveTempConvert)
-				conv_to_tex = Game.Material.Map[mat].AboveTempConvertTo;
+	if (material.AboveTempConvertDir == dir)
+		if (material.AboveTempConvertTo)
+			if (iTemperature > material.AboveTempConvert)
+				conv_to_tex = material.AboveTempConvertTo;
+	return conv_to_tex;
+}
+
+bool C4Landscape::TempConversionsChanged(int32_t iOldTemperature, int32_t iNewTemperature)
+{
+	for (int32_t mat = 0; mat < Game.Material.Num; mat++)
+		for (int32_t dir = 0; dir <= 1; dir++)
+			if (GetTempConvertTex(mat, dir, iOldTemperature) != GetTempConvertTex(mat, dir, iNewTemperature))
+				return true;
+	return false;
+}
+
+void C4Landscape::SetScanDirty(int32_t x, int32_t wdt)
+{
+	const int32_t iEnd = std::min<int32_t>(x + wdt, static_cast<int32_t>(ScanColumnDirty.size()));
+	for (x = std::max<int32_t>(x, 0); x < iEnd; x++)
+		ScanColumnDirty[x] = true;
+}
+
+#define PRETTY_TEMP_CONV
+
+int32_t C4Landscape::DoScan(int32_t cx, int32_t cy, int32_t mat, int32_t dir)
+{
+	const int32_t conv_to_tex = GetTempConvertTex(mat, dir, Game.Weather.GetTemperature());
 	// nothing to do?
 	if (!conv_to_tex) return 0;
 	// find material
@@ -257,6 +305,11 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	delete[] pInitial;       pInitial         = nullptr;
 	// clear scan
 	ScanX = 0;
+	ScanColumnDirty.clear();
+	SyncTileHashes.clear();
+	SyncTileCols = 0;
+	SyncHash = 0;
+	FreeTileStamps.clear();
 	Mode = C4LSC_Undefined;
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
@@ -276,6 +329,42 @@ void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
 	if (Modulation) Application.DDraw->DeactivateBlitModulation();
 }
 
+namespace
+{
+	constexpr int32_t C4LS_MinZoomBandHeight = 64; // minimum number of landscape rows per concurrently zoomed band
+
+	// Shares the pixels of a landscape surface, but clips to a separate row band
+	class C4LandscapeBandSurface : public CSurface8
+	{
+	public:
+		C4LandscapeBandSurface(const CSurface8 &source, int32_t iY, int32_t iY2)
+		{
+			Wdt = source.Wdt; Hgt = source.Hgt; Pitch = source.Pitch;
+			Bits = source.Bits;
+			Clip(source.ClipX, iY, source.ClipX2, iY2);
+		}
+
+		~C4LandscapeBandSurface() { Bits = nullptr; }
+
+		C4LandscapeBandSurface(const C4LandscapeBandSurface &) = delete;
+		C4LandscapeBandSurface &operator=(const C4LandscapeBandSurface &) = delete;
+	};
+
+	// Counts down the band latch even if zooming the band throws, so the waiting thread doesn't hang
+	class C4LandscapeBandDone
+	{
+	public:
+		explicit C4LandscapeBandDone(std::latch &latch) : latch{latch} {}
+		~C4LandscapeBandDone() { latch.count_down(); }
+
+		C4LandscapeBandDone(const C4LandscapeBandDone &) = delete;
+		C4LandscapeBandDone &operator=(const C4LandscapeBandDone &) = delete;
+
+	private:
+		std::latch &latch;
+	};
+}
+
 int32_t C4Landscape::ChunkyRandom(int32_t &iOffset, int32_t iRange)
 {
 	if (!iRange) return 0;
@@ -283,14 +372,14 @@ int32_t C4Landscape::ChunkyRandom(int32_t &iOffset, int32_t iRange)
 	return (iOffset ^ MapSeed) % iRange;
 }
 
-void C4Landscape::DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro)
+void C4Landscape::DrawChunk(CSurface8 &sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro)
 {
 	uint8_t top_rough; uint8_t side_rough;
 	// what to do?
 	switch (iChunkType)
 	{
 	case C4M_Flat:
-		Surface8->Box(tx, ty, tx + wdt, ty + hgt, mcol);
+		sfcTarget.Box(tx, ty, tx + wdt, ty + hgt, mcol);
 		return;
 	case C4M_TopFlat:
 		top_rough = 0; side_rough = 1;
@@ -314,10 +403,10 @@ void C4Landscape::DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, in
 	vtcs[12] = tx + wdt + ChunkyRandom(cro, rx / 2);          vtcs[13] = ty - ChunkyRandom(cro, rx / 2 * top_rough);
 	vtcs[14] = tx + wdt / 2;                                  vtcs[15] = ty - ChunkyRandom(cro, rx * top_rough);
 
-	Surface8->Polygon(8, vtcs, mcol);
+	sfcTarget.Polygon(8, vtcs, mcol);
 }
 
-void C4Landscape::DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro)
+void C4Landscape::DrawSmoothOChunk(CSurface8 &sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro)
 {
 	int vtcs[8];
 	int32_t rx = (std::max)(wdt / 2, 1);
@@ -336,18 +425,15 @@ void C4Landscape::DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t
 		vtcs[6] = tx + wdt / 2; vtcs[7] = ty + hgt / 3;
 	}
 
-	Surface8->Polygon(4, vtcs, mcol);
+	sfcTarget.Polygon(4, vtcs, mcol);
 }
 
-void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX, int32_t iOffY)
+void C4Landscape::ChunkOZoom(CSurface8 &sfcTarget, CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iChunkType, int32_t iOffX, int32_t iOffY)
 {
 	int32_t iX, iY, iChunkWidth, iChunkHeight, iToX, iToY;
 	int32_t iIFT;
 	uint8_t byMapPixel, byMapPixelBelow;
 	int iMapWidth, iMapHeight;
-	C4Material *pMaterial = Game.TextureMap.GetEntry(iTexture)->GetMaterial();
-	if (!pMaterial) return;
-	int32_t iChunkType = pMaterial->MapChunkType;
 	uint8_t byColor = MatTex2PixCol(iTexture);
 	// Get map & landscape size
 	sfcMap->GetSurfaceSize(iMapWidth, iMapHeight);
@@ -356,13 +442,13 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 	iMapWdt = BoundBy<int32_t>(iMapWdt, 0, iMapWidth - iMapX); iMapHgt = BoundBy<int32_t>(iMapHgt, 0, iMapHeight - iMapY);
 	// get chunk size
 	iChunkWidth = MapZoom; iChunkHeight = MapZoom;
-	Surface32->Lock();
-	if (AnimationSurface) AnimationSurface->Lock();
 	// Scan map lines
 	for (iY = iMapY; iY < iMapY + iMapHgt; iY++)
 	{
 		// Landscape target coordinate vertical
 		iToY = iY * iChunkHeight + iOffY;
+		// Skip lines whose chunks (including their random rim) cannot reach the target clipping rows
+		if (iToY + 3 * iChunkHeight < sfcTarget.ClipY || iToY - 3 * iChunkHeight > sfcTarget.ClipY2) continue;
 		// Scan map line
 		for (iX = iMapX; iX < iMapX + iMapWdt; iX++)
 		{
@@ -378,7 +464,7 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 				// Determine IFT
 				iIFT = 0; if (byMapPixel >= 128) iIFT = IFT;
 				// Draw chunk
-				DrawChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, pMaterial->MapChunkType, (iX << 2) + iY);
+				DrawChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, iChunkType, (iX << 2) + iY);
 			}
 			// Other chunk, check for slope smoothers
 			else
@@ -391,7 +477,7 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 						// Determine IFT
 						iIFT = 0; if (sfcMap->GetPix(iX - 1, iY) >= 128) iIFT = IFT;
 						// Draw smoother
-						DrawSmoothOChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 0, (iX << 2) + iY);
+						DrawSmoothOChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 0, (iX << 2) + iY);
 					}
 					// Same texture-material on right
 					if ((iX < iMapWidth - 1) && ((sfcMap->GetPix(iX + 1, iY) & 127) == iTexture))
@@ -399,13 +485,11 @@ void C4Landscape::ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, in
 						// Determine IFT
 						iIFT = 0; if (sfcMap->GetPix(iX + 1, iY) >= 128) iIFT = IFT;
 						// Draw smoother
-						DrawSmoothOChunk(iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 1, (iX << 2) + iY);
+						DrawSmoothOChunk(sfcTarget, iToX, iToY, iChunkWidth, iChunkHeight, byColor + iIFT, 1, (iX << 2) + iY);
 					}
 				}
 		}
 	}
-	Surface32->Unlock();
-	if (AnimationSurface) AnimationSurface->Unlock();
 }
 
 bool C4Landscape::GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage)
@@ -429,20 +513,73 @@ bool C4Landscape::GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, i
 
 bool C4Landscape::TexOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX, int32_t iToY)
 {
-	int32_t iIndex;
+	// ChunkOZoom all used textures into the given target
+	const auto zoomTextures = [=, this](CSurface8 &sfcTarget)
+	{
+		for (int32_t iIndex = 1; iIndex < C4M_MaxTexIndex; iIndex++)
+			if (dwpTextureUsage[iIndex] > 0)
+				if (const C4Material *const pMaterial{Game.TextureMap.GetEntry(iIndex)->GetMaterial()})
+				{
+					// ChunkOZoom map to landscape
+					ChunkOZoom(sfcTarget, sfcMap, iMapX, iMapY, iMapWdt, iMapHgt, iIndex, pMaterial->MapChunkType, iToX, iToY);
+				}
+	};
 
-	// ChunkOZoom all used textures
-	for (iIndex = 1; iIndex < C4M_MaxTexIndex; iIndex++)
-		if (dwpTextureUsage[iIndex] > 0)
-		{
-			// ChunkOZoom map to landscape
-			ChunkOZoom(sfcMap, iMapX, iMapY, iMapWdt, iMapHgt, iIndex, iToX, iToY);
-		}
+	Surface32->Lock();
+	if (AnimationSurface) AnimationSurface->Lock();
+
+	// Large areas are split into row bands that are zoomed concurrently
+	int32_t iBandCount = 1;
+	if (C4ThreadPool::Global && !SerialZoom)
+		iBandCount = std::min<int32_t>(std::thread::hardware_concurrency(), (Surface8->ClipY2 - Surface8->ClipY + 1) / C4LS_MinZoomBandHeight);
+	ZoomInBands(*Surface8, zoomTextures, iBandCount);
+
+	Surface32->Unlock();
+	if (AnimationSurface) AnimationSurface->Unlock();
 
 	// Done
 	return true;
 }
 
+void C4Landscape::ZoomInBands(CSurface8 &sfcTarget, const std::function<void(CSurface8 &)> &zoom, int32_t iBandCount)
+{
+	if (iBandCount <= 1)
+	{
+		zoom(sfcTarget);
+		return;
+	}
+
+	// Every band draws the same chunks in the same order clipped to its own rows, so the result equals the serial zoom
+	const int32_t iClipY = sfcTarget.ClipY, iClipHgt = sfcTarget.ClipY2 - sfcTarget.ClipY + 1;
+	std::vector<std::exception_ptr> errors(iBandCount);
+	{
+		std::latch bandsDone{iBandCount};
+		for (int32_t iBand = 0; iBand < iBandCount; ++iBand)
+		{
+			const int32_t iBandY = iClipY + iClipHgt * iBand / iBandCount;
+			const int32_t iBandY2 = iClipY + iClipHgt * (iBand + 1) / iBandCount - 1;
+			C4ThreadPool::Global->SubmitCallback([&sfcTarget, &zoom, &bandsDone, &error = errors[iBand], iBandY, iBandY2]
+			{
+				const C4LandscapeBandDone done{bandsDone};
+				try
+				{
+					C4LandscapeBandSurface band{sfcTarget, iBandY, iBandY2};
+					zoom(band);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+			});
+		}
+		bandsDone.wait();
+	}
+
+	// Pass errors on to the caller like the serial zoom does
+	for (const auto &error : errors)
+		if (error) std::rethrow_exception(error);
+}
+
 bool C4Landscape::SkyToLandscape(int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY)
 {
 	if (!Surface32->Lock()) return false;
@@ -686,6 +823,8 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 
 	// Scan settings
 	ScanSpeed = BoundBy(Width / 500, 2, 15);
+	ScanColumnDirty.assign(Width, true);
+	ScanTemperature = Game.Weather.GetTemperature();
 
 	// create it
 	if (!Game.C4S.Landscape.ExactLandscape)
@@ -735,6 +874,9 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	// enforce first color to be transparent
 	Surface8->EnforceC0Transparency();
 
+	// hash the final landscape; from now on, changes are hashed incrementally
+	InitSyncHashes();
+
 	// after map/landscape creation, the seed must be fixed again, so there's no difference between clients creating
 	// and not creating the map
 	Game.FixRandom(Game.Parameters.RandomSeed);
@@ -792,6 +934,18 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	// get and check pixel
 	uint8_t opix = _GetPix(x, y);
 	if (npix == opix) return true;
+	// column must be scanned again
+	ScanColumnDirty[x] = true;
+	// update sync hashes
+	if (!SyncTileHashes.empty())
+	{
+		const uint32_t iHashChange = GetPixSyncHash(x, y, npix) - GetPixSyncHash(x, y, opix);
+		SyncTileHashes[(y / C4LS_SyncHashTileSize) * SyncTileCols + x / C4LS_SyncHashTileSize] += iHashChange;
+		SyncHash += iHashChange;
+	}
+	// stamp tile for cached paths
+	if (!FreeTileStamps.empty() && DensitySolid(Pix2Dens[npix]) != DensitySolid(Pix2Dens[opix]))
+		FreeTileStamps[(y / C4LS_SyncHashTileSize) * SyncTileCols + x / C4LS_SyncHashTileSize] = ++FreeChangeStamp;
 	// count pixels
 	if (Pix2Dens[npix])
 	{
@@ -1605,15 +1759,13 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 	// adjust pal
 	if (!Mat2Pal()) return false;
 	// load the 32bit-surface, too
-	size_t iSize;
-	if (hGroup.AccessEntry(C4CFN_LandscapePNG, &iSize))
+	C4GroupEntryView pngData;
+	if (hGroup.AccessEntry(C4CFN_LandscapePNG) && hGroup.ReadAccessedEntry(pngData))
 	{
-		const std::unique_ptr<uint8_t []> pPNG(new uint8_t[iSize]);
-		hGroup.Read(pPNG.get(), iSize);
 		bool locked = false;
 		try
 		{
-			CPNGFile png(pPNG.get(), iSize);
+			CPNGFile png(pngData.getData(), pngData.getSize());
 			StdBitmap bmp(png.Width(), png.Height(), png.UsesAlpha());
 			png.Decode(bmp.GetBytes());
 			if (!Surface32->Lock()) throw std::runtime_error("Could not lock surface");
@@ -1626,6 +1778,7 @@ bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
 			LogNTr(spdlog::level::err, "Could not load 32 bit landscape surface from PNG file: {}", e.what());
 		}
 		if (locked) Surface32->Unlock();
+		pngData.Clear();
 		UpdateAnimationSurface({0, 0, Width, Height});
 	}
 	// no PNG: convert old-style landscapes
@@ -1713,6 +1866,12 @@ void C4Landscape::Default()
 	ClearBlastMatCount();
 	ScanX = 0;
 	ScanSpeed = 2;
+	ScanColumnDirty.clear();
+	ScanTemperature = 0;
+	SyncTileHashes.clear();
+	SyncTileCols = 0;
+	SyncHash = 0;
+	FreeTileStamps.clear();
 	LeftOpen = RightOpen = 0;
 	TopOpen = BottomOpen = false;
 	Gravity = FIXED100(20); // == 0.2
@@ -2728,7 +2887,7 @@ bool C4Landscape::DrawChunks(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, i
 	int32_t x, y;
 	for (x = 0; x < icntx; x++)
 		for (y = 0; y < icnty; y++)
-			DrawChunk(tx + wdt * x / icntx, ty + hgt * y / icnty, wdt / icntx, hgt / icnty, byColor, Game.Material.Map[iMaterial].MapChunkType, Random(1000));
+			DrawChunk(*Surface8, tx + wdt * x / icntx, ty + hgt * y / icnty, wdt / icntx, hgt / icnty, byColor, Game.Material.Map[iMaterial].MapChunkType, Random(1000));
 
 	// remove clipper
 	Surface8->NoClip();
@@ -3117,6 +3276,9 @@ void C4Landscape::UpdatePixMaps()
 	for (i = 0; i < 256; i++) Pix2Dens[i] = MatDensity(Pix2Mat[i]);
 	for (i = 0; i < 256; i++) Pix2Place[i] = MatValid(Pix2Mat[i]) ? Game.Material.Map[Pix2Mat[i]].Placement : 0;
 	Pix2Place[0] = 0;
+	// materials of existing pixels may have changed
+	SetScanDirty(0, Width);
+	SetFreeChanged(C4Rect(0, 0, Width, Height));
 }
 
 bool C4Landscape::Mat2Pal()
@@ -3159,6 +3321,8 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 {
 	// relight
 	Relight(BoundingBox);
+	// the scan has to look at the changed columns again
+	SetScanDirty(BoundingBox.x, BoundingBox.Wdt);
 	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
 	// Restore Solidmasks
 	C4Rect SolidMaskRect = BoundingBox;
@@ -3169,9 +3333,65 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 		pSolid->Repair(SolidMaskRect);
 	}
 	if (updateMatAndPixCnt) UpdatePixCnt(BoundingBox);
+	// bulk changes bypass _SetPix; clippers may include the right and bottom edge
+	UpdateSyncHashes(C4Rect(BoundingBox.x - 1, BoundingBox.y - 1, BoundingBox.Wdt + 2, BoundingBox.Hgt + 2));
+	SetFreeChanged(C4Rect(BoundingBox.x - 1, BoundingBox.y - 1, BoundingBox.Wdt + 2, BoundingBox.Hgt + 2));
 	C4SolidMask::CheckConsistency();
 }
 
+void C4Landscape::InitSyncHashes()
+{
+	SyncTileCols = (Width + C4LS_SyncHashTileSize - 1) / C4LS_SyncHashTileSize;
+	SyncTileHashes.assign(SyncTileCols * ((Height + C4LS_SyncHashTileSize - 1) / C4LS_SyncHashTileSize), 0);
+	SyncHash = 0;
+	UpdateSyncHashes(C4Rect(0, 0, Width, Height));
+	// everything from before is outdated
+	FreeTileStamps.assign(SyncTileHashes.size(), ++FreeChangeStamp);
+}
+
+void C4Landscape::SetFreeChanged(C4Rect Rect)
+{
+	if (FreeTileStamps.empty()) return;
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (!Rect.Wdt || !Rect.Hgt) return;
+	++FreeChangeStamp;
+	for (int32_t ty = Rect.y / C4LS_SyncHashTileSize; ty <= (Rect.y + Rect.Hgt - 1) / C4LS_SyncHashTileSize; ty++)
+		for (int32_t tx = Rect.x / C4LS_SyncHashTileSize; tx <= (Rect.x + Rect.Wdt - 1) / C4LS_SyncHashTileSize; tx++)
+			FreeTileStamps[ty * SyncTileCols + tx] = FreeChangeStamp;
+}
+
+bool C4Landscape::FreeChangedSince(C4Rect Rect, uint64_t iStamp) const
+{
+	// no landscape or not tracked yet
+	if (FreeTileStamps.empty()) return true;
+	// pixels outside the landscape never change
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (!Rect.Wdt || !Rect.Hgt) return false;
+	for (int32_t ty = Rect.y / C4LS_SyncHashTileSize; ty <= (Rect.y + Rect.Hgt - 1) / C4LS_SyncHashTileSize; ty++)
+		for (int32_t tx = Rect.x / C4LS_SyncHashTileSize; tx <= (Rect.x + Rect.Wdt - 1) / C4LS_SyncHashTileSize; tx++)
+			if (FreeTileStamps[ty * SyncTileCols + tx] > iStamp)
+				return true;
+	return false;
+}
+
+void C4Landscape::UpdateSyncHashes(C4Rect Rect)
+{
+	if (SyncTileHashes.empty()) return;
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (!Rect.Wdt || !Rect.Hgt) return;
+	for (int32_t ty = Rect.y / C4LS_SyncHashTileSize; ty <= (Rect.y + Rect.Hgt - 1) / C4LS_SyncHashTileSize; ty++)
+		for (int32_t tx = Rect.x / C4LS_SyncHashTileSize; tx <= (Rect.x + Rect.Wdt - 1) / C4LS_SyncHashTileSize; tx++)
+		{
+			uint32_t iTileHash = 0;
+			for (int32_t y = ty * C4LS_SyncHashTileSize; y < std::min<int32_t>((ty + 1) * C4LS_SyncHashTileSize, Height); y++)
+				for (int32_t x = tx * C4LS_SyncHashTileSize; x < std::min<int32_t>((tx + 1) * C4LS_SyncHashTileSize, Width); x++)
+					iTileHash += GetPixSyncHash(x, y, _GetPix(x, y));
+			uint32_t &rTileHash = SyncTileHashes[ty * SyncTileCols + tx];
+			SyncHash += iTileHash - rTileHash;
+			rTileHash = iTileHash;
+		}
+}
+
 void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 {
 	int32_t PixCntWidth = (Width + 16) / 17;
@@ -21,10 +21,13 @@
 #include "C4Id.h"
 #include "C4Sky.h"
 #include "C4Shape.h"
+#include "C4SyncHash.h"
 
 #include <StdSurface8.h>
 
 #include <cstdint>
+#include <functional>
+#include <vector>
 
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
@@ -41,6 +44,7 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Exact = 3;
 
 const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_SyncHashTileSize = 64; // edge length of the landscape tiles hashed for sync checks
 
 class C4MapCreatorS2;
 class C4Object;
@@ -71,6 +75,7 @@ public:
 	C4MapCreatorS2 *pMapCreator; // map creator for script-generated maps
 	bool fMapChanged;
 	uint8_t *pInitial; // Initial landscape after creation - used for diff
+	static inline bool SerialZoom{false}; // zoom map segments on the calling thread only, even if they are large enough to be split into bands
 
 protected:
 	C4Surface *Surface32;
@@ -80,6 +85,13 @@ protected:
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
 	C4Rect Relights[C4LS_MaxRelights];
+	std::vector<bool> ScanColumnDirty; // NoSave // columns that have to be revisited by ExecuteScan
+	int32_t ScanTemperature; // NoSave // temperature ScanColumnDirty is valid for
+	std::vector<uint32_t> SyncTileHashes; // NoSave // pixel hash sums per C4LS_SyncHashTileSize tile, updated by _SetPix
+	int32_t SyncTileCols; // NoSave //
+	uint32_t SyncHash; // NoSave // sum of all SyncTileHashes
+	std::vector<uint64_t> FreeTileStamps; // NoSave // FreeChangeStamp of the last change between free and solid per sync hash tile
+	uint64_t FreeChangeStamp{0}; // NoSave // increased with every such change; never reset, so older stamps stay comparable
 
 public:
 	void Default();
@@ -130,6 +142,9 @@ public:
 	bool DrawChunks(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t icntx, int32_t icnty, const char *szMaterial, const char *szTexture, bool bIFT);
 	bool DrawQuad(int32_t iX1, int32_t iY1, int32_t iX2, int32_t iY2, int32_t iX3, int32_t iY3, int32_t iX4, int32_t iY4, const char *szMaterial, bool bIFT);
 	CStdPalette *GetPal() const { return Surface8 ? Surface8->pPal : nullptr; }
+	uint32_t GetSyncHash() const { return SyncHash; }
+	const std::vector<uint32_t> &GetSyncTileHashes() const { return SyncTileHashes; } // row-major, GetSyncTileCols() tiles per row
+	int32_t GetSyncTileCols() const { return SyncTileCols; }
 
 	inline uint8_t _GetPix(int32_t x, int32_t y) // get landscape pixel (bounds not checked)
 	{
@@ -219,6 +234,8 @@ public:
 	bool ReplaceMapColor(uint8_t iOldIndex, uint8_t iNewIndex); // find every occurance of iOldIndex in map; replace it by new index
 	bool SetTextureIndex(const char *szMatTex, uint8_t iNewIndex, bool fInsert); // change color index of map texture, or insert a new one
 	void SetMapChanged() { fMapChanged = true; }
+	uint64_t GetFreeChangeStamp() const { return FreeChangeStamp; }
+	bool FreeChangedSince(C4Rect Rect, uint64_t iStamp) const; // whether any pixel in Rect might have changed between free and solid after GetFreeChangeStamp returned iStamp
 	void HandleTexMapUpdate();
 	void UpdatePixMaps();
 	bool DoRelights();
@@ -227,10 +244,23 @@ public:
 protected:
 	void ExecuteScan();
 	int32_t DoScan(int32_t x, int32_t y, int32_t mat, int32_t dir);
+	int32_t GetTempConvertTex(int32_t mat, int32_t dir, int32_t iTemperature); // texture mat converts to at the given temperature and scan direction; 0 if none
+	bool TempConversionsChanged(int32_t iOldTemperature, int32_t iNewTemperature);
+	void SetScanDirty(int32_t x, int32_t wdt);
+	void InitSyncHashes();
+	void UpdateSyncHashes(C4Rect Rect); // recalculate the hashes of all tiles touching Rect after bulk surface changes
+	void SetFreeChanged(C4Rect Rect); // mark all tiles touching Rect as possibly changed between free and solid
+
+	static uint32_t GetPixSyncHash(int32_t x, int32_t y, uint8_t pix)
+	{
+		// sky does not contribute, so empty tiles hash to zero
+		return pix ? C4SyncHashMix((uint64_t{static_cast<uint32_t>(y)} << 40) | (uint64_t{static_cast<uint32_t>(x)} << 8) | pix) : 0;
+	}
 	int32_t ChunkyRandom(int32_t &iOffset, int32_t iRange); // return static random value, according to offset and MapSeed
-	void DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro);
-	void DrawSmoothOChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro);
-	void ChunkOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iOffX = 0, int32_t iOffY = 0);
+	void DrawChunk(CSurface8 &sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro);
+	void DrawSmoothOChunk(CSurface8 &sfcTarget, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, uint8_t flip, int32_t cro);
+	void ChunkOZoom(CSurface8 &sfcTarget, CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iTexture, int32_t iChunkType, int32_t iOffX = 0, int32_t iOffY = 0);
+	static void ZoomInBands(CSurface8 &sfcTarget, const std::function<void(CSurface8 &)> &zoom, int32_t iBandCount); // zoom the clipped rows of sfcTarget split into iBandCount concurrently drawn bands
 	bool GetTexUsage(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage);
 	bool TexOZoom(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, uint32_t *dwpTextureUsage, int32_t iToX = 0, int32_t iToY = 0);
 	bool MapToSurface(CSurface8 *sfcMap, int32_t iMapX, int32_t iMapY, int32_t iMapWdt, int32_t iMapHgt, int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY);
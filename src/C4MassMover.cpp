@@ -19,6 +19,7 @@
 #include <C4MassMover.h>
 
 #include <C4Random.h>
+#include <C4SyncHash.h>
 #include <C4Material.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
@@ -250,6 +251,15 @@ void C4MassMoverSet::Synchronize()
 	Consolidate();
 }
 
+uint32_t C4MassMoverSet::GetSyncHash() const
+{
+	uint32_t hash = 0;
+	for (const auto &massMover : Set)
+		if (massMover.Mat != MNone)
+			hash += C4SyncHashOf(massMover.Mat, massMover.x, massMover.y);
+	return hash;
+}
+
 void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 {
 	Clear();
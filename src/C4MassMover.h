@@ -56,6 +56,7 @@ protected:
 public:
 	void Copy(C4MassMoverSet &rSet);
 	void Synchronize();
+	uint32_t GetSyncHash() const; // order-independent hash of all mass movers for sync checks
 	void Default();
 	void Clear();
 	void Execute();
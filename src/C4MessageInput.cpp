@@ -451,6 +451,7 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogNTr("/observer [client] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTHESPECIFIEDCLIENTTOOB));
 		LogNTr("/fast [x] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTOFASTMODESKIPPINGXFRA));
 		LogNTr("/slow - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETTONORMALSPEEDMODE));
+		LogNTr("/seek [frame] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SEEKREPLAY));
 		LogNTr("/chart - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_DISPLAYNETWORKSTATISTICS));
 		LogNTr("/nodebug - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_PREVENTDEBUGMODEINTHISROU));
 		LogNTr("/set comment [comment] - {}", LoadResStr(C4ResStrTableKey::IDS_TEXT_SETANEWNETWORKCOMMENT));
@@ -608,6 +609,15 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		return true;
 	}
 
+	// jump to replay frame
+	if (SEqual(szCmdName, "seek"))
+	{
+		if (!Game.IsRunning) return false;
+		if (!Game.Control.isReplay()) return false;
+		if (!*pCmdPar) return false;
+		return Game.Control.SeekReplay(atoi(pCmdPar));
+	}
+
 	if (SEqual(szCmdName, "nodebug"))
 	{
 		if (!Game.IsRunning) return false;
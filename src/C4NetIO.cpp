@@ -25,6 +25,8 @@
 #include <assert.h>
 #include <errno.h>
 #include <fcntl.h>
+#include <algorithm>
+#include <array>
 #include <format>
 #include <sys/stat.h>
 
@@ -497,6 +499,7 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 		SetError("could not create pipe", true);
 		return false;
 	}
+	FDsChanged();
 #endif
 
 	// create listen socket (if necessary)
@@ -555,6 +558,7 @@ bool C4NetIOTCP::Close()
 	close(Pipe[0]);
 	close(Pipe[1]);
 #endif
+	FDsChanged();
 
 	// ok
 	fInit = false;
@@ -656,6 +660,7 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 			{
 				// remove from list
 				SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
+				FDsChanged();
 
 #ifdef _WIN32
 				// error?
@@ -758,8 +763,14 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 			// socket has become writeable?
 			if (it != std::ranges::end(fds) && it->revents & POLLOUT)
 #endif
+			{
 				// send remaining data
 				pPeer->Send();
+#ifndef _WIN32
+				// no need to wait for writeability anymore?
+				if (!pPeer->hasWaitingData()) FDsChanged();
+#endif
+			}
 
 #ifdef _WIN32
 			// socket was closed?
@@ -901,6 +912,7 @@ bool C4NetIOTCP::Close(const addr_t &addr) // (mt-safe)
 	{
 		// close socket, do callback
 		closesocket(pWait->sock); pWait->sock = INVALID_SOCKET;
+		FDsChanged();
 		if (pCB) pCB->OnDisconn(pWait->addr, this, "closed");
 	}
 	else
@@ -1008,10 +1020,12 @@ void C4NetIOTCP::GetFDs(std::vector<pollfd> &fds)
 
 #endif
 
-bool C4NetIOTCP::GetStatistic(int *pBroadcastRate) // (mt-safe)
+bool C4NetIOTCP::GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat) // (mt-safe)
 {
 	// no broadcast
 	if (pBroadcastRate) *pBroadcastRate = 0;
+	// stream sockets aren't batched
+	if (pBatchStat) *pBatchStat = {};
 	return true;
 }
 
@@ -1117,6 +1131,7 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// add to list
 	pnPeer->Next = pPeerList;
 	pPeerList = pnPeer;
+	FDsChanged();
 
 	// clear add-lock
 	PeerListAddLock.Clear();
@@ -1138,6 +1153,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		// close existing socket
 		closesocket(lsock);
 		lsock = INVALID_SOCKET;
+		FDsChanged();
 	}
 	iListenPort = addr_t::IPPORT_NONE;
 
@@ -1147,6 +1163,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		SetError("socket creation failed", true);
 		return false;
 	}
+	FDsChanged();
 
 	if (!InitIPv6Socket(lsock))
 		return false;
@@ -1162,6 +1179,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	{
 		SetError("socket bind failed", true);
 		closesocket(lsock); lsock = INVALID_SOCKET;
+		FDsChanged();
 		return false;
 	}
 
@@ -1171,6 +1189,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	{
 		SetError("could not set event for listen socket", true);
 		closesocket(lsock); lsock = INVALID_SOCKET;
+		FDsChanged();
 		return false;
 	}
 #endif
@@ -1180,6 +1199,7 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 	{
 		SetError("socket listen failed", true);
 		closesocket(lsock); lsock = INVALID_SOCKET;
+		FDsChanged();
 		return false;
 	}
 
@@ -1255,6 +1275,7 @@ void C4NetIOTCP::AddConnectWait(SOCKET sock, const addr_t &addr) // (mt-safe)
 	pnWait->sock = sock; pnWait->addr = addr;
 	pnWait->Next = pConnectWaits;
 	pConnectWaits = pnWait;
+	FDsChanged();
 #ifndef _WIN32
 	// unblock, so new FD can be realized
 	UnBlock();
@@ -1279,6 +1300,7 @@ void C4NetIOTCP::ClearConnectWaits() // (mt-safe)
 		{
 			closesocket(pWait->sock);
 			pWait->sock = INVALID_SOCKET;
+			FDsChanged();
 		}
 }
 
@@ -1346,6 +1368,7 @@ C4NetIOTCP::Peer::~Peer()
 bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	CStdLock OLock(&OCSec);
+	const bool fWaiting{hasWaitingData()};
 
 	// already data pending to be sent? try to sent them first (empty buffer)
 	if (!OBuf.isNull()) Send();
@@ -1355,7 +1378,11 @@ bool C4NetIOTCP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	pParent->PackPacket(rPacket, OBuf);
 
 	// (try to) send
-	return fSend ? Send() : true;
+	const bool fSuccess{fSend ? Send() : true};
+
+	// the socket is only polled for writeability while data is waiting
+	if (hasWaitingData() != fWaiting) pParent->FDsChanged();
+	return fSuccess;
 }
 
 bool C4NetIOTCP::Peer::Send() // (mt-safe)
@@ -1463,6 +1490,7 @@ void C4NetIOTCP::Peer::Close() // (mt-safe)
 	// close socket
 	closesocket(sock);
 	sock = INVALID_SOCKET;
+	pParent->FDsChanged();
 	// set flag
 	fOpen = false;
 	// clear buffers
@@ -1516,6 +1544,7 @@ bool C4NetIOSimpleUDP::Init(uint16_t inPort)
 		SetError("could not create socket", true);
 		return false;
 	}
+	FDsChanged();
 
 	if (!InitIPv6Socket(sock))
 	{
@@ -1570,6 +1599,7 @@ bool C4NetIOSimpleUDP::Init(uint16_t inPort)
 		SetError("could not create pipe", true);
 		return false;
 	}
+	FDsChanged();
 
 #endif
 
@@ -1670,6 +1700,7 @@ bool C4NetIOSimpleUDP::Close()
 	close(Pipe[0]);
 	close(Pipe[1]);
 #endif
+	FDsChanged();
 
 	// ok
 	fInit = false;
@@ -1707,6 +1738,13 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	if (eWR == WR_Cancelled || eWR == WR_Timeout) return true;
 	assert(eWR == WR_Readable);
 
+#ifdef __linux__
+	// read multiple packets per system call
+	if (fBatchIO.load(std::memory_order_relaxed))
+		if (const auto result = ReceiveBatched())
+			return *result;
+#endif
+
 	// read packets from socket
 	for (;;)
 	{
@@ -1731,6 +1769,7 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 		// read data (note: it is _not_ garantueed that iMaxMsgSize bytes are available)
 		addr_t SrcAddr; socklen_t iSrcAddrLen{sizeof(sockaddr_in6)};
 		int iMsgSize = ::recvfrom(sock, Pkt.getMPtr<char>(), iMaxMsgSize, 0, &SrcAddr, &iSrcAddrLen);
+		iRecvCalls++;
 		// error?
 		if (iMsgSize == SOCKET_ERROR)
 		{
@@ -1762,6 +1801,7 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 		// fill in packet information
 		Pkt.SetSize(iMsgSize);
 		Pkt.SetAddr(SrcAddr);
+		iRecvPackets++;
 		// callback
 		if (pCB) pCB->OnPacket(Pkt, this);
 	}
@@ -1770,12 +1810,87 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	return true;
 }
 
+#ifdef __linux__
+
+std::optional<bool> C4NetIOSimpleUDP::ReceiveBatched()
+{
+	// one buffer per datagram, large enough that nothing gets truncated
+	if (RecvBuffer.isNull()) RecvBuffer.New(iBatchSize * iMaxDatagramSize);
+
+	std::array<mmsghdr, iBatchSize> msgs;
+	std::array<iovec, iBatchSize> iovecs;
+	std::array<addr_t, iBatchSize> addrs;
+
+	for (;;)
+	{
+		for (unsigned int i = 0; i < iBatchSize; i++)
+		{
+			iovecs[i] = {.iov_base = RecvBuffer.getMPtr(i * iMaxDatagramSize), .iov_len = iMaxDatagramSize};
+			msgs[i] = {};
+			msgs[i].msg_hdr.msg_name = static_cast<sockaddr *>(&addrs[i]);
+			msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in6);
+			msgs[i].msg_hdr.msg_iov = &iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		// read everything that is waiting, without blocking
+		const int iCnt = ::recvmmsg(sock, msgs.data(), iBatchSize, MSG_DONTWAIT, nullptr);
+		if (iCnt == SOCKET_ERROR)
+		{
+			// nothing left
+			if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+			// use recvfrom instead
+			if (errno == ENOSYS)
+			{
+				fBatchIO.store(false, std::memory_order_relaxed);
+				return std::nullopt;
+			}
+			if (HaveConnResetError())
+			{
+				// this is actually some kind of notification: an ICMP msg (unreachable)
+				// came back, so callback and continue reading
+				if (pCB) pCB->OnDisconn(addrs[0], this, GetSocketErrorMsg());
+				continue;
+			}
+			SetError("could not receive data from socket", true);
+			return false;
+		}
+		iRecvCalls++;
+		iRecvPackets += iCnt;
+
+		for (int i = 0; i < iCnt; i++)
+		{
+			const msghdr &hdr = msgs[i].msg_hdr;
+			// invalid address?
+			if ((hdr.msg_namelen != sizeof(sockaddr_in) && hdr.msg_namelen != sizeof(sockaddr_in6)) || addrs[i].GetFamily() == addr_t::UnknownFamily)
+			{
+				SetError("recvmmsg returned an invalid address");
+				return false;
+			}
+			// empty datagram: nothing to deliver, but the rest of the batch is still valid
+			if (!msgs[i].msg_len)
+				continue;
+			// callback
+			if (pCB) pCB->OnPacket(C4NetIOPacket(RecvBuffer.getPtr(i * iMaxDatagramSize), msgs[i].msg_len, true, addrs[i]), this);
+		}
+
+		// socket drained?
+		if (static_cast<unsigned int>(iCnt) < iBatchSize) break;
+	}
+
+	// ok
+	return true;
+}
+
+#endif
+
 bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 {
 	if (!fInit) { SetError("not yet initialized"); return false; }
 
 	// send it
 	C4NetIO::addr_t addr = rPacket.getAddr();
+	iSendCalls++;
 	if (::sendto(sock, rPacket.getPtr<char>(), rPacket.getSize(), 0,
 		&addr, addr.GetAddrLen())
 		!= int(rPacket.getSize()) &&
@@ -1784,18 +1899,112 @@ bool C4NetIOSimpleUDP::Send(const C4NetIOPacket &rPacket)
 		SetError("socket sendto failed", true);
 		return false;
 	}
+	iSendPackets++;
 
 	// ok
 	ResetError();
 	return true;
 }
 
+bool C4NetIOSimpleUDP::SendBatch(std::span<const C4NetIOPacket> packets)
+{
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+	bool fSuccess = true;
+
+#ifdef __linux__
+	if (fBatchIO.load(std::memory_order_relaxed))
+	{
+		std::array<mmsghdr, iBatchSize> msgs;
+		std::array<iovec, iBatchSize> iovecs;
+		std::array<addr_t, iBatchSize> addrs;
+
+		std::size_t iOffset = 0;
+		while (iOffset < packets.size())
+		{
+			const auto iCnt = static_cast<unsigned int>(std::min<std::size_t>(packets.size() - iOffset, iBatchSize));
+			for (unsigned int i = 0; i < iCnt; i++)
+			{
+				const C4NetIOPacket &rPacket = packets[iOffset + i];
+				addrs[i] = rPacket.getAddr();
+				iovecs[i] = {.iov_base = const_cast<void *>(rPacket.getData()), .iov_len = rPacket.getSize()};
+				msgs[i] = {};
+				msgs[i].msg_hdr.msg_name = static_cast<sockaddr *>(&addrs[i]);
+				msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(addrs[i].GetAddrLen());
+				msgs[i].msg_hdr.msg_iov = &iovecs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			}
+
+			const int iSent = ::sendmmsg(sock, msgs.data(), iCnt, 0);
+			if (iSent == SOCKET_ERROR)
+			{
+				// send the rest one by one
+				if (errno == ENOSYS)
+				{
+					fBatchIO.store(false, std::memory_order_relaxed);
+					break;
+				}
+				// the first datagram failed: skip it and go on with the rest, just like sending one by one
+				// (a full send buffer isn't an error, the datagram is just dropped)
+				if (!HaveWouldBlockError())
+				{
+					SetError("socket sendmmsg failed", true);
+					fSuccess = false;
+				}
+				iSendCalls++;
+				iOffset++;
+				continue;
+			}
+			iSendCalls++;
+			iSendPackets += iSent;
+			iOffset += iSent;
+		}
+
+		if (iOffset == packets.size())
+		{
+			if (fSuccess) ResetError();
+			return fSuccess;
+		}
+		packets = packets.subspan(iOffset);
+	}
+#endif
+
+	for (const C4NetIOPacket &rPacket : packets)
+		fSuccess &= C4NetIOSimpleUDP::Send(rPacket);
+	return fSuccess;
+}
+
 bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 {
 	// just set broadcast address and send
 	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), MCAddr));
 }
 
+bool C4NetIOSimpleUDP::GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat) // (mt-safe)
+{
+	if (pBroadcastRate) *pBroadcastRate = 0;
+	if (pBatchStat) GetBatchStatistic(*pBatchStat);
+	return true;
+}
+
+void C4NetIOSimpleUDP::ClearStatistic()
+{
+	ClearBatchStatistic();
+}
+
+void C4NetIOSimpleUDP::GetBatchStatistic(BatchStatistic &stat) const
+{
+	stat.RecvPackets = iRecvPackets.load(std::memory_order_relaxed);
+	stat.RecvCalls = iRecvCalls.load(std::memory_order_relaxed);
+	stat.SendPackets = iSendPackets.load(std::memory_order_relaxed);
+	stat.SendCalls = iSendCalls.load(std::memory_order_relaxed);
+}
+
+void C4NetIOSimpleUDP::ClearBatchStatistic()
+{
+	iRecvPackets = iRecvCalls = iSendPackets = iSendCalls = 0;
+}
+
 #ifdef _WIN32
 
 void C4NetIOSimpleUDP::UnBlock() // (mt-safe)
@@ -2399,10 +2608,11 @@ int C4NetIOUDP::GetTimeout() // (mt-safe)
 	return iTiming;
 }
 
-bool C4NetIOUDP::GetStatistic(int *pBroadcastRate) // (mt-safe)
+bool C4NetIOUDP::GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat) // (mt-safe)
 {
 	CStdLock StatLock(&StatCSec);
 	if (pBroadcastRate) *pBroadcastRate = iBroadcastRate;
+	if (pBatchStat) GetBatchStatistic(*pBatchStat);
 	return true;
 }
 
@@ -2428,6 +2638,7 @@ void C4NetIOUDP::ClearStatistic()
 	// broadcast statistics
 	CStdLock StatLock(&StatCSec);
 	iBroadcastRate = 0;
+	ClearBatchStatistic();
 }
 
 void C4NetIOUDP::OnPacket(const C4NetIOPacket &Packet, C4NetIO *pNetIO)
@@ -3127,22 +3338,28 @@ bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
 	// send one fragment only?
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
-	// otherwise: send all fragments
-	bool fSuccess = true;
+	// otherwise: send all fragments together
+	std::vector<C4NetIOPacket> fragments;
+	fragments.reserve(rPacket.FragmentCnt());
 	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
-		fSuccess &= SendDirect(rPacket.GetFragment(i));
-	return fSuccess;
+		fragments.emplace_back(PrepareDirect(rPacket.GetFragment(i)));
+	return pParent->SendDirect(std::move(fragments));
 }
 
 bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
+{
+	// forward call
+	return pParent->SendDirect(PrepareDirect(std::move(rPacket)));
+}
+
+C4NetIOPacket C4NetIOUDP::Peer::PrepareDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 {
 	// insert correct addr
 	const C4NetIO::addr_t v6Addr{addr.AsIPv6()};
 	if (!(rPacket.getStatus() & 0x80)) rPacket.SetAddr(v6Addr);
 	// count outgoing
 	{ CStdLock StatLock(&StatCSec); iORate += rPacket.getSize() + iUDPHeaderSize; }
-	// forward call
-	return pParent->SendDirect(std::move(rPacket));
+	return std::move(rPacket);
 }
 
 void C4NetIOUDP::Peer::OnConn()
@@ -3252,14 +3469,34 @@ bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt
 	// only one fragment?
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
-	// send all fragments
-	bool fSuccess = true;
+	// send all fragments together
+	std::vector<C4NetIOPacket> fragments;
+	fragments.reserve(rPacket.FragmentCnt());
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
-		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
-	return fSuccess;
+		fragments.emplace_back(rPacket.GetFragment(iFrgm, true));
+	return SendDirect(std::move(fragments));
 }
 
 bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
+{
+	// send it
+	if (const auto packet = PrepareDirect(rPacket))
+		return C4NetIOSimpleUDP::Send(*packet);
+	return true;
+}
+
+bool C4NetIOUDP::SendDirect(std::vector<C4NetIOPacket> &&packets) // (mt-safe)
+{
+	std::vector<C4NetIOPacket> toSend;
+	toSend.reserve(packets.size());
+	for (const C4NetIOPacket &rPacket : packets)
+		if (auto packet = PrepareDirect(rPacket))
+			toSend.emplace_back(std::move(*packet));
+	// send them with as few system calls as possible
+	return C4NetIOSimpleUDP::SendBatch(toSend);
+}
+
+std::optional<C4NetIOPacket> C4NetIOUDP::PrepareDirect(const C4NetIOPacket &rPacket) // (mt-safe)
 {
 	addr_t toaddr = rPacket.getAddr();
 	// packet meant to be broadcasted?
@@ -3279,11 +3516,10 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 
 #ifdef C4NETIO_SIMULATE_PACKETLOSS
 	if ((rPacket.getStatus() & 0x7F) != IPID_Test)
-		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return true;
+		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return std::nullopt;
 #endif
 
-	// send it
-	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
+	return C4NetIOPacket(rPacket.getRef(), toaddr);
 }
 
 bool C4NetIOUDP::DoLoopbackTest()
@@ -26,7 +26,10 @@
 #include "StdCompiler.h"
 #include "StdScheduler.h"
 
+#include <atomic>
 #include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 
@@ -103,7 +106,13 @@ public:
 	virtual bool Broadcast(const class C4NetIOPacket &rPacket) = 0;
 
 	// statistics
-	virtual bool GetStatistic(int *pBroadcastRate) = 0;
+	// datagrams moved and system calls needed for them since the last ClearStatistic
+	struct BatchStatistic
+	{
+		int RecvPackets{0}, RecvCalls{0};
+		int SendPackets{0}, SendCalls{0};
+	};
+	virtual bool GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat = nullptr) = 0;
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) = 0;
 	virtual void ClearStatistic() = 0;
 
@@ -207,7 +216,7 @@ public:
 #endif
 
 	// statistics
-	virtual bool GetStatistic(int *pBroadcastRate) override;
+	virtual bool GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat = nullptr) override;
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) override;
 	virtual void ClearStatistic() override;
 
@@ -359,6 +368,7 @@ public:
 	virtual bool Execute(int iMaxTime = StdSync::Infinite) override;
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
+	bool SendBatch(std::span<const C4NetIOPacket> packets); // like Send for each packet, but with as few system calls as possible
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 
 	virtual void UnBlock();
@@ -374,14 +384,14 @@ public:
 
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override { assert(false); return false; }
 
-	virtual bool GetStatistic(int *pBroadcastRate) override { assert(false); return false; }
+	virtual bool GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat = nullptr) override;
 
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) override
 	{
 		assert(false); return false;
 	}
 
-	virtual void ClearStatistic() override { assert(false); }
+	virtual void ClearStatistic() override;
 
 private:
 	// status
@@ -404,6 +414,15 @@ private:
 	// multibind
 	int fAllowReUse;
 
+	// batched socket i/o (recvmmsg / sendmmsg)
+#ifdef __linux__
+	static constexpr unsigned int iBatchSize = 16; // datagrams per system call
+	static constexpr unsigned int iMaxDatagramSize = 65536; // (bytes)
+	std::atomic_bool fBatchIO{true}; // false if the kernel doesn't support it
+	StdBuf RecvBuffer;
+#endif
+	std::atomic_int iRecvPackets{0}, iRecvCalls{0}, iSendPackets{0}, iSendCalls{0};
+
 protected:
 	// multicast address
 	const addr_t &getMCAddr() const { return MCAddr; }
@@ -415,11 +434,25 @@ protected:
 	// enable multi-bind (call before Init!)
 	void SetReUseAddress(bool fAllow);
 
+	// batch statistics of the socket (mt-safe)
+	void GetBatchStatistic(BatchStatistic &stat) const;
+	void ClearBatchStatistic();
+
+#ifdef __linux__
+	// use recvfrom / sendto even if recvmmsg / sendmmsg are supported
+	void SetBatchIO(bool fEnable) { fBatchIO.store(fEnable, std::memory_order_relaxed); }
+#endif
+
 private:
 	// socket wait (check for readability)
 	enum WaitResult { WR_Timeout, WR_Readable, WR_Cancelled, WR_Error = -1, };
 	WaitResult WaitForSocket(int iTimeout);
 
+#ifdef __linux__
+	// reads all waiting datagrams with recvmmsg; nullopt if not supported
+	std::optional<bool> ReceiveBatched();
+#endif
+
 	// *** callbacks
 public:
 	virtual void SetCallback(CBClass *pnCallback) override { pCB = pnCallback; }
@@ -453,12 +486,13 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	bool SendDirect(C4NetIOPacket &&packet); // (mt-safe)
+	bool SendDirect(std::vector<C4NetIOPacket> &&packets); // (mt-safe)
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override;
 
 	virtual int GetTimeout() override;
 
-	virtual bool GetStatistic(int *pBroadcastRate) override;
+	virtual bool GetStatistic(int *pBroadcastRate, BatchStatistic *pBatchStat = nullptr) override;
 	virtual bool GetConnStatistic(const addr_t &addr, int *pIRate, int *pORate, int *pLoss) override;
 	virtual void ClearStatistic() override;
 
@@ -682,6 +716,7 @@ protected:
 		// sending
 		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0);
 		bool SendDirect(C4NetIOPacket &&rPacket);
+		C4NetIOPacket PrepareDirect(C4NetIOPacket &&rPacket);
 
 		// events
 		void OnConn();
@@ -740,6 +775,7 @@ protected:
 
 	// sending
 	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u); // (mt-safe)
+	std::optional<C4NetIOPacket> PrepareDirect(const C4NetIOPacket &rPacket); // (mt-safe) nullopt: drop packet
 
 	// multicast related
 	bool DoLoopbackTest();
@@ -1179,6 +1179,14 @@ void C4Network2::DrawStatus(C4FacetEx &cgo)
 	else
 		stat += "|Protocols: none";
 
+	// datagrams per system call
+	if (NetIO.hasUDP())
+	{
+		const C4NetIO::BatchStatistic &batchStat = NetIO.getUDPBatchStat();
+		stat += std::format("|UDP batching: recv {} packets in {} calls, send {} packets in {} calls",
+			batchStat.RecvPackets, batchStat.RecvCalls, batchStat.SendPackets, batchStat.SendCalls);
+	}
+
 	// some control statistics
 	stat += std::format("|Control: {}, Tick {}, Behind {}, Rate {}, PreSend {}, ACT: {}",
 		Status.getCtrlMode() == CNM_Decentral ? "Decentral" : Status.getCtrlMode() == CNM_Central ? "Central" : "Async",
@@ -99,6 +99,7 @@ bool C4Network2IO::Init(const std::uint16_t iPortTCP, const std::uint16_t iPortU
 	iLastPing = iLastStatistic = timeGetTime();
 	iTCPIRate = iTCPORate = iTCPBCRate = 0;
 	iUDPIRate = iUDPORate = iUDPBCRate = 0;
+	UDPBatchStat = {};
 
 	// init event callback
 	C4InteractiveThread &Thread = Application.InteractiveThread;
@@ -1202,8 +1203,9 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 
 	// get broadcast statistics
 	int inTCPBCRate = 0, inUDPBCRate = 0;
+	C4NetIO::BatchStatistic nUDPBatchStat;
 	if (pNetIO_TCP) pNetIO_TCP->GetStatistic(&inTCPBCRate);
-	if (pNetIO_UDP) pNetIO_UDP->GetStatistic(&inUDPBCRate);
+	if (pNetIO_UDP) pNetIO_UDP->GetStatistic(&inUDPBCRate, &nUDPBatchStat);
 
 	// normalize everything
 	iTCPIRateSum = iTCPIRateSum * 1000 / iInterval;
@@ -1220,6 +1222,7 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 	// save back
 	iTCPIRate = iTCPIRateSum; iTCPORate = iTCPORateSum; iTCPBCRate = inTCPBCRate;
 	iUDPIRate = iUDPIRateSum; iUDPORate = iUDPORateSum; iUDPBCRate = inUDPBCRate;
+	UDPBatchStat = nUDPBatchStat;
 }
 
 void C4Network2IO::SendConnPackets()
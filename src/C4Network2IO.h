@@ -95,6 +95,7 @@ protected:
 	unsigned long iLastStatistic;
 	int iTCPIRate, iTCPORate, iTCPBCRate,
 		iUDPIRate, iUDPORate, iUDPBCRate;
+	C4NetIO::BatchStatistic UDPBatchStat;
 
 	// punching
 	C4NetIO::addr_t PuncherAddrIPv4, PuncherAddrIPv6;
@@ -152,6 +153,7 @@ public:
 	int getProtIRate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPIRate  : iUDPIRate; }
 	int getProtORate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPORate  : iUDPORate; }
 	int getProtBCRate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPBCRate : iUDPBCRate; }
+	const C4NetIO::BatchStatistic &getUDPBatchStat() const { return UDPBatchStat; }
 
 	// reference
 	void SetReference(class C4Network2Reference *pReference);
@@ -240,6 +240,7 @@ public:
 	virtual HANDLE GetEvent() = 0;
 #else
 	virtual void GetFDs(std::vector<pollfd> &fds) = 0;
+	virtual std::uint32_t GetFDsRevision() const = 0;
 #endif
 
 	virtual void SetError(std::string_view error) = 0;
@@ -279,6 +280,7 @@ public:
 	HANDLE GetEvent() override { return nullptr; }
 #else
 	void GetFDs(std::vector<pollfd> &fds) override {}
+	std::uint32_t GetFDsRevision() const override { return 0; }
 #endif
 
 protected:
@@ -390,6 +392,7 @@ public:
 	HANDLE GetEvent() override { return C4NetIOTCP::GetEvent(); }
 #else
 	void GetFDs(std::vector<pollfd> &fds) override { C4NetIOTCP::GetFDs(fds); }
+	std::uint32_t GetFDsRevision() const override { return C4NetIOTCP::GetFDsRevision(); }
 #endif
 
 protected:
@@ -449,6 +452,7 @@ int C4Network2HTTPClient::GetTimeout() { return impl->GetTimeout(); }
 HANDLE C4Network2HTTPClient::GetEvent() { return impl->GetEvent(); }
 #else
 void C4Network2HTTPClient::GetFDs(std::vector<pollfd> &fds) { impl->GetFDs(fds); }
+std::uint32_t C4Network2HTTPClient::GetFDsRevision() const { return impl->GetFDsRevision(); }
 #endif
 
 void C4Network2HTTPClient::SetError(const char *const error) { impl->SetError(error); }
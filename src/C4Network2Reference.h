@@ -158,6 +158,7 @@ public:
 	HANDLE GetEvent() override;
 #else
 	void GetFDs(std::vector<pollfd> &fds) override;
+	std::uint32_t GetFDsRevision() const override;
 #endif
 
 protected:
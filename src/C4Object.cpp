@@ -1072,9 +1072,7 @@ void C4Object::Execute()
 	// Movement
 	ExecMovement();
 	if (!Status) return;
-	// particles
-	if (BackParticles) BackParticles.Exec(this);
-	if (FrontParticles) FrontParticles.Exec(this);
+	// particles are executed for all objects at once by C4Game::ExecObjectParticles
 	// effects
 	if (pEffects)
 	{
@@ -1553,14 +1551,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (Call(PSF_RejectEntrance, {C4VObj(pTarget)})) return false;
+	if (Call(PSC_RejectEntrance, {C4VObj(pTarget)})) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(PSC_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1808,7 +1806,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(PSC_Stuck);
 		}
 
 	return true;
@@ -1838,7 +1836,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(PSC_Stuck);
 		}
 	return true;
 }
@@ -1884,7 +1882,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified: use own container as target
 		if (!pTarget) if (!(pTarget = Contained)) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(PSC_RejectContents)) return false;
 		// Create symbol
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -1927,7 +1925,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified
 		if (!pTarget) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(PSC_RejectContents)) return false;
 		// Create symbol & init
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -2215,6 +2213,12 @@ C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, boo
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError, convertNilToIntBool);
 }
 
+C4Value C4Object::Call(const C4ScriptCallback &callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	if (!Status || !Def) return C4VNull;
+	return Def->Script.ObjectCall(this, this, callback, pPars, fPassError, convertNilToIntBool);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -3840,6 +3844,8 @@ void C4Object::SyncClearance()
 	SetOCF();
 	// Menu
 	CloseMenu(true);
+	// Unfinished path searches are not synchronized
+	for (C4Command *pCom = Command; pCom; pCom = pCom->Next) pCom->ClearPathSearch();
 	// Material contents
 	MaterialContents.fill(0);
 	// reset speed of staticback-objects
@@ -5721,9 +5727,9 @@ bool C4Object::Collect(C4Object *pObj)
 	// Container Collection call
 	Call(PSF_Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSC_Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSC_Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSC_Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
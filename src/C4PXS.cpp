@@ -20,6 +20,7 @@
 
 #include <C4Physics.h>
 #include <C4Random.h>
+#include <C4SyncHash.h>
 #include <C4Wrappers.h>
 
 static const C4Fixed WindDrift_Factor = itofix(1, 800);
@@ -140,7 +141,6 @@ void C4PXS::Deactivate()
 	AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 #endif
 	Mat = MNone;
-	Game.PXS.Delete(this);
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -156,86 +156,90 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	DeadCount = 0;
+	NextTile = 0;
 }
 
 void C4PXSSystem::Clear()
 {
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		delete[] Chunk[cnt];
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Mat.clear(); Mat.shrink_to_fit();
+	x.clear(); x.shrink_to_fit();
+	y.clear(); y.shrink_to_fit();
+	xdir.clear(); xdir.shrink_to_fit();
+	ydir.clear(); ydir.shrink_to_fit();
+	Tile.clear(); Tile.shrink_to_fit();
+	DeadCount = 0;
 }
 
-C4PXS *C4PXSSystem::New()
+size_t C4PXSSystem::GetMaxCount() const
 {
-	unsigned int cnt, cnt2;
-	C4PXS *pxp;
-	// Check chunks for available space
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		// Create new chunk if necessary
-		if (!Chunk[cnt])
-		{
-			Chunk[cnt] = new C4PXS[PXSChunkSize];
-			iChunkPXS[cnt] = 0;
-		}
-		// Check this chunk for space
-		if (iChunkPXS[cnt] < PXSChunkSize)
-			for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat == MNone)
-				{
-					// count theam
-					iChunkPXS[cnt]++;
-					return pxp;
-				}
-	}
-	return nullptr;
+	return static_cast<size_t>(std::max<int32_t>(Game.C4S.Landscape.MaxPXS, 0));
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
 {
-	C4PXS *pxp;
 	if (!MatValid(mat)) return false;
-	if (!(pxp = New())) return false;
-	pxp->Mat = mat;
-	pxp->x = ix; pxp->y = iy;
-	pxp->xdir = ixdir; pxp->ydir = iydir;
+	if (Mat.size() - DeadCount >= GetMaxCount()) return false;
+	Add(mat, ix, iy, ixdir, iydir);
 	return true;
 }
 
+void C4PXSSystem::Add(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
+{
+	Mat.push_back(mat);
+	x.push_back(ix); y.push_back(iy);
+	xdir.push_back(ixdir); ydir.push_back(iydir);
+	Tile.push_back(NextTile);
+	NextTile = static_cast<uint16_t>((NextTile + 1) % PXSChunkSize);
+}
+
 void C4PXSSystem::Execute()
 {
-	// Execute all chunks
 	Count = 0;
-	for (unsigned int cchunk = 0; cchunk < PXSMaxChunk; cchunk++)
+	// Execute all PXS, including the ones appended by reactions during this pass,
+	// so that new PXS start moving in the frame they were created in like they did with chunks
+	for (size_t i = 0; i < Mat.size(); ++i)
 	{
-		if (Chunk[cchunk])
+		if (Mat[i] == MNone) continue;
+		// work on a copy, because reactions may create new PXS and thus reallocate the arrays
+		C4PXS pxs(Mat[i], x[i], y[i], xdir[i], ydir[i]);
+		pxs.Execute();
+		Count++;
+		if (pxs.Mat == MNone)
 		{
-			// empty chunk?
-			if (!iChunkPXS[cchunk])
-			{
-				delete[] Chunk[cchunk]; Chunk[cchunk] = nullptr;
-			}
-			else
+			Mat[i] = MNone;
+			++DeadCount;
+			continue;
+		}
+		x[i] = pxs.x; y[i] = pxs.y;
+		xdir[i] = pxs.xdir; ydir[i] = pxs.ydir;
+	}
+	// remove the deactivated ones
+	Compact();
+}
+
+void C4PXSSystem::Compact()
+{
+	if (!DeadCount) return;
+	// stable compaction, so the execution order stays the same on all clients
+	size_t iDst = 0;
+	for (size_t iSrc = 0; iSrc < Mat.size(); ++iSrc)
+		if (Mat[iSrc] != MNone)
+		{
+			if (iDst != iSrc)
 			{
-				// Execute chunk pxs, check for empty
-				C4PXS *pxp = Chunk[cchunk];
-				for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-					if (pxp->Mat != MNone)
-					{
-						pxp->Execute();
-						Count++;
-					}
+				Mat[iDst] = Mat[iSrc];
+				x[iDst] = x[iSrc]; y[iDst] = y[iSrc];
+				xdir[iDst] = xdir[iSrc]; ydir[iDst] = ydir[iSrc];
+				Tile[iDst] = Tile[iSrc];
 			}
+			++iDst;
 		}
-	}
+	Mat.resize(iDst);
+	x.resize(iDst); y.resize(iDst);
+	xdir.resize(iDst); ydir.resize(iDst);
+	Tile.resize(iDst);
+	DeadCount = 0;
 }
 
 void C4PXSSystem::Draw(C4FacetEx &cgo)
@@ -246,33 +250,27 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 
 	// First pass: draw old-style PXS (lines/pixels)
 	int32_t cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t i = 0; i < Mat.size(); ++i)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(x[i]), fixtoi(y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
-						continue;
-					// old-style: unicolored pixels or lines
-					uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(pxp->Mat));
-					if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
-					{
-						// lines for stuff that goes whooosh!
-						int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
-						dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
-						Application.DDraw->DrawLineDw(cgo.Surface,
-							fixtof(pxp->x - pxp->xdir) + cgox, fixtof(pxp->y - pxp->ydir) + cgoy,
-							fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy,
-							dwMatClr);
-					}
-					else
-						// single pixels for slow stuff
-						Application.DDraw->DrawPix(cgo.Surface, fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy, dwMatClr);
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
+				continue;
+			// old-style: unicolored pixels or lines
+			uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(Mat[i]));
+			if (fixtoi(xdir[i]) || fixtoi(ydir[i]))
+			{
+				// lines for stuff that goes whooosh!
+				int len = fixtoi(Abs(xdir[i]) + Abs(ydir[i]));
+				dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
+				Application.DDraw->DrawLineDw(cgo.Surface,
+					fixtof(x[i] - xdir[i]) + cgox, fixtof(y[i] - ydir[i]) + cgoy,
+					fixtof(x[i]) + cgox, fixtof(y[i]) + cgoy,
+					dwMatClr);
+			}
+			else
+				// single pixels for slow stuff
+				Application.DDraw->DrawPix(cgo.Surface, fixtof(x[i]) + cgox, fixtof(y[i]) + cgoy, dwMatClr);
 		}
 
 	// PXS graphics disabled?
@@ -280,28 +278,24 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 		return;
 
 	// Second pass: draw new-style PXS (graphics)
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t i = 0; i < Mat.size(); ++i)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(x[i]), fixtoi(y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (!pMat->PXSFace.Surface)
-						continue;
-					// new-style: graphics
-					int32_t pnx, pny;
-					pMat->PXSFace.GetPhaseNum(pnx, pny);
-					int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
-					// calculate draw width and tile to use (random-ish)
-					int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
-					pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
-					// draw
-					Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
-					pMat->PXSFace.DrawX(cgo.Surface, fixtoi(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
-					Application.DDraw->DeactivateBlitModulation();
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (!pMat->PXSFace.Surface)
+				continue;
+			// new-style: graphics
+			int32_t pnx, pny;
+			pMat->PXSFace.GetPhaseNum(pnx, pny);
+			int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
+			// calculate draw width and tile to use (random-ish)
+			const int32_t iTile = Tile[i];
+			int32_t z = 1 + ((iTile / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
+			pny = (iTile / pnx) % pny; pnx = iTile % pnx;
+			// draw
+			Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
+			pMat->PXSFace.DrawX(cgo.Surface, fixtoi(x[i]) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(y[i]) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
+			Application.DDraw->DeactivateBlitModulation();
 		}
 }
 
@@ -322,30 +316,28 @@ void C4PXSSystem::Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t
 
 bool C4PXSSystem::Save(C4Group &hGroup)
 {
-	unsigned int cnt;
-
-	// Check used chunk count
-	int32_t iChunks = 0;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			iChunks++;
-	if (!iChunks)
+	if (Mat.size() == DeadCount)
 	{
 		hGroup.Delete(C4CFN_PXS);
 		return true;
 	}
 
-	// Save chunks to temp file
+	// Save PXS to temp file
+	// the format is a sequence of chunks of PXSChunkSize entries, so the last chunk is padded with empty ones
 	CStdFile hTempFile;
 	if (!hTempFile.Create(Config.AtTempPath(C4CFN_TempPXS)))
 		return false;
 	int32_t iNumFormat = 1;
 	if (!hTempFile.Write(&iNumFormat, sizeof(iNumFormat)))
 		return false;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt]) // must save all chunks in order to keep order consistent on all clients
-			if (!hTempFile.Write(Chunk[cnt], PXSChunkSize * sizeof(C4PXS)))
-				return false;
+	std::vector<C4PXS> entries;
+	entries.reserve((Mat.size() + PXSChunkSize - 1) / PXSChunkSize * PXSChunkSize);
+	for (size_t i = 0; i < Mat.size(); ++i)
+		if (Mat[i] != MNone)
+			entries.push_back(C4PXS(Mat[i], x[i], y[i], xdir[i], ydir[i]));
+	entries.resize((entries.size() + PXSChunkSize - 1) / PXSChunkSize * PXSChunkSize);
+	if (!hTempFile.Write(entries.data(), entries.size() * sizeof(C4PXS)))
+		return false;
 
 	if (!hTempFile.Close())
 		return false;
@@ -361,8 +353,8 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 bool C4PXSSystem::Load(C4Group &hGroup)
 {
 	// load new
-	size_t iBinSize, iChunkNum, cnt2;
-	size_t iChunkSize = PXSChunkSize * sizeof(C4PXS);
+	size_t iBinSize;
+	const size_t iChunkSize = PXSChunkSize * sizeof(C4PXS);
 	if (!hGroup.AccessEntry(C4CFN_PXS, &iBinSize)) return false;
 	// clear previous
 	Clear();
@@ -376,24 +368,18 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	}
 	// old pxs-files have no tag for the number format
 	else if (iBinSize % iChunkSize != 0) return false;
-	// calc chunk count
-	iChunkNum = iBinSize / iChunkSize;
-	if (iChunkNum > PXSMaxChunk) return false;
-	for (uint32_t cnt = 0; cnt < iChunkNum; cnt++)
-	{
-		Chunk[cnt] = new C4PXS[PXSChunkSize];
-		if (!hGroup.Read(Chunk[cnt], iChunkSize)) return false;
-		// count the PXS, Peter!
-		// convert num format, if neccessary
-		C4PXS *pxp; iChunkPXS[cnt] = 0;
-		for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-			if (pxp->Mat != MNone)
-			{
-				++iChunkPXS[cnt];
-				// convert number format
-				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
-			}
-	}
+	std::vector<C4PXS> entries(iBinSize / sizeof(C4PXS));
+	if (!hGroup.Read(entries.data(), iBinSize)) return false;
+	// take over the used entries in order, but not more than the scenario allows
+	const size_t iMaxCount = GetMaxCount();
+	for (C4PXS &pxs : entries)
+		if (pxs.Mat != MNone)
+		{
+			if (Mat.size() >= iMaxCount) break;
+			// convert number format
+			if (iNumForm == 2) { FLOAT_TO_FIXED(&pxs.x); FLOAT_TO_FIXED(&pxs.y); FLOAT_TO_FIXED(&pxs.xdir); FLOAT_TO_FIXED(&pxs.ydir); }
+			Add(pxs.Mat, pxs.x, pxs.y, pxs.xdir, pxs.ydir);
+		}
 	return true;
 }
 
@@ -402,35 +388,18 @@ void C4PXSSystem::Synchronize()
 	Count = 0;
 }
 
-void C4PXSSystem::SyncClearance()
+uint32_t C4PXSSystem::GetSyncHash() const
 {
-	// consolidate chunks; remove empty chunks
-	C4PXS **pDestChunk = Chunk;
-	int32_t iDestChunk = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		if (Chunk[cnt] && iChunkPXS[cnt])
-		{
-			*pDestChunk++ = Chunk[cnt];
-			iChunkPXS[iDestChunk++] = iChunkPXS[cnt];
-		}
-		else
-		{
-			delete[] Chunk[cnt];
-			Chunk[cnt] = nullptr;
-		}
-	}
+	uint32_t hash = 0;
+	for (size_t i = 0; i < Mat.size(); ++i)
+		if (Mat[i] != MNone)
+			hash += C4SyncHashOf(Mat[i], x[i].val, y[i].val, xdir[i].val, ydir[i].val);
+	return hash;
 }
 
-void C4PXSSystem::Delete(C4PXS *pPXS)
+void C4PXSSystem::SyncClearance()
 {
-	// find chunk
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			if (pPXS >= Chunk[cnt] && pPXS < Chunk[cnt] + PXSChunkSize)
-				break;
-	// decrease pxs counter
-	if (cnt < PXSMaxChunk)
-		iChunkPXS[cnt]--;
+	// remove deactivated PXS; release memory if there are none left
+	Compact();
+	if (Mat.empty()) Clear();
 }
@@ -22,9 +22,14 @@
 #include <C4Material.h>
 #include "Fixed.h"
 
+#include <vector>
+
+// single pixel sprite; only used as working copy during execution and as savegame entry
 class C4PXS
 {
+public:
 	C4PXS() : Mat(MNone), x(Fix0), y(Fix0), xdir(Fix0), ydir(Fix0) {}
+	C4PXS(int32_t Mat, C4Fixed x, C4Fixed y, C4Fixed xdir, C4Fixed ydir) : Mat(Mat), x(x), y(y), xdir(xdir), ydir(ydir) {}
 
 	friend class C4PXSSystem;
 
@@ -37,7 +42,8 @@ protected:
 	void Deactivate();
 };
 
-const size_t PXSChunkSize = 500, PXSMaxChunk = 20;
+const size_t PXSChunkSize = 500; // number of PXS per chunk in the savegame format
+const int32_t C4PXS_DefaultMax = 10000;
 
 class C4PXSSystem
 {
@@ -49,22 +55,29 @@ public:
 	int32_t Count;
 
 protected:
-	C4PXS *Chunk[PXSMaxChunk];
-	size_t iChunkPXS[PXSMaxChunk];
+	// particle data as structure of arrays; all vectors have the same size
+	// dead particles are marked with MNone and compacted after each execution
+	std::vector<int32_t> Mat;
+	std::vector<C4Fixed> x, y, xdir, ydir;
+	std::vector<uint16_t> Tile; // graphics tile, chosen on creation so it doesn't change when compaction moves the particle
+	size_t DeadCount;
+	uint16_t NextTile;
 
 public:
-	void Delete(C4PXS *pPXS);
 	void Default();
 	void Clear();
 	void Execute();
 	void Draw(C4FacetEx &cgo);
 	void Synchronize();
 	void SyncClearance();
+	uint32_t GetSyncHash() const; // order-independent hash of all active PXS for sync checks
 	void Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t level);
 	bool Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir = Fix0, C4Fixed iydir = Fix0);
 	bool Load(C4Group &hGroup);
 	bool Save(C4Group &hGroup);
 
 protected:
-	C4PXS *New();
+	void Compact();
+	size_t GetMaxCount() const;
+	void Add(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir);
 };
@@ -247,8 +247,17 @@ void C4ParticleChunk::Clear()
 }
 
 void C4ParticleList::Exec(C4Object *pObj)
+{
+	// execute all particles and free the dead ones
+	C4ParticleList Dead;
+	Exec(pObj, Dead);
+	Dead.Clear();
+}
+
+void C4ParticleList::Exec(C4Object *pObj, C4ParticleList &rDead)
 {
 	// execute all particles
+	// does not touch the particle system, so lists of different objects may be executed concurrently
 	C4Particle *pPrtNext = pFirst, *pPrt;
 	while ((pPrt = pPrtNext))
 	{
@@ -256,11 +265,8 @@ void C4ParticleList::Exec(C4Object *pObj)
 		pPrtNext = pPrt->pNext;
 		// execute it
 		if (!pPrt->pDef->ExecProc(pPrt, pObj))
-		{
 			// sorry, life is over for you :P
-			--pPrt->pDef->Count;
-			pPrt->MoveList(*this, Game.Particles.FreeParticles);
-		}
+			pPrt->MoveList(*this, rDead);
 	}
 	// done
 }
@@ -159,6 +159,7 @@ public:
 	C4ParticleList() { pFirst = nullptr; }
 
 	void Exec(C4Object *pObj = nullptr); // execute all particles
+	void Exec(C4Object *pObj, C4ParticleList &rDead); // execute all particles, moving dead ones to rDead instead of freeing them
 	void Draw(C4FacetEx &cgo, C4Object *pObj = nullptr); // draw all particles
 	void Clear(); // remove all particles
 	int32_t Remove(C4ParticleDef *pOfDef); // remove all particles of def
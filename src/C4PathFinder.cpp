@@ -67,7 +67,9 @@ const int32_t C4PF_MaxDepth  = 35,
               C4PF_Crawl_Bottom   = 3,
               C4PF_Crawl_Left     = 4,
 
-              C4PF_Draw_Rate = 10;
+              C4PF_Draw_Rate = 10,
+
+              C4PF_MaxCachedPaths = 256;
 
 // C4PathFinderRay
 
@@ -107,7 +109,7 @@ bool C4PathFinderRay::Execute()
 		if (UseZone)
 		{
 			// Mark zone used
-			UseZone->Used = true;
+			pPathFinder->UseTransferZone(UseZone);
 			// Target in transfer zone: success
 			if (UseZone->At(TargetX, TargetY))
 			{
@@ -194,20 +196,18 @@ bool C4PathFinderRay::Execute()
 			Status = C4PF_Ray_Still; break;
 		}
 		// Check unused zone intersection
-		if (pPathFinder->TransferZonesEnabled)
-			if (pPathFinder->TransferZones)
-				if ((pZone = pPathFinder->TransferZones->Find(X2, Y2)))
-					if (!pZone->Used)
+		if ((pZone = pPathFinder->FindTransferZone(X2, Y2)))
+			if (!pZone->Used)
+			{
+				// Add use-zone ray (with zone entry point adjust)
+				iX = X2; iY = Y2; if (pZone->GetEntryPoint(iX, iY, X2, Y2))
+					if (!pPathFinder->AddRay(iX, iY, TargetX, TargetY, Depth + 1, Direction, this, pZone))
 					{
-						// Add use-zone ray (with zone entry point adjust)
-						iX = X2; iY = Y2; if (pZone->GetEntryPoint(iX, iY, X2, Y2))
-							if (!pPathFinder->AddRay(iX, iY, TargetX, TargetY, Depth + 1, Direction, this, pZone))
-							{
-								Status = C4PF_Ray_Failure; break;
-							}
-						// Continue crawling
-						return true;
+						Status = C4PF_Ray_Failure; break;
 					}
+				// Continue crawling
+				return true;
+			}
 		// Crawl length
 		CrawlLength++;
 		if (CrawlLength >= C4PF_MaxCrawl * pPathFinder->Level)
@@ -305,10 +305,8 @@ bool C4PathFinderRay::PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t i
 			else return false;
 			// Check transfer zone intersection
 			if (ppZone)
-				if (pPathFinder->TransferZonesEnabled)
-					if (pPathFinder->TransferZones)
-						if ((*ppZone = pPathFinder->TransferZones->Find(rX, rY)))
-							return false;
+				if ((*ppZone = pPathFinder->FindTransferZone(rX, rY)))
+					return false;
 			// Advance
 			if (d >= 0) { x += xincr; d += aincr; }
 			else d += bincr;
@@ -327,10 +325,8 @@ bool C4PathFinderRay::PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t i
 			else return false;
 			// Check transfer zone intersection
 			if (ppZone)
-				if (pPathFinder->TransferZonesEnabled)
-					if (pPathFinder->TransferZones)
-						if ((*ppZone = pPathFinder->TransferZones->Find(rX, rY)))
-							return false;
+				if ((*ppZone = pPathFinder->FindTransferZone(rX, rY)))
+					return false;
 			// Advance
 			if (d >= 0) { y += yincr; d += aincr; }
 			else d += bincr;
@@ -389,18 +385,16 @@ void C4PathFinderRay::SetCompletePath()
 	{
 		// Transfer waypoint
 		if (pRay->UseZone)
-			pPathFinder->SetWaypoint(pRay->X2, pRay->Y2, reinterpret_cast<intptr_t>(pRay->UseZone->Object),
-				pPathFinder->WaypointParameter);
+			pPathFinder->AddWaypoint(pRay->X2, pRay->Y2, reinterpret_cast<intptr_t>(pRay->UseZone->Object));
 		// MoveTo waypoint
 		else
-			pPathFinder->SetWaypoint(pRay->From->X2, pRay->From->Y2, 0,
-				pPathFinder->WaypointParameter);
+			pPathFinder->AddWaypoint(pRay->From->X2, pRay->From->Y2, 0);
 	}
 }
 
 bool C4PathFinderRay::PointFree(int32_t iX, int32_t iY)
 {
-	return pPathFinder->PointFree(iX, iY);
+	return pPathFinder->PointFreeInSearch(iX, iY);
 }
 
 bool C4PathFinderRay::CrawlTargetFree(int32_t iX, int32_t iY, int32_t iAttach, int32_t iDirection)
@@ -526,25 +520,31 @@ void C4PathFinder::Default()
 	PointFree = nullptr;
 	SetWaypoint = nullptr;
 	FirstRay = nullptr;
+	UsedRays = 0;
 	WaypointParameter = 0;
 	Success = false;
 	TransferZones = nullptr;
+	Landscape = &Game.Landscape;
 	TransferZonesEnabled = true;
 	Level = 1;
+	CacheOwner = this;
+	ClearCache();
 }
 
 void C4PathFinder::Clear()
 {
-	C4PathFinderRay *pRay, *pNext;
-	for (pRay = FirstRay; pRay; pRay = pNext) { pNext = pRay->Next; delete pRay; }
+	// Rays stay allocated for the next search
 	FirstRay = nullptr;
+	UsedRays = 0;
 }
 
-void C4PathFinder::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones)
+void C4PathFinder::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones, C4Landscape *pLandscape)
 {
 	// Set data
 	PointFree = fnPointFree;
 	TransferZones = pTransferZones;
+	Landscape = pLandscape ? pLandscape : &Game.Landscape;
+	ClearCache();
 }
 
 void C4PathFinder::EnableTransferZones(bool fEnabled)
@@ -563,12 +563,23 @@ void C4PathFinder::Draw(C4FacetEx &cgo)
 	for (C4PathFinderRay *pRay = FirstRay; pRay; pRay = pRay->Next) pRay->Draw(cgo);
 }
 
-void C4PathFinder::Run()
+C4PathFinder::Result C4PathFinder::Run(int32_t iMaxSteps)
 {
-	if (TransferZones) TransferZones->ClearUsed();
-	Success = false;
-	while (!Success && Execute());
+	for (int32_t iStep = 0; !Success; iStep++)
+	{
+		// Budget used up: continue later
+		if (iMaxSteps && iStep >= iMaxSteps) return Result::Pending;
+		if (!Execute()) break;
+	}
 	// Notice that ray zone-pointers might be invalid after run
+
+	// Remember result, unless it depends on transfer zones (their entry points are not limited to the searched area)
+	// or the searched area changed while the search was suspended
+	const C4Rect bounds(SearchX1, SearchY1, SearchX2 - SearchX1 + 1, SearchY2 - SearchY1 + 1);
+	if (!SearchUsedZones && !Landscape->FreeChangedSince(bounds, SearchLandscapeStamp))
+		CacheOwner->AddCachedPath(SearchKey, CachedPath{Success, SearchWaypoints, bounds, SearchLandscapeStamp, SearchZoneRevision});
+
+	return Success ? Result::Found : Result::Failed;
 }
 
 bool C4PathFinder::Execute()
@@ -598,27 +609,181 @@ bool C4PathFinder::Execute()
 }
 
 bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter)
+{
+	return Start(iFromX, iFromY, iToX, iToY, fnSetWaypoint, iWaypointParameter, 0) == Result::Found;
+}
+
+C4PathFinder::Result C4PathFinder::Start(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter, int32_t iMaxSteps)
 {
 	// Prepare
 	Clear();
 
 	// Parameter safety
-	if (!fnSetWaypoint) return false;
+	if (!fnSetWaypoint) return Result::Failed;
 	SetWaypoint = fnSetWaypoint;
 	WaypointParameter = iWaypointParameter;
 
 	// Start & target coordinates must be free
-	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return false;
+	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return Result::Failed;
+
+	// Same search done before and nothing changed since?
+	SearchKey = CacheKey{iFromX, iFromY, iToX, iToY, Level, TransferZonesEnabled};
+	const auto cached = CacheOwner->Cache.find(SearchKey);
+	if (cached != CacheOwner->Cache.end() && IsCacheValid(cached->second))
+	{
+		for (const auto &[iX, iY] : cached->second.Waypoints)
+			SetWaypoint(iX, iY, 0, WaypointParameter);
+		Success = cached->second.Success;
+		CacheOwner->CacheHits++;
+		return Success ? Result::Found : Result::Failed;
+	}
+	CacheOwner->CacheMisses++;
 
 	// Add the first two rays
-	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
-	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
+	if (!BeginSearch()) return Result::Failed;
 
 	// Run
-	Run();
+	return Run(iMaxSteps);
+}
 
-	// Success
-	return Success;
+C4PathFinder::Result C4PathFinder::Resume(int32_t iMaxSteps)
+{
+	if (!FirstRay) return Result::Failed;
+	if (TransferZones)
+	{
+		// Zones changed while suspended: ray zone pointers might be invalid, so search again
+		if (TransferZones->GetRevision() != SearchZoneRevision)
+		{
+			if (!BeginSearch()) return Result::Failed;
+		}
+		// Restore zone marks, other searches might have run in between
+		else
+		{
+			TransferZones->ClearUsed();
+			for (C4TransferZone *pZone : SearchZonesUsed)
+				pZone->Used = true;
+		}
+	}
+	return Run(iMaxSteps);
+}
+
+std::unique_ptr<C4PathFinder> C4PathFinder::Suspend()
+{
+	auto search = std::make_unique<C4PathFinder>();
+	search->PointFree = PointFree;
+	search->SetWaypoint = SetWaypoint;
+	search->WaypointParameter = WaypointParameter;
+	search->Success = Success;
+	search->TransferZones = TransferZones;
+	search->Landscape = Landscape;
+	search->TransferZonesEnabled = TransferZonesEnabled;
+	search->Level = Level;
+	search->CacheOwner = CacheOwner;
+	search->SearchKey = SearchKey;
+	search->SearchX1 = SearchX1; search->SearchY1 = SearchY1;
+	search->SearchX2 = SearchX2; search->SearchY2 = SearchY2;
+	search->SearchUsedZones = SearchUsedZones;
+	search->SearchZonesUsed = std::move(SearchZonesUsed);
+	search->SearchWaypoints = std::move(SearchWaypoints);
+	search->SearchLandscapeStamp = SearchLandscapeStamp;
+	search->SearchZoneRevision = SearchZoneRevision;
+	// Hand over the rays; moving the arena keeps their addresses
+	search->Rays = std::move(Rays);
+	search->UsedRays = UsedRays;
+	search->FirstRay = FirstRay;
+	for (C4PathFinderRay *pRay = FirstRay; pRay; pRay = pRay->Next)
+		pRay->pPathFinder = search.get();
+	Rays.clear();
+	SearchZonesUsed.clear();
+	SearchWaypoints.clear();
+	Clear();
+	return search;
+}
+
+bool C4PathFinder::BeginSearch()
+{
+	Clear();
+
+	// Track the search for the cache
+	SearchX1 = SearchX2 = SearchKey.FromX; SearchY1 = SearchY2 = SearchKey.FromY;
+	SearchUsedZones = false;
+	SearchZonesUsed.clear();
+	SearchWaypoints.clear();
+	SearchLandscapeStamp = Landscape->GetFreeChangeStamp();
+	SearchZoneRevision = TransferZones ? TransferZones->GetRevision() : 0;
+
+	if (TransferZones) TransferZones->ClearUsed();
+	Success = false;
+
+	return AddRay(SearchKey.FromX, SearchKey.FromY, SearchKey.ToX, SearchKey.ToY, 0, C4PF_Direction_Left, nullptr)
+		&& AddRay(SearchKey.FromX, SearchKey.FromY, SearchKey.ToX, SearchKey.ToY, 0, C4PF_Direction_Right, nullptr);
+}
+
+std::size_t C4PathFinder::CacheKeyHash::operator()(const CacheKey &key) const
+{
+	std::size_t iHash = std::hash<int32_t>{}(key.FromX);
+	for (const int32_t iValue : {key.FromY, key.ToX, key.ToY, static_cast<int32_t>(key.Level * 2 + key.TransferZonesEnabled)})
+		iHash = iHash * 31 + std::hash<int32_t>{}(iValue);
+	return iHash;
+}
+
+void C4PathFinder::ClearCache()
+{
+	Cache.clear();
+	CacheOrder.clear();
+	CacheHits = CacheMisses = 0;
+}
+
+void C4PathFinder::AddCachedPath(const CacheKey &key, CachedPath path)
+{
+	if (!Cache.contains(key))
+	{
+		if (CacheOrder.size() >= C4PF_MaxCachedPaths)
+		{
+			Cache.erase(CacheOrder.front());
+			CacheOrder.pop_front();
+		}
+		CacheOrder.push_back(key);
+	}
+	Cache.insert_or_assign(key, std::move(path));
+}
+
+bool C4PathFinder::IsCacheValid(const CachedPath &path) const
+{
+	// PointFree checks the landscape
+	if (Landscape->FreeChangedSince(path.Bounds, path.LandscapeStamp)) return false;
+	// a new zone might be in the way
+	if (TransferZonesEnabled && TransferZones && TransferZones->GetRevision() != path.ZoneRevision) return false;
+	return true;
+}
+
+C4TransferZone *C4PathFinder::FindTransferZone(int32_t iX, int32_t iY)
+{
+	if (!TransferZonesEnabled || !TransferZones) return nullptr;
+	C4TransferZone *pZone = TransferZones->Find(iX, iY);
+	if (pZone) SearchUsedZones = true;
+	return pZone;
+}
+
+void C4PathFinder::UseTransferZone(C4TransferZone *pZone)
+{
+	if (!pZone->Used) SearchZonesUsed.push_back(pZone);
+	pZone->Used = true;
+}
+
+void C4PathFinder::AddWaypoint(int32_t iX, int32_t iY, intptr_t iTransferTarget)
+{
+	SearchWaypoints.emplace_back(iX, iY);
+	SetWaypoint(iX, iY, iTransferTarget, WaypointParameter);
+}
+
+C4PathFinderRay *C4PathFinder::NewRay()
+{
+	if (UsedRays == Rays.size())
+		Rays.emplace_back();
+	C4PathFinderRay *pRay = &Rays[UsedRays++];
+	pRay->Default();
+	return pRay;
 }
 
 bool C4PathFinder::AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone)
@@ -626,17 +791,17 @@ bool C4PathFinder::AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t
 	// Max depth
 	if (iDepth >= C4PF_MaxDepth * Level) return false;
 	// Allocate and set new ray
-	auto ray = std::make_unique<C4PathFinderRay>();
-	ray->X = iFromX; ray->Y = iFromY;
-	ray->X2 = iFromX; ray->Y2 = iFromY;
-	ray->TargetX = iToX; ray->TargetY = iToY;
-	ray->Depth = iDepth;
-	ray->Direction = iDirection;
-	ray->From = pFrom;
-	ray->pPathFinder = this;
-	ray->Next = FirstRay;
-	ray->UseZone = pUseZone;
-	FirstRay = ray.release();
+	C4PathFinderRay *pRay = NewRay();
+	pRay->X = iFromX; pRay->Y = iFromY;
+	pRay->X2 = iFromX; pRay->Y2 = iFromY;
+	pRay->TargetX = iToX; pRay->TargetY = iToY;
+	pRay->Depth = iDepth;
+	pRay->Direction = iDirection;
+	pRay->From = pFrom;
+	pRay->pPathFinder = this;
+	pRay->Next = FirstRay;
+	pRay->UseZone = pUseZone;
+	FirstRay = pRay;
 	return true;
 }
 
@@ -645,19 +810,19 @@ bool C4PathFinder::SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY)
 	// Max depth
 	if (pRay->Depth >= C4PF_MaxDepth * Level) return false;
 	// Allocate and set new ray
-	auto newRay = std::make_unique<C4PathFinderRay>();
-	newRay->Status = C4PF_Ray_Still;
-	newRay->X = pRay->X; newRay->Y = pRay->Y;
-	newRay->X2 = iAtX; newRay->Y2 = iAtY;
-	newRay->TargetX = pRay->TargetX; newRay->TargetY = pRay->TargetY;
-	newRay->Depth = pRay->Depth;
-	newRay->Direction = pRay->Direction;
-	newRay->From = pRay->From;
-	newRay->pPathFinder = this;
-	newRay->Next = FirstRay;
-	FirstRay = newRay.get();
+	C4PathFinderRay *pNewRay = NewRay();
+	pNewRay->Status = C4PF_Ray_Still;
+	pNewRay->X = pRay->X; pNewRay->Y = pRay->Y;
+	pNewRay->X2 = iAtX; pNewRay->Y2 = iAtY;
+	pNewRay->TargetX = pRay->TargetX; pNewRay->TargetY = pRay->TargetY;
+	pNewRay->Depth = pRay->Depth;
+	pNewRay->Direction = pRay->Direction;
+	pNewRay->From = pRay->From;
+	pNewRay->pPathFinder = this;
+	pNewRay->Next = FirstRay;
+	FirstRay = pNewRay;
 	// Adjust split ray
-	pRay->From = newRay.release();
+	pRay->From = pNewRay;
 	pRay->X = iAtX; pRay->Y = iAtY;
 	return true;
 }
@@ -19,8 +19,17 @@
 #pragma once
 
 #include "C4ForwardDeclarations.h"
+#include <C4Rect.h>
 #include <C4TransferZone.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 class C4PathFinderRay
 {
 	friend class C4PathFinder;
@@ -68,29 +77,98 @@ public:
 	C4PathFinder();
 	~C4PathFinder();
 
+	enum class Result
+	{
+		Failed,
+		Found,
+		Pending, // step budget used up; continue with Resume
+	};
+
 protected:
 	bool(*PointFree)(int32_t, int32_t);
 	// iToX and iToY are intptr_t because there are stored object
 	// pointers sometimes
 	bool(*SetWaypoint)(int32_t, int32_t, intptr_t, intptr_t);
 	C4PathFinderRay *FirstRay;
+	std::deque<C4PathFinderRay> Rays; // ray arena; elements keep their address and are reused by later searches
+	std::size_t UsedRays;
 	intptr_t WaypointParameter;
 	bool Success;
 	C4TransferZones *TransferZones;
+	C4Landscape *Landscape; // whose changes invalidate cached paths; PointFree should check this landscape
 	bool TransferZonesEnabled;
 	int Level;
 
+	// Results of recent searches, reused as long as the searched landscape area and the transfer zones are unchanged
+	struct CacheKey
+	{
+		int32_t FromX, FromY, ToX, ToY;
+		int Level;
+		bool TransferZonesEnabled;
+
+		bool operator==(const CacheKey &) const = default;
+	};
+
+	struct CacheKeyHash
+	{
+		std::size_t operator()(const CacheKey &key) const;
+	};
+
+	struct CachedPath
+	{
+		bool Success;
+		std::vector<std::pair<int32_t, int32_t>> Waypoints;
+		C4Rect Bounds; // all points checked by the search
+		uint64_t LandscapeStamp;
+		uint32_t ZoneRevision;
+	};
+
+	std::unordered_map<CacheKey, CachedPath, CacheKeyHash> Cache;
+	std::deque<CacheKey> CacheOrder; // oldest first
+	C4PathFinder *CacheOwner; // path finder whose cache suspended searches use
+	uint32_t CacheHits, CacheMisses;
+
+	// State of the running search
+	CacheKey SearchKey;
+	int32_t SearchX1, SearchY1, SearchX2, SearchY2;
+	bool SearchUsedZones;
+	std::vector<C4TransferZone *> SearchZonesUsed; // zones marked as used, restored when resuming
+	std::vector<std::pair<int32_t, int32_t>> SearchWaypoints;
+	uint64_t SearchLandscapeStamp;
+	uint32_t SearchZoneRevision;
+
 public:
 	void Draw(C4FacetEx &cgo);
 	void Clear();
 	void Default();
-	void Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones = nullptr);
+	void Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones = nullptr, C4Landscape *pLandscape = nullptr);
 	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
+	// Like Find, but stops after iMaxSteps ray execution rounds (0 = no limit)
+	Result Start(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter, int32_t iMaxSteps);
+	Result Resume(int32_t iMaxSteps);
+	std::unique_ptr<C4PathFinder> Suspend(); // moves a pending search into a new path finder, so this one can be used for other searches
+	bool IsSearchingFor(int32_t iToX, int32_t iToY) const { return FirstRay && SearchKey.ToX == iToX && SearchKey.ToY == iToY; }
 	void EnableTransferZones(bool fEnabled);
 	void SetLevel(int iLevel);
+	uint32_t GetCacheHits() const { return CacheOwner->CacheHits; }
+	uint32_t GetCacheMisses() const { return CacheOwner->CacheMisses; } // searches that had to run, including those with an invalidated result
 
 protected:
-	void Run();
+	bool BeginSearch();
+	Result Run(int32_t iMaxSteps);
+	void ClearCache();
+	void AddCachedPath(const CacheKey &key, CachedPath path);
+	bool IsCacheValid(const CachedPath &path) const;
+	bool PointFreeInSearch(int32_t iX, int32_t iY)
+	{
+		SearchX1 = std::min(SearchX1, iX); SearchX2 = std::max(SearchX2, iX);
+		SearchY1 = std::min(SearchY1, iY); SearchY2 = std::max(SearchY2, iY);
+		return PointFree(iX, iY);
+	}
+	C4TransferZone *FindTransferZone(int32_t iX, int32_t iY);
+	void UseTransferZone(C4TransferZone *pZone);
+	C4PathFinderRay *NewRay();
+	void AddWaypoint(int32_t iX, int32_t iY, intptr_t iTransferTarget);
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone = nullptr);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
 	bool Execute();
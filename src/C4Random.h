@@ -25,6 +25,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <ctime>
+#include <random>
 
 inline int RandomCount{0};
 inline unsigned int RandomHold{0};
@@ -68,10 +69,12 @@ inline unsigned int SeededRandom(unsigned int iSeed, unsigned int iRange)
 	return (iSeed >> 16) % iRange;
 }
 
+// not synchronized; every thread has its own generator, so it may also be used by worker threads (e.g. particle execution)
 inline int SafeRandom(int range)
 {
 	if (!range) return 0;
-	return rand() % range;
+	thread_local std::minstd_rand generator{std::random_device{}()};
+	return static_cast<int>(generator()) % range;
 }
 
 void Randomize3();
@@ -28,6 +28,7 @@
 
 #include <StdFile.h>
 
+#include <algorithm>
 #include <format>
 
 #define IMMEDIATEREC
@@ -141,18 +142,27 @@ bool C4Record::Start(bool fInitial)
 			Index++;
 
 	// compose record filename
-	sFilename.Copy(std::format("{}" DirSep "{:03}-{}.c4s", sDemoFolder.getData(), Index, +sScenName).c_str());
+	const std::string filename{std::format("{}" DirSep "{:03}-{}.c4s", sDemoFolder.getData(), Index, +sScenName)};
 
 	// log
-	std::string log{LoadResStr(C4ResStrTableKey::IDS_PRC_RECORDINGTO, sFilename.getData())};
+	std::string log{LoadResStr(C4ResStrTableKey::IDS_PRC_RECORDINGTO, filename.c_str())};
 	if (Game.FrameCounter) log += std::format(" (Frame {})", Game.FrameCounter);
 	LogNTr(log);
 
 	// save game - this also saves player info list
 	C4GameSaveRecord saveRec(fInitial, Index, Game.Parameters.isLeague());
-	if (!saveRec.Save(sFilename.getData())) return false;
+	if (!saveRec.Save(filename.c_str())) return false;
 	saveRec.Close();
 
+	return Open(filename.c_str());
+}
+
+bool C4Record::Open(const char *szFilename)
+{
+	// no double record
+	if (fRecording) return false;
+	sFilename.Copy(szFilename);
+
 	// unpack group, if neccessary
 	if (!DirectoryExists(sFilename.getData()) &&
 		!C4Group_UnpackDirectory(sFilename.getData()))
@@ -170,6 +180,7 @@ bool C4Record::Start(bool fInitial)
 	fStreaming = false;
 	fRecording = true;
 	iLastFrame = 0;
+	iLastKeyframe = Game.FrameCounter;
 	return true;
 }
 
@@ -313,6 +324,41 @@ bool C4Record::AddFile(const char *szLocalFilename, const char *szAddAs, bool fD
 	return true;
 }
 
+bool C4Record::SaveKeyframe()
+{
+	if (!fRecording) return false;
+	// only one keyframe per frame; playback skips control up to the first synchronization of that frame
+	if (Game.FrameCounter == iLastKeyframe) return true;
+
+	// save exact game state like a runtime record start
+	StdStrBuf sTempFilename(sFilename);
+	MakeTempFilename(&sTempFilename);
+	C4GameSaveRecord saveRec(false, Index, Game.Parameters.isLeague());
+	if (!saveRec.Save(sTempFilename.getData()))
+	{
+		EraseItem(sTempFilename.getData());
+		return false;
+	}
+	saveRec.Close();
+
+	if (!AddKeyframe(sTempFilename.getData()))
+	{
+		EraseItem(sTempFilename.getData());
+		return false;
+	}
+	return true;
+}
+
+bool C4Record::AddKeyframe(const char *szSavegameFilename)
+{
+	if (!fRecording) return false;
+	// move it into the record group
+	if (!RecordGrp.Move(szSavegameFilename, std::format(C4CFN_RecKeyframe, Game.FrameCounter).c_str()))
+		return false;
+	iLastKeyframe = Game.FrameCounter;
+	return true;
+}
+
 bool C4Record::StartStreaming(bool fInitial)
 {
 	if (!fRecording) return false;
@@ -376,7 +422,7 @@ bool C4Record::StreamFile(const char *szLocalFilename, const char *szAddAs)
 }
 
 // set defaults
-C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false)
+C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false), iKeyframe(-1)
 {
 #ifdef DEBUGREC
 	loggerDebugRec = logger->clone("DbgRec");
@@ -395,9 +441,24 @@ bool C4Playback::Open(C4Group &rGrp)
 	fLoadSequential = false;
 	iLastSequentialFrame = 0;
 	bool fStrip = false;
+	// keyframes are child groups of the record and contain no control data themselves
+	C4Group ParentGrp;
+	C4Group *pRecordGrp = &rGrp;
+	if (rGrp.GetMother() && !rGrp.FindEntry(C4CFN_CtrlRec) && !rGrp.FindEntry(C4CFN_CtrlRecText))
+	{
+		if (!ParentGrp.Open(rGrp.GetMother()->GetFullName().getData()))
+		{
+			LogFatalNTr("Record: Cannot open record of keyframe!");
+			return false;
+		}
+		pRecordGrp = &ParentGrp;
+	}
+	C4Group &RecordGrp = *pRecordGrp;
+	RecordFilename.Copy(RecordGrp.GetFullName());
+	iKeyframe = (pRecordGrp != &rGrp ? Game.FrameCounter : -1);
 	// get text record file
 	StdStrBuf TextBuf;
-	if (rGrp.LoadEntryString(C4CFN_CtrlRecText, TextBuf))
+	if (RecordGrp.LoadEntryString(C4CFN_CtrlRecText, TextBuf))
 	{
 		if (!ReadText(TextBuf))
 			return false;
@@ -407,12 +468,12 @@ bool C4Playback::Open(C4Group &rGrp)
 		// open group? Then do some sequential reading for large files
 		// Can't do this when a dump is forced, because the dump needs all data
 		// Also can't do this when stripping is desired
-		if (!rGrp.IsPacked()) if (!Game.RecordDumpFile.getLength()) if (!fStrip) fLoadSequential = true;
+		if (!RecordGrp.IsPacked()) if (!Game.RecordDumpFile.getLength()) if (!fStrip) fLoadSequential = true;
 		// get record file
 		if (fLoadSequential)
 		{
-			if (!rGrp.FindEntry(C4CFN_CtrlRec)) return false;
-			if (!playbackFile.Open(std::format("{}" DirSep "{}", rGrp.GetFullName().getData(), C4CFN_CtrlRec).c_str())) return false;
+			if (!RecordGrp.FindEntry(C4CFN_CtrlRec)) return false;
+			if (!playbackFile.Open(std::format("{}" DirSep "{}", RecordGrp.GetFullName().getData(), C4CFN_CtrlRec).c_str())) return false;
 			// forcing first chunk to be read; will call ReadBinary
 			currChunk = chunks.end();
 			if (!NextSequentialChunk())
@@ -426,7 +487,7 @@ bool C4Playback::Open(C4Group &rGrp)
 		{
 			// non-sequential reading: Just read as a whole
 			StdBuf BinaryBuf;
-			if (rGrp.LoadEntry(C4CFN_CtrlRec, BinaryBuf))
+			if (RecordGrp.LoadEntry(C4CFN_CtrlRec, BinaryBuf))
 			{
 				if (!ReadBinary(BinaryBuf))
 					return false;
@@ -456,6 +517,20 @@ bool C4Playback::Open(C4Group &rGrp)
 	// reset status
 	currChunk = chunks.begin();
 	Finished = false;
+	// started from a keyframe: skip control that is already contained in the saved state
+	while (currChunk != chunks.end() && currChunk->Frame < Game.FrameCounter)
+		NextChunk();
+	// collect keyframes for seeking
+	Keyframes.clear();
+	char szKeyframe[_MAX_FNAME + 1];
+	RecordGrp.ResetSearch();
+	while (RecordGrp.FindNextEntry(C4CFN_RecKeyframes, szKeyframe))
+	{
+		int32_t iFrame;
+		if (sscanf(szKeyframe, "Keyframe%d", &iFrame) == 1)
+			Keyframes.push_back(iFrame);
+	}
+	std::sort(Keyframes.begin(), Keyframes.end());
 	// external debugrec file
 #if defined(DEBUGREC_EXTFILE) && defined(DEBUGREC)
 #ifdef DEBUGREC_EXTFILE_WRITE
@@ -817,11 +892,23 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 		switch (currChunk->Type)
 		{
 		case RCT_Ctrl:
-			pCtrl->Append(*currChunk->pCtrl);
+			if (iKeyframe < 0)
+			{
+				pCtrl->Append(*currChunk->pCtrl);
+				break;
+			}
+			for (C4IDPacket *pPkt = currChunk->pCtrl->firstPkt(); pPkt; pPkt = currChunk->pCtrl->nextPkt(pPkt))
+				if (!SkipKeyframeControl(pPkt->getPktType()))
+				{
+					C4IDPacket Packet(*pPkt);
+					pCtrl->Add(Packet.getPktType(), static_cast<C4ControlPacket *>(Packet.getPkt()));
+					Packet.Default();
+				}
 			break;
 
 		case RCT_CtrlPkt:
 		{
+			if (SkipKeyframeControl(currChunk->pPkt->getPktType())) break;
 			C4IDPacket Packet(*currChunk->pPkt);
 			pCtrl->Add(Packet.getPktType(), static_cast<C4ControlPacket *>(Packet.getPkt()));
 			Packet.Default();
@@ -848,6 +935,40 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 		// next chunk
 		NextChunk();
 	}
+	// keyframe control has been processed
+	if (iKeyframe >= 0 && iKeyframe <= iFrame) iKeyframe = -1;
+	return true;
+}
+
+bool C4Playback::SkipKeyframeControl(C4PacketType eType)
+{
+	// control of the keyframe's frame up to and including the synchronization
+	// during which the keyframe was saved has already been executed
+	if (iKeyframe < 0) return false;
+	if (eType == CID_Synchronize) iKeyframe = -1;
+	return true;
+}
+
+bool C4Playback::Seek(int32_t iFrame)
+{
+	if (iFrame < 0) return false;
+	// nearest keyframe before target; 0 for the start of the record
+	const auto it = std::upper_bound(Keyframes.begin(), Keyframes.end(), iFrame);
+	const int32_t iKeyframeFrame = (it == Keyframes.begin() ? 0 : *std::prev(it));
+	// target ahead and no keyframe in between: just fast forward
+	if (iFrame >= Game.FrameCounter && iKeyframeFrame <= Game.FrameCounter)
+	{
+		Game.SeekFrame = iFrame;
+		return true;
+	}
+	// otherwise, the game must be restarted from the keyframe
+	// this deletes the playback, so it is done by the main loop (see C4Application::ExecuteSeek)
+	logger->info("Seeking to frame {} from keyframe at frame {}", iFrame, iKeyframeFrame);
+	if (iKeyframeFrame)
+		Game.SeekRestart = std::format("{}" DirSep C4CFN_RecKeyframe, RecordFilename.getData(), iKeyframeFrame);
+	else
+		Game.SeekRestart = RecordFilename.getData();
+	Game.SeekFrame = iFrame;
 	return true;
 }
 
@@ -876,6 +997,8 @@ void C4Playback::Clear()
 	playbackFile.Close();
 	sequentialBuffer.Clear();
 	fLoadSequential = false;
+	Keyframes.clear();
+	iKeyframe = -1;
 #ifdef DEBUGREC
 	C4IDPacket *pkt;
 	while ((pkt = DebugRec.firstPkt())) DebugRec.Delete(pkt);
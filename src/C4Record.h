@@ -28,6 +28,7 @@ class C4Record;
 #include "Fixed.h"
 
 #include <list>
+#include <vector>
 
 #ifdef DEBUGREC
 extern int DoNoDebugRec; // debugrec disable counter in C4Record.cpp
@@ -258,6 +259,7 @@ private:
 	C4Group RecordGrp; // record scenario group
 	bool fRecording; // set if recording is active
 	uint32_t iLastFrame; // frame of last chunk written
+	int32_t iLastKeyframe; // frame of last keyframe saved (or of record start)
 	bool fStreaming; // perdiodically sent new control to server
 	unsigned int iStreamingPos; // Position of current buffer in stream
 	StdBuf StreamingData; // accumulated control data since last stream sync
@@ -271,6 +273,7 @@ public:
 	const StdBuf &GetStreamingBuf() const { return StreamingData; }
 
 	bool Start(bool fInitial);
+	bool Open(const char *szFilename); // record into an existing savegame of the start state
 	bool Stop(StdStrBuf *pRecordName = nullptr, uint8_t *pRecordSHA1 = nullptr);
 
 	bool Rec(const C4Control &Ctrl, int iFrame); // record control
@@ -279,6 +282,9 @@ public:
 
 	bool AddFile(const char *szLocalFilename, const char *szAddAs, bool fDelete = false);
 
+	bool SaveKeyframe(); // save exact game state into the record; only valid on game synchronization
+	bool AddKeyframe(const char *szSavegameFilename); // move a savegame of the current frame into the record
+
 	bool StartStreaming(bool fInitial);
 	void ClearStreamingBuf(unsigned int iAmount);
 	void StopStreaming();
@@ -301,7 +307,11 @@ private:
 	bool fLoadSequential; // used for debugrecs: Sequential reading of files
 	StdBuf sequentialBuffer; // buffer to manage sequential reads
 	uint32_t iLastSequentialFrame; // frame number of last chunk read
+	StdStrBuf RecordFilename; // record group holding control data and keyframes
+	std::vector<int32_t> Keyframes; // frames of keyframes stored in the record, ascending
+	int32_t iKeyframe; // if started from a keyframe: its frame, until control up to its synchronization has been skipped; -1 otherwise
 	void Finish(); // end playback
+	bool SkipKeyframeControl(C4PacketType eType); // whether a packet has already been executed when the keyframe was saved
 #ifdef DEBUGREC
 	std::shared_ptr<spdlog::logger> loggerDebugRec;
 	C4PacketList DebugRec;
@@ -320,6 +330,7 @@ public:
 	StdBuf ReWriteBinary();
 	void Strip();
 	bool ExecuteControl(C4Control *pCtrl, int iFrame); // assign control
+	bool Seek(int32_t iFrame); // restore nearest keyframe before frame (restarting the game if necessary) and fast forward to it
 	void Clear();
 #ifdef DEBUGREC
 	void Check(C4RecordChunkType eType, const uint8_t *pData, int iSize); // compare with debugrec
@@ -216,6 +216,7 @@ void C4SGame::Default()
 	Goals.Clear();
 	Rules.Clear();
 	FoWColor = 0;
+	PathfinderSteps = 0;
 }
 
 void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
@@ -228,6 +229,7 @@ void C4SGame::CompileFunc(StdCompiler *pComp, bool fSection)
 	pComp->Value(mkNamingAdapt(ClearMaterial,                     "ClearMaterials",     C4NameList()));
 	pComp->Value(mkNamingAdapt(ValueGain,                         "ValueGain",          0));
 	pComp->Value(mkNamingAdapt(EnableRemoveFlag,                  "EnableRemoveFlag",   false));
+	pComp->Value(mkNamingAdapt(PathfinderSteps,                   "PathfinderSteps",    0));
 	pComp->Value(mkNamingAdapt(Realism.ConstructionNeedsMaterial, "StructNeedMaterial", false));
 	pComp->Value(mkNamingAdapt(Realism.StructuresNeedEnergy,      "StructNeedEnergy",   true));
 	if (!fSection)
@@ -323,6 +325,7 @@ void C4SLandscape::Default()
 	FoWRes = CClrModAddMap::iDefResolutionX;
 	ShadeMaterials = true;
 	EnableTextureOverlays = true;
+	MaxPXS = C4PXS_DefaultMax;
 }
 
 void C4SLandscape::GetMapSize(int32_t &rWdt, int32_t &rHgt, int32_t iPlayerNum)
@@ -369,6 +372,7 @@ void C4SLandscape::CompileFunc(StdCompiler *pComp, const bool shadeMaterialsDefa
 	pComp->Value(mkNamingAdapt(FoWRes,                    "FoWRes",                static_cast<int32_t>(CClrModAddMap::iDefResolutionX)));
 	pComp->Value(mkNamingAdapt(ShadeMaterials,            "ShadeMaterials",        shadeMaterialsDefault));
 	pComp->Value(mkNamingAdapt(EnableTextureOverlays,     "EnableTextureOverlays", enableTextureOverlaysDefault));
+	pComp->Value(mkNamingAdapt(MaxPXS,                    "MaxPXS",                C4PXS_DefaultMax));
 }
 
 void C4SWeather::Default()
@@ -154,6 +154,7 @@ public:
 	C4IDList Rules;
 
 	uint32_t FoWColor; // color of FoW; may contain transparency
+	int32_t PathfinderSteps; // ray execution rounds per frame for command path searches; 0 = search to completion at once
 
 	C4SRealism Realism;
 
@@ -243,6 +244,7 @@ public:
 	int32_t FoWRes; // chunk size of FoGOfWar
 	bool ShadeMaterials;
 	bool EnableTextureOverlays;
+	int32_t MaxPXS; // maximum number of loose pixels in the landscape
 
 public:
 	void Default();
@@ -81,12 +81,12 @@ inline const static char *FnStringPar(const C4String *const pString)
 
 inline C4String *String(const char *str)
 {
-	return str ? new C4String((str), &Game.ScriptEngine.Strings) : nullptr;
+	return str ? Game.ScriptEngine.Strings.RegString(str) : nullptr;
 }
 
 inline C4String *String(StdStrBuf &&str)
 {
-	return str ? new C4String(std::forward<StdStrBuf>(str), &Game.ScriptEngine.Strings) : nullptr;
+	return str ? Game.ScriptEngine.Strings.RegString(std::forward<StdStrBuf>(str)) : nullptr;
 }
 
 static std::string FnStringFormat(C4AulContext *cthr, const char *szFormatPar, C4Value *Par0 = nullptr, C4Value *Par1 = nullptr, C4Value *Par2 = nullptr, C4Value *Par3 = nullptr,
@@ -2084,100 +2084,44 @@ static C4Object *FnFindBase(C4AulContext *cthr, C4ValueInt iOwner, C4ValueInt iI
 	return Game.FindBase(iOwner, iIndex);
 }
 
-C4FindObject *CreateCriterionsFromPars(const C4Value *pPars, C4FindObject **pFOs, C4SortObject **pSOs)
-{
-	int i, iCnt = 0, iSortCnt = 0;
-	// Read all parameters
-	for (i = 0; i < C4AUL_MAX_Par; i++)
-	{
-		const C4Value &Data = pPars[i].GetRefVal();
-		// No data given?
-		if (!Data) break;
-		// Construct
-		C4SortObject *pSO = nullptr;
-		C4FindObject *pFO = C4FindObject::CreateByValue(Data, pSOs ? &pSO : nullptr);
-		// Add FindObject
-		if (pFO)
-		{
-			pFOs[iCnt++] = pFO;
-		}
-		// Add SortObject
-		if (pSO)
-		{
-			pSOs[iSortCnt++] = pSO;
-		}
-	}
-	// No criterions?
-	if (!iCnt)
-	{
-		for (i = 0; i < iSortCnt; ++i) delete pSOs[i];
-		return nullptr;
-	}
-	// create sort criterion
-	C4SortObject *pSO = nullptr;
-	if (iSortCnt)
-	{
-		if (iSortCnt == 1)
-			pSO = pSOs[0];
-		else
-			pSO = new C4SortObjectMultiple(iSortCnt, pSOs, false);
-	}
-	// Create search object
-	C4FindObject *pFO;
-	if (iCnt == 1)
-		pFO = pFOs[0];
-	else
-		pFO = new C4FindObjectAnd(iCnt, pFOs, false);
-	if (pSO) pFO->SetSort(pSO);
-	return pFO;
-}
+// Search criteria of the recent calls, so hot script loops don't rebuild them every time
+static C4FindObjectCache FindObjectCache;
 
 static C4Value FnObjectCount2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, nullptr);
+	// Get FindObject-structure
+	const auto criteria = FindObjectCache.Bind(pPars, false);
 	// Error?
-	if (!pFO)
+	if (!criteria)
 		throw C4AulExecError(cthr->Obj, "ObjectCount: No valid search criterions supplied!");
 	// Search
-	int32_t iCnt = pFO->Count(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
+	int32_t iCnt = criteria->Count(Game.Objects, Game.Objects.Sectors);
 	// Return
 	return C4VInt(iCnt);
 }
 
 static C4Value FnFindObject2(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	const auto criteria = FindObjectCache.Bind(pPars, true);
 	// Error?
-	if (!pFO)
+	if (!criteria)
 		throw C4AulExecError(cthr->Obj, "FindObject: No valid search criterions supplied!");
 	// Search
-	C4Object *pObj = pFO->Find(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
+	C4Object *pObj = criteria->Find(Game.Objects, Game.Objects.Sectors);
 	// Return
 	return C4VObj(pObj);
 }
 
 static C4Value FnFindObjects(C4AulContext *cthr, const C4Value *pPars)
 {
-	// Create FindObject-structure
-	C4FindObject *pFOs[C4AUL_MAX_Par];
-	C4SortObject *pSOs[C4AUL_MAX_Par];
-	C4FindObject *pFO = CreateCriterionsFromPars(pPars, pFOs, pSOs);
+	// Get FindObject-structure
+	const auto criteria = FindObjectCache.Bind(pPars, true);
 	// Error?
-	if (!pFO)
+	if (!criteria)
 		throw C4AulExecError(cthr->Obj, "FindObjects: No valid search criterions supplied!");
 	// Search
-	C4ValueArray *pResult = pFO->FindMany(Game.Objects, Game.Objects.Sectors);
-	// Free
-	delete pFO;
+	C4ValueArray *pResult = criteria->FindMany(Game.Objects, Game.Objects.Sectors);
 	// Return
 	return C4VArray(pResult);
 }
@@ -5292,8 +5236,8 @@ static bool FnFightWith(C4AulContext *ctx, C4Object *pTarget, C4Object *pClonk)
 	// check OCF
 	if (~(pTarget->OCF & pClonk->OCF) & OCF_FightReady) return false;
 	// RejectFight callback
-	if (pTarget->Call(PSF_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
-	if (pClonk->Call(PSF_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
+	if (pTarget->Call(PSC_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
+	if (pClonk->Call(PSC_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
 	// begin fighting
 	ObjectActionFight(pClonk, pTarget);
 	ObjectActionFight(pTarget, pClonk);
@@ -6144,7 +6088,7 @@ static void FnStartCallTrace(C4AulContext *ctx)
 	C4AulStartTrace();
 }
 
-static bool FnStartScriptProfiler(C4AulContext *ctx, C4ID idScript)
+static bool FnStartScriptProfiler(C4AulContext *ctx, C4ID idScript, bool fBytecode)
 {
 	// get script to profile
 	C4AulScript *pScript;
@@ -6157,7 +6101,7 @@ static bool FnStartScriptProfiler(C4AulContext *ctx, C4ID idScript)
 	else
 		pScript = &Game.ScriptEngine;
 	// profile it
-	C4AulProfiler::StartProfiling(pScript);
+	C4AulProfiler::StartProfiling(pScript, fBytecode);
 	return true;
 }
 
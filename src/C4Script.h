@@ -20,6 +20,8 @@
 
 #include "C4Value.h"
 
+#include <cstddef>
+
 class C4AulScriptEngine;
 
 // ** a definition of a script constant
@@ -32,6 +34,21 @@ struct C4ScriptConstDef
 
 void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 
+// engine callback whose function is resolved once per script and link instead of on every call
+class C4ScriptCallback
+{
+public:
+	explicit C4ScriptCallback(const char *name) noexcept : Name{name}, Index{Count++} {}
+
+	C4ScriptCallback(const C4ScriptCallback &) = delete;
+	C4ScriptCallback &operator=(const C4ScriptCallback &) = delete;
+
+	const char *const Name;
+	const std::size_t Index; // index into C4ScriptHost's callback cache
+
+	static inline std::size_t Count{0};
+};
+
 /* Engine-Calls */
 
 #define PSF_Script                 "~Script{}"
@@ -123,6 +140,18 @@ void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 #define PSF_OnTeamSwitch           "~OnTeamSwitch" // int iPlr1, int idNewTeam, int idOldTeam
 #define PSF_OnOwnerRemoved         "~OnOwnerRemoved"
 
+// Callbacks that are performed very often
+inline const C4ScriptCallback PSC_Hit{PSF_Hit};
+inline const C4ScriptCallback PSC_Hit2{PSF_Hit2};
+inline const C4ScriptCallback PSC_Hit3{PSF_Hit3};
+inline const C4ScriptCallback PSC_CatchBlow{PSF_CatchBlow};
+inline const C4ScriptCallback PSC_QueryCatchBlow{PSF_QueryCatchBlow};
+inline const C4ScriptCallback PSC_Stuck{PSF_Stuck};
+inline const C4ScriptCallback PSC_RejectCollection{PSF_RejectCollection};
+inline const C4ScriptCallback PSC_RejectContents{PSF_RejectContents};
+inline const C4ScriptCallback PSC_RejectEntrance{PSF_RejectEntrance};
+inline const C4ScriptCallback PSC_RejectFight{PSF_RejectFight};
+
 // Fx{} is automatically prefixed
 #define PSFS_FxAdd  "Add" // C4Object *pTarget, int iEffectNumber, C4String *szNewEffect, int iNewTimer, C4Value vNewEffectVar1, C4Value vNewEffectVar2, C4Value vNewEffectVar3, C4Value vNewEffectVar4
 #define PSFS_FxInfo "Info" // C4Object *pTarget, int iEffectNumber
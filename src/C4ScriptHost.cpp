@@ -118,28 +118,61 @@ void C4ScriptHost::GetControlMethodMask(const std::format_string<const char *> f
 	}
 }
 
-C4Value C4ScriptHost::FunctionCall(C4Object *pCaller, const char *szFunction, C4Object *pObj, const C4AulParSet &Pars, bool fPrivateCall, bool fPassError, bool convertNilToIntBool)
+C4AulAccess C4ScriptHost::GetCallAccess(C4Object *pCaller, C4Object *pObj, bool fPrivateCall)
 {
-	// get needed access
-	C4AulAccess Acc = AA_PRIVATE;
 	if (pObj && (pObj != pCaller) && !fPrivateCall)
 	{
-		if (pCaller)
-		{
-			Acc = AA_PUBLIC;
-		}
-		else
-		{
-			Acc = AA_PROTECTED;
-		}
+		return pCaller ? AA_PUBLIC : AA_PROTECTED;
 	}
+	return AA_PRIVATE;
+}
+
+C4Value C4ScriptHost::FunctionCall(C4Object *pCaller, const char *szFunction, C4Object *pObj, const C4AulParSet &Pars, bool fPrivateCall, bool fPassError, bool convertNilToIntBool)
+{
 	// get function
 	C4AulScriptFunc *pFn;
-	if (!(pFn = GetSFunc(szFunction, Acc))) return C4VNull;
+	if (!(pFn = GetSFunc(szFunction, GetCallAccess(pCaller, pObj, fPrivateCall)))) return C4VNull;
 	// Call code
 	return pFn->Exec(pObj, Pars, fPassError, true, convertNilToIntBool);
 }
 
+C4Value C4ScriptHost::ObjectCall(C4Object *pCaller, C4Object *pObj, const C4ScriptCallback &callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	C4AulScriptFunc *pFn;
+	if (!(pFn = GetCallbackFunc(callback, GetCallAccess(pCaller, pObj, false)))) return C4VNull;
+	return pFn->Exec(pObj, pPars, fPassError, true, convertNilToIntBool);
+}
+
+C4AulScriptFunc *C4ScriptHost::GetCallbackFunc(const C4ScriptCallback &callback, C4AulAccess AccNeeded)
+{
+	// scripts have been relinked: functions might have been deleted
+	if (Engine && CallbackLinkCounter != Engine->LinkCounter)
+	{
+		CallbackFuncs.clear();
+		CallbackLinkCounter = Engine->LinkCounter;
+	}
+	if (CallbackFuncs.size() <= callback.Index) CallbackFuncs.resize(C4ScriptCallback::Count);
+
+	auto &cached = CallbackFuncs[callback.Index];
+	if (cached)
+	{
+		++C4AulProfiler::CallbackLookupsCached;
+	}
+	else
+	{
+		cached = GetSFunc(callback.Name);
+		++C4AulProfiler::CallbackLookupsResolved;
+	}
+
+	C4AulScriptFunc *const pFn{*cached};
+	// let the regular lookup report undefined functions and insufficient access
+	if (pFn ? pFn->Access < AccNeeded : *callback.Name != '~')
+	{
+		return GetSFunc(callback.Name, AccNeeded);
+	}
+	return pFn;
+}
+
 bool C4ScriptHost::ReloadScript(const char *szPath)
 {
 	// this?
@@ -22,6 +22,10 @@
 
 #include <C4Aul.h>
 
+#include <cstdint>
+#include <optional>
+#include <vector>
+
 // generic script host for objects
 class C4ScriptHost : public C4AulScript, public C4ComponentHost
 {
@@ -46,17 +50,27 @@ public:
 		return FunctionCall(pCaller, szFunction, pObj, pPars, false, fPassError, convertNilToIntBool);
 	}
 
+	C4Value ObjectCall(C4Object *pCaller, C4Object *pObj, const C4ScriptCallback &callback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
+
 	C4Value Call(const char *szFunction, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true)
 	{
 		if (!szFunction) return C4VNull;
 		return FunctionCall(nullptr, szFunction, nullptr, pPars, false, fPassError, convertNilToIntBool);
 	}
 
+	C4AulScriptFunc *GetCallbackFunc(const C4ScriptCallback &callback, C4AulAccess AccNeeded); // get function, resolving it by name only once per link
+
 protected:
 	class C4LangStringTable *pStringTable;
 	void MakeScript();
 	C4Value FunctionCall(C4Object *pCaller, const char *szFunction, C4Object *pObj, const C4AulParSet &pPars = C4AulParSet{}, bool fPrivateCall = false, bool fPassError = false, bool convertNilToIntBool = true);
 	bool ReloadScript(const char *szPath) override;
+
+private:
+	static C4AulAccess GetCallAccess(C4Object *pCaller, C4Object *pObj, bool fPrivateCall);
+
+	std::vector<std::optional<C4AulScriptFunc *>> CallbackFuncs; // indexed by C4ScriptCallback::Index; nullopt if not resolved yet
+	std::uint32_t CallbackLinkCounter{0}; // C4AulScriptEngine::LinkCounter when CallbackFuncs were resolved
 };
 
 // script host for defs
@@ -24,6 +24,42 @@
 #include <C4Log.h>
 #include <C4Record.h>
 
+#include <algorithm>
+
+/* sector object list */
+
+void C4LSectorObjectList::Clear()
+{
+	C4ObjectList::Clear();
+	FlatObjects.clear();
+}
+
+std::vector<C4Object *>::iterator C4LSectorObjectList::FindFlat(C4Object *pObj)
+{
+	// objects are in a list at most once, so the object identifies its link
+	const auto it = std::find(FlatObjects.begin(), FlatObjects.end(), pObj);
+	assert(it != FlatObjects.end());
+	return it;
+}
+
+void C4LSectorObjectList::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4ObjectList::InsertLinkBefore(pLink, pBefore);
+	FlatObjects.insert(pBefore ? FindFlat(pBefore->Obj) : FlatObjects.end(), pLink->Obj);
+}
+
+void C4LSectorObjectList::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4ObjectList::InsertLink(pLink, pAfter);
+	FlatObjects.insert(pAfter ? FindFlat(pAfter->Obj) + 1 : FlatObjects.begin(), pLink->Obj);
+}
+
+void C4LSectorObjectList::RemoveLink(C4ObjectLink *pLnk)
+{
+	C4ObjectList::RemoveLink(pLnk);
+	FlatObjects.erase(FindFlat(pLnk->Obj));
+}
+
 /* sector */
 
 void C4LSector::Init(int ix, int iy)
@@ -21,6 +21,8 @@
 
 #include <C4ObjectList.h>
 
+#include <vector>
+
 // class predefs
 class C4LSector;
 class C4LSectors;
@@ -30,6 +32,27 @@ class C4LArea;
 const int32_t C4LSectorWdt = 50,
               C4LSectorHgt = 50;
 
+// object list of a sector, which can additionally be traversed as a flat array
+class C4LSectorObjectList : public C4ObjectList
+{
+	std::vector<C4Object *> FlatObjects; // list contents in list order; updated along with the list
+
+public:
+	void Clear();
+
+	// objects in list order; the array changes along with the list,
+	// so callers that may change sector lists while traversing (e.g. by calling script) must iterate over a copy
+	const std::vector<C4Object *> &GetFlat() const { return FlatObjects; }
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore) override;
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter) override;
+	virtual void RemoveLink(C4ObjectLink *pLnk) override;
+
+private:
+	std::vector<C4Object *>::iterator FindFlat(C4Object *pObj);
+};
+
 // one of those object list sectors
 class C4LSector
 {
@@ -44,8 +67,8 @@ protected:
 public:
 	int x, y; // pos
 
-	C4ObjectList Objects; // objects within this sector
-	C4ObjectList ObjectShapes; // objects with shapes that overlap this sector
+	C4LSectorObjectList Objects; // objects within this sector
+	C4LSectorObjectList ObjectShapes; // objects with shapes that overlap this sector
 
 	void CompileFunc(StdCompiler *pComp);
 
@@ -77,6 +77,8 @@ void C4String::Reg(C4StringTable *pnTable)
 		pnTable->First = this;
 	pnTable->Last = this;
 
+	pnTable->Index.emplace(std::string_view{Data.getData(), Data.getLength()}, this);
+
 	pTable = pnTable;
 }
 
@@ -84,6 +86,9 @@ void C4String::UnReg()
 {
 	if (!pTable) return;
 
+	if (const auto it = pTable->Index.find({Data.getData(), Data.getLength()}); it != pTable->Index.end() && it->second == this)
+		pTable->Index.erase(it);
+
 	if (Next)
 		Next->Prev = Prev;
 	else
@@ -101,6 +106,12 @@ void C4String::UnReg()
 		delete this;
 }
 
+bool C4String::Equals(const C4String *const first, const C4String *const second)
+{
+	if (first && second) return *first == *second;
+	return SEqual(first ? first->Data.getData() : "", second ? second->Data.getData() : "");
+}
+
 // *** C4StringTable
 
 C4StringTable::C4StringTable()
@@ -115,19 +126,17 @@ C4StringTable::~C4StringTable()
 
 void C4StringTable::Clear()
 {
-	bool bContinue;
-	do
+	// release all hold strings
+	// (strings that are still referenced stay registered, so they remain unique)
+	for (C4String *pAct = First, *pNext; pAct; pAct = pNext)
 	{
-		bContinue = false;
-		// find string to delete / unreg
-		for (C4String *pAct = First; pAct; pAct = pAct->Next)
-			if (pAct->Hold)
-			{
-				pAct->UnReg();
-				bContinue = true;
-				break;
-			}
-	} while (bContinue);
+		pNext = pAct->Next;
+		if (!pAct->Hold) continue;
+		if (pAct->iRefCnt > 0)
+			pAct->Hold = false;
+		else
+			pAct->UnReg();
+	}
 }
 
 int C4StringTable::EnumStrings()
@@ -157,15 +166,21 @@ int C4StringTable::EnumStrings()
 
 C4String *C4StringTable::RegString(const char *strString)
 {
+	if (C4String *const pString = FindString(strString)) return pString;
 	return new C4String(strString, this);
 }
 
+C4String *C4StringTable::RegString(StdStrBuf &&strString)
+{
+	if (const auto it = Index.find({strString.getData(), strString.getLength()}); it != Index.end()) return it->second;
+	return new C4String(std::move(strString), this);
+}
+
 C4String *C4StringTable::FindString(const char *strString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (SEqual(pAct->Data.getData(), strString))
-			return pAct;
-	return nullptr;
+	if (!strString) return nullptr;
+	const auto it = Index.find(strString);
+	return it != Index.end() ? it->second : nullptr;
 }
 
 C4String *C4StringTable::FindString(C4String *pString)
@@ -186,12 +201,11 @@ C4String *C4StringTable::FindString(int iEnumID)
 
 C4String *C4StringTable::FindSaveString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	// registered strings are unique, so there is at most one candidate
+	const auto it = Index.find({pString->Data.getData(), pString->Data.getLength()});
+	if (it != Index.end() && (!it->second->Hold || it->second->iRefCnt))
 	{
-		if (SEqual(pAct->Data.getData(), pString->Data.getData()) && (!pAct->Hold || pAct->iRefCnt))
-		{
-			return pAct;
-		}
+		return it->second;
 	}
 
 	return nullptr;
@@ -209,9 +223,7 @@ bool C4StringTable::Load(C4Group &ParentGroup)
 	{
 		SReplaceChar(strBuf, 0x0D, 0x00);
 		// add string to list
-		C4String *pnString;
-		if (!(pnString = FindString(strBuf)))
-			pnString = RegString(strBuf);
+		C4String *pnString = RegString(strBuf);
 		pnString->iEnumID = i;
 	}
 	// delete data
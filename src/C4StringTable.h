@@ -20,14 +20,19 @@
 
 #include "StdBuf.h"
 
+#include <string_view>
+#include <unordered_map>
+
 class C4StringTable;
 class C4Group;
 
 class C4String
 {
-public:
+	// strings are interned, use C4StringTable::RegString to create them
 	C4String(StdStrBuf &&strString, C4StringTable *pTable);
 	C4String(const char *strString, C4StringTable *pTable);
+
+public:
 	virtual ~C4String();
 
 	// increment/decrement reference count on this string
@@ -46,6 +51,13 @@ public:
 
 	void Reg(C4StringTable *pTable);
 	void UnReg();
+
+	// strings registered in the same table are unique, so only unregistered ones need to be compared by contents
+	bool operator==(const C4String &other) const { return this == &other || ((!pTable || pTable != other.pTable) && Data == other.Data); }
+	// nullptr is treated like the empty string
+	static bool Equals(const C4String *first, const C4String *second);
+
+	friend class C4StringTable;
 };
 
 class C4StringTable
@@ -57,6 +69,7 @@ public:
 	void Clear();
 
 	C4String *RegString(const char *strString);
+	C4String *RegString(StdStrBuf &&strString);
 	C4String *FindString(const char *strString);
 	C4String *FindString(C4String *pString);
 	C4String *FindString(int iEnumID);
@@ -68,4 +81,9 @@ public:
 	bool Save(C4Group &ParentGroup);
 
 	C4String *First, *Last; // string list
+
+private:
+	std::unordered_map<std::string_view, C4String *> Index; // registered strings by contents
+
+	friend class C4String;
 };
@@ -30,11 +30,14 @@
 #include <StdPNG.h>
 #include "C4ResStrTable.h"
 #include <StdDDraw2.h>
+#include "C4ThreadPool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <string>
 
 C4Surface::C4Surface() : fIsBackground(false)
 {
@@ -954,22 +957,35 @@ bool C4Surface::Load(C4Group &hGroup, const char *szFilename, bool fOwnPal, bool
 	return fSuccess;
 }
 
+static std::unique_ptr<StdBitmap> DecodePNG(const void *const fileContents, const std::size_t fileSize, bool &useAlpha)
+{
+	CPNGFile png(fileContents, fileSize);
+	useAlpha = png.UsesAlpha();
+	auto bmp = std::make_unique<StdBitmap>(png.Width(), png.Height(), useAlpha);
+	png.Decode(bmp->GetBytes());
+	return bmp;
+}
+
+struct C4PNGPreloader::Image
+{
+	C4GroupEntryView FileContents; // freed once decoded
+	std::unique_ptr<StdBitmap> Bitmap;
+	bool UsesAlpha{false};
+	std::string Error;
+	std::atomic_bool Done{false};
+};
+
 bool C4Surface::ReadPNG(C4Group &hGroup)
 {
-	// create mem block
-	int iSize = hGroup.AccessedEntrySize();
-	std::unique_ptr<uint8_t[]> pData(new uint8_t[iSize]);
-	// load file into mem
-	hGroup.Read(pData.get(), iSize);
+	// map or load file into mem
+	C4GroupEntryView data;
+	if (!hGroup.ReadAccessedEntry(data)) return false;
 	// load as png file
 	std::unique_ptr<StdBitmap> bmp;
-	std::uint32_t width, height; bool useAlpha;
+	bool useAlpha{false};
 	try
 	{
-		CPNGFile png(pData.get(), iSize);
-		width = png.Width(); height = png.Height(), useAlpha = png.UsesAlpha();
-		bmp.reset(new StdBitmap(width, height, useAlpha));
-		png.Decode(bmp->GetBytes());
+		bmp = DecodePNG(data.getData(), data.getSize(), useAlpha);
 	}
 	catch (const std::runtime_error &e)
 	{
@@ -977,9 +993,28 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 		bmp.reset();
 	}
 	// free file data
-	pData.reset();
+	data.Clear();
 	// abort if loading wasn't successful
 	if (!bmp) return false;
+	return CreateFromBitmap(*bmp, useAlpha);
+}
+
+bool C4Surface::LoadPNG(C4Group &hGroup, const char *szFilename)
+{
+	const auto image = C4PNGPreloader::Active ? C4PNGPreloader::Active->Take(hGroup, szFilename) : nullptr;
+	if (!image) return hGroup.AccessEntry(szFilename) && ReadPNG(hGroup);
+	// already decoded on the thread pool
+	if (!image->Bitmap)
+	{
+		LogNTr(spdlog::level::err, "Could not create surface from PNG file: {}", image->Error);
+		return false;
+	}
+	return CreateFromBitmap(*image->Bitmap, image->UsesAlpha);
+}
+
+bool C4Surface::CreateFromBitmap(const StdBitmap &bmp, const bool useAlpha)
+{
+	const std::uint32_t width{bmp.GetWidth()}, height{bmp.GetHeight()};
 	// create surface(s) - do not create an 8bit-buffer!
 	if (!Create(width, height)) return false;
 	// lock for writing data
@@ -1008,7 +1043,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Optimize the easy case of a png in the same format as the display
 				// 32 bit
 				uint32_t *pPix = reinterpret_cast<uint32_t *>((reinterpret_cast<char *>(pTexRef->texLock.pBits)) + iY * pTexRef->texLock.Pitch);
-				memcpy(pPix, static_cast<const std::uint32_t *>(bmp->GetPixelAddr32(0, rY)) +
+				memcpy(pPix, static_cast<const std::uint32_t *>(bmp.GetPixelAddr32(0, rY)) +
 					tX * iTexSize, maxX * 4);
 				int iX = maxX;
 				while (iX--) { if (reinterpret_cast<uint8_t *>(pPix)[3] == 0xff) *pPix = 0xff000000; ++pPix; }
@@ -1019,7 +1054,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				// Loop through every pixel and convert
 				for (int iX = 0; iX < maxX; ++iX)
 				{
-					uint32_t dwCol = bmp->GetPixel(iX + tX * iTexSize, rY);
+					uint32_t dwCol = bmp.GetPixel(iX + tX * iTexSize, rY);
 					// if color is fully transparent, ensure it's black
 					if (dwCol >> 24 == 0xff) dwCol = 0xff000000;
 					// set pix in surface
@@ -1068,6 +1103,52 @@ bool C4Surface::Copy(C4Surface &fromSfc)
 	return true;
 }
 
+C4PNGPreloader::C4PNGPreloader(C4Group &group) : group{group}, previous{Active}
+{
+	Active = this;
+}
+
+C4PNGPreloader::~C4PNGPreloader()
+{
+	// images that are still being decoded are freed by their jobs
+	Active = previous;
+}
+
+void C4PNGPreloader::Add(const char *const filename)
+{
+	auto image = std::make_shared<Image>();
+	if (!group.LoadEntry(filename, image->FileContents)) return;
+	images.emplace_back(filename, image);
+
+	C4ThreadPool::Global->SubmitCallback([image{std::move(image)}]
+	{
+		try
+		{
+			image->Bitmap = DecodePNG(image->FileContents.getData(), image->FileContents.getSize(), image->UsesAlpha);
+		}
+		catch (const std::runtime_error &e)
+		{
+			image->Error = e.what();
+		}
+		image->FileContents.Clear();
+		image->Done.store(true, std::memory_order_release);
+		image->Done.notify_all();
+	});
+}
+
+std::shared_ptr<C4PNGPreloader::Image> C4PNGPreloader::Take(C4Group &group, const char *const filename)
+{
+	if (&group != &this->group) return nullptr;
+
+	const auto it = std::ranges::find_if(images, [filename](const auto &entry) { return SEqualNoCase(entry.first.c_str(), filename); });
+	if (it == images.end()) return nullptr;
+
+	const std::shared_ptr<Image> image{std::move(it->second)};
+	images.erase(it);
+	image->Done.wait(false, std::memory_order_acquire);
+	return image;
+}
+
 bool C4Surface::ReadJPEG(C4Group &hGroup)
 {
 	// create mem block
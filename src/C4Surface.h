@@ -28,7 +28,11 @@
 #endif
 
 #include <list>
+#include <memory>
 #include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 // config settings
 #define C4GFXCFG_NO_ALPHA_ADD    1
@@ -119,11 +123,13 @@ public:
 	bool SavePNG(C4Group &hGroup, const char *szFilename, bool fSaveAlpha = true, bool fApplyGamma = false, bool fSaveOverlayOnly = false);
 	bool Copy(C4Surface &fromSfc);
 	bool ReadPNG(C4Group &hGroup);
+	bool LoadPNG(C4Group &hGroup, const char *szFilename); // takes the image from C4PNGPreloader::Active if it has been preloaded
 	bool ReadJPEG(C4Group &hGroup);
 	std::optional<StdBitmap> CloneToBitmap(bool withAlpha, bool applyGamma, bool overlayOnly, float scale);
 
 private:
 	bool CreateTextures(); // create ppTex-array
+	bool CreateFromBitmap(const StdBitmap &bmp, bool useAlpha); // create surface and copy decoded PNG pixels
 	void FreeTextures(); // free ppTex-array if existent
 
 	friend class CStdDDraw;
@@ -155,6 +161,32 @@ private:
 	bool IsSingleSurface() const { return iTexX * iTexY == 1; } // return whether surface is not split
 };
 
+// Decodes the PNG files of a group on the thread pool while C4Surface::LoadPNG creates the surfaces of the previous ones.
+// Each file is read once in the order of the group; images that haven't been taken are freed with the preloader.
+class C4PNGPreloader
+{
+public:
+	struct Image;
+
+public:
+	explicit C4PNGPreloader(C4Group &group); // becomes the active preloader until destruction
+	~C4PNGPreloader();
+
+	C4PNGPreloader(const C4PNGPreloader &) = delete;
+	C4PNGPreloader &operator=(const C4PNGPreloader &) = delete;
+
+	void Add(const char *filename); // read the entry and start decoding it on the thread pool
+	std::shared_ptr<Image> Take(C4Group &group, const char *filename); // wait for and remove the image of an added entry; nullptr otherwise
+
+private:
+	C4Group &group;
+	C4PNGPreloader *const previous;
+	std::vector<std::pair<std::string, std::shared_ptr<Image>>> images;
+
+public:
+	static inline C4PNGPreloader *Active{nullptr}; // consulted by C4Surface::LoadPNG if set
+};
+
 struct D3DLOCKED_RECT
 {
 	int Pitch;
@@ -0,0 +1,57 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2026, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Cheap, platform-independent hashes of synchronized game state for sync checks */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+// number of regions the landscape and object hashes are split into in each sync check
+constexpr int32_t C4SyncCheckRegions = 16;
+
+// first position of a region if count positions (object numbers, tile rows) are split into C4SyncCheckRegions regions
+constexpr int32_t C4SyncCheckRegionBegin(int32_t count, int32_t region)
+{
+	return static_cast<int32_t>((int64_t{count} * region + C4SyncCheckRegions - 1) / C4SyncCheckRegions);
+}
+
+// region of a position, so that C4SyncCheckRegionBegin(count, region) <= pos < C4SyncCheckRegionBegin(count, region + 1)
+// positions outside of [0, count) go to the first or last region
+constexpr int32_t C4SyncCheckRegionOf(int64_t pos, int32_t count)
+{
+	if (pos <= 0 || count <= 0) return 0;
+	return static_cast<int32_t>(std::min<int64_t>(pos * C4SyncCheckRegions / count, C4SyncCheckRegions - 1));
+}
+
+// scramble a key into a well-distributed 32 bit hash (splitmix64 finalizer)
+constexpr uint32_t C4SyncHashMix(uint64_t key)
+{
+	key ^= key >> 30; key *= 0xbf58476d1ce4e5b9;
+	key ^= key >> 27; key *= 0x94d049bb133111eb;
+	key ^= key >> 31;
+	return static_cast<uint32_t>(key);
+}
+
+// hash a sequence of values; set hashes are built by adding up their element hashes,
+// so elements can be added and removed incrementally in any order
+template<typename... Args>
+constexpr uint32_t C4SyncHashOf(Args... values)
+{
+	uint32_t hash{0};
+	((hash = C4SyncHashMix((uint64_t{hash} << 32) | static_cast<uint32_t>(values))), ...);
+	return hash;
+}
@@ -55,6 +55,7 @@ C4TransferZones::~C4TransferZones()
 void C4TransferZones::Default()
 {
 	First = nullptr;
+	Revision = 0;
 }
 
 void C4TransferZones::Clear()
@@ -62,6 +63,7 @@ void C4TransferZones::Clear()
 	C4TransferZone *pZone, *pNext;
 	for (pZone = First; pZone; pZone = pNext) { pNext = pZone->Next; delete pZone; }
 	First = nullptr;
+	Revision++;
 }
 
 void C4TransferZones::ClearPointers(C4Object *pObj)
@@ -82,6 +84,7 @@ bool C4TransferZones::Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	// Update existing zone
 	if ((pZone = Find(pObj)))
 	{
+		if (pZone->X != iX || pZone->Y != iY || pZone->Wdt != iWdt || pZone->Hgt != iHgt) Revision++;
 		pZone->X = iX; pZone->Y = iY;
 		pZone->Wdt = iWdt; pZone->Hgt = iHgt;
 	}
@@ -102,6 +105,7 @@ bool C4TransferZones::Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	pZone->Object = pObj;
 	pZone->Next = First;
 	First = pZone;
+	Revision++;
 	// Success
 	return true;
 }
@@ -158,6 +162,7 @@ int32_t C4TransferZones::RemoveNullZones()
 		else
 			pPrev = pZone;
 	}
+	if (iResult) Revision++;
 	return iResult;
 }
 
@@ -57,6 +57,7 @@ public:
 protected:
 	int32_t RemoveNullZones();
 	C4TransferZone *First;
+	uint32_t Revision; // increased whenever a zone is added, changed or removed
 
 public:
 	void Default();
@@ -69,4 +70,5 @@ public:
 	C4TransferZone *Find(int32_t iX, int32_t iY);
 	bool Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 	bool Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
+	uint32_t GetRevision() const { return Revision; }
 };
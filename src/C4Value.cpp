@@ -670,14 +670,14 @@ C4Value C4VString(const char *strString)
 {
 	// safety
 	if (!strString) return C4Value();
-	return C4Value(new C4String(strString, &Game.ScriptEngine.Strings));
+	return C4Value(Game.ScriptEngine.Strings.RegString(strString));
 }
 
 C4Value C4VString(StdStrBuf &&Str)
 {
 	// safety
 	if (Str.isNull()) return C4Value();
-	return C4Value(new C4String(std::forward<StdStrBuf>(Str), &Game.ScriptEngine.Strings));
+	return C4Value(Game.ScriptEngine.Strings.RegString(std::forward<StdStrBuf>(Str)));
 }
 
 void C4Value::DenumeratePointer()
@@ -845,7 +845,7 @@ bool C4Value::Equals(const C4Value &other, C4AulScriptStrict strict) const
 				case C4V_Bool:
 					return _getBool() == other._getBool();
 				case C4V_String:
-					return Data.Str->Data == other.Data.Str->Data;
+					return *Data.Str == *other.Data.Str;
 				case C4V_Array:
 					return *Data.Array == *other.Data.Array;
 				case C4V_Map:
@@ -906,7 +906,7 @@ bool C4Value::operator==(const C4Value &Value2) const
 	case C4V_C4Object:
 		return Data == Value2.Data && Type == Value2.Type;
 	case C4V_String:
-		return Type == Value2.Type && Data.Str->Data == Value2.Data.Str->Data;
+		return Type == Value2.Type && *Data.Str == *Value2.Data.Str;
 	case C4V_Array:
 		return Type == Value2.Type && *(Data.Array) == *(Value2.Data.Array);
 		break;
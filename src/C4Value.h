@@ -276,6 +276,9 @@ protected:
 	C4V_Type Type : 8;
 	bool HasBaseContainer = false;
 
+	// index of the entry of OwningMap that this value is the key or value of; maintained by C4ValueHash
+	std::uint32_t MapEntry = 0;
+
 	C4Value *GetNextRef() { if (HasBaseContainer) return nullptr; else return NextRef; }
 	C4ValueContainer *GetBaseContainer() { if (HasBaseContainer) return BaseContainer; else return nullptr; }
 
@@ -298,6 +301,7 @@ protected:
 
 	friend class C4Object;
 	friend class C4AulDefFunc;
+	friend class C4ValueHash;
 };
 
 // converter
@@ -17,8 +17,15 @@
 #include "C4ValueHash.h"
 #include "C4StringTable.h"
 
+#include <algorithm>
 #include <optional>
-#include <stdexcept>
+
+static bool KeyEquals(const C4Value &lhs, const C4Value &rhs)
+{
+	return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT);
+}
+
+std::vector<C4ValueHash *> C4ValueHash::pendingCompactions;
 
 C4ValueHash::C4ValueHash() { }
 
@@ -29,6 +36,7 @@ C4ValueHash::C4ValueHash(const C4ValueHash &other)
 
 C4ValueHash::~C4ValueHash()
 {
+	if (compactionPending) std::erase(pendingCompactions, this);
 	clear();
 }
 
@@ -46,52 +54,128 @@ void C4ValueHash::DenumeratePointers()
 	}
 }
 
-void C4ValueHash::removeValue(C4Value *value)
+std::optional<std::size_t> C4ValueHash::findEntry(const C4Value &key, const std::size_t hash) const
 {
-	const auto erase = [this](const auto &it)
-	{
-		keyOrder.erase(it->second.keyOrderIterator);
-		map.erase(it);
-	};
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+	if (slots.empty()) return {};
+
+	const std::size_t mask{slots.size() - 1};
+	for (std::size_t slot{hash & mask}; slots[slot] != EmptySlot; slot = (slot + 1) & mask)
 	{
-		if (&it->first == value)
+		const Entry &entry{entries[slots[slot]]};
+		if (entry.hash == hash && KeyEquals(*entry.key, key))
 		{
-			keyIt = it;
-			emptyValues.push_front(it->second.value);
+			return slots[slot];
 		}
-		else if (it->second.value == value)
+	}
+	return {};
+}
+
+void C4ValueHash::insertSlot(const std::size_t index)
+{
+	const std::size_t mask{slots.size() - 1};
+	std::size_t slot{entries[index].hash & mask};
+	while (slots[slot] != EmptySlot) slot = (slot + 1) & mask;
+	slots[slot] = static_cast<std::uint32_t>(index);
+}
+
+void C4ValueHash::removeEntry(const std::size_t index)
+{
+	// use the stored hash, the key might have changed already
+	const std::size_t mask{slots.size() - 1};
+	std::size_t hole{entries[index].hash & mask};
+	while (slots[hole] != index) hole = (hole + 1) & mask;
+
+	// shift following entries back so that lookups don't need tombstones
+	for (std::size_t slot{(hole + 1) & mask}; slots[slot] != EmptySlot; slot = (slot + 1) & mask)
+	{
+		const std::size_t home{entries[slots[slot]].hash & mask};
+		if (((slot - home) & mask) >= ((slot - hole) & mask))
 		{
-			erase(it++);
-			found = true;
-			continue;
+			slots[hole] = slots[slot];
+			hole = slot;
 		}
-		++it;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) erase(keyIt);
+	slots[hole] = EmptySlot;
+
+	entries[index].key = entries[index].value = nullptr;
+	++removedEntries;
+}
+
+void C4ValueHash::rehash(const std::size_t slotCount)
+{
+	slots.assign(slotCount, EmptySlot);
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i].key) insertSlot(i);
+	}
+}
+
+void C4ValueHash::compact()
+{
+	std::erase_if(entries, [](const Entry &entry) { return !entry.key; });
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		entries[i].key->MapEntry = entries[i].value->MapEntry = static_cast<std::uint32_t>(i);
+	}
+	removedEntries = 0;
+	rehash(slots.size());
+}
+
+void C4ValueHash::CompactPending()
+{
+	for (C4ValueHash *const map : pendingCompactions)
+	{
+		map->compactionPending = false;
+		if (map->removedEntries) map->compact();
+	}
+	pendingCompactions.clear();
+}
+
+void C4ValueHash::removeValue(C4Value *value)
+{
+	// the value knows its entry; if the entry has been removed or compacted away since, there's nothing to do
+	const std::size_t index{value->MapEntry};
+	if (index >= entries.size()) return;
+
+	const Entry &entry{entries[index]};
+	if (entry.key == value)
+	{
+		// the key itself has been cleared, e.g. because its object has been removed
+		emptyValues.push_front(entry.value);
+		removeEntry(index);
+		delete value;
+	}
+	else if (entry.value == value)
+	{
+		removeEntry(index);
+		emptyValues.push_front(value);
+	}
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	return findEntry(key, std::hash<C4Value>{}(key)).has_value();
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
+	for (const auto &entry : entries)
+	{
+		delete entry.key;
+		delete entry.value;
+	}
+	entries.clear();
+	slots.clear();
+	removedEntries = 0;
 	for (auto &value : emptyValues) delete value;
 	emptyValues.clear();
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	for (const auto &entry : other.entries)
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		if (entry.key) (*this)[*entry.key].Set(*entry.value);
 	}
 	return *this;
 }
@@ -100,9 +184,9 @@ bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
 
-	for (const auto &it : map)
+	for (const auto &entry : entries)
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		if (entry.key && (!other.contains(*entry.key) || other[*entry.key] != *entry.value))
 			return false;
 	}
 
@@ -116,78 +200,94 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
+	const std::size_t hash{std::hash<C4Value>{}(key)};
+	if (const auto index = findEntry(key, hash))
 	{
-		return *map.at(key).value;
+		return *entries[*index].value;
 	}
-	catch (const std::out_of_range &)
+
+	if (removedEntries > entries.size() / 2 && !compactionPending)
 	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
+		compactionPending = true;
+		pendingCompactions.push_back(this);
+	}
+	// keep the load factor at or below one half
+	if ((size() + 1) * 2 > slots.size()) rehash(std::max<std::size_t>(8, slots.size() * 2));
 
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
+	C4Value *value;
+	if (emptyValues.empty()) value = C4Value::OfMap(this);
+	else
+	{
+		value = emptyValues.front();
+		emptyValues.pop_front();
 	}
+
+	C4Value *const keyValue{new C4Value(key, this)};
+	keyValue->MapEntry = value->MapEntry = static_cast<std::uint32_t>(entries.size());
+	entries.push_back({hash, keyValue, value});
+	insertSlot(entries.size() - 1);
+	return *value;
 }
 
 const C4Value &C4ValueHash::operator[](const C4Value &key) const
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
+	if (const auto index = findEntry(key, std::hash<C4Value>{}(key)))
 	{
-		return C4VNull;
+		return *entries[*index].value;
 	}
+	return C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	return Iterator(this, 0);
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, SIZE_MAX);
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+bool C4ValueHash::nextEntry(std::size_t &index, C4Value *&key, C4Value *&value)
 {
-	update();
+	for (; index < entries.size(); ++index)
+	{
+		const Entry &entry{entries[index]};
+		if (entry.key)
+		{
+			key = entry.key;
+			value = entry.value;
+			++index;
+			return true;
+		}
+	}
+	return false;
 }
 
-void C4ValueHash::Iterator::update()
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, std::size_t index) : index(index), map(map) { }
+
+std::size_t C4ValueHash::Iterator::position() const
 {
-	if (it != end)
-	{
-		current.emplace(**it, (*map)[**it]);
-	}
-	else
-	{
-		current.reset();
-	}
+	std::size_t i{std::min(index, map->entries.size())};
+	while (i < map->entries.size() && !map->entries[i].key) ++i;
+	return i;
 }
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
-	update();
+	index = position() + 1;
 	return *this;
 }
 
 C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 {
+	index = position();
+	const Entry &entry{map->entries[index]};
+	current.emplace(*entry.key, *entry.value);
 	return *current;
 }
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return position() == other.position();
 }
@@ -18,10 +18,11 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
+#include <cstdint>
 #include <forward_list>
-#include <list>
 #include <memory>
+#include <optional>
+#include <vector>
 
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
@@ -30,37 +31,46 @@ public:
 	using mapped_type = C4Value;
 
 private:
-	struct MapEntry
+	// keys and values are referenced from elsewhere (object pointer lists, script references), so they need stable addresses
+	struct Entry
 	{
+		std::size_t hash;
+		C4Value *key; // nullptr if the entry has been removed
 		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
 	};
 
-	struct KeyEqual
-	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
-	};
+	static constexpr std::uint32_t EmptySlot = UINT32_MAX;
+
+	// entries in insertion order; we need a defined order for network sync
+	std::vector<Entry> entries;
+	// open addressing table with linear probing, containing indices into entries
+	std::vector<std::uint32_t> slots;
+	std::size_t removedEntries = 0;
+	// removed entries are compacted away only once no script is running, because script loops keep indices into entries
+	bool compactionPending = false;
+	static std::vector<C4ValueHash *> pendingCompactions;
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
 	std::forward_list<C4Value *> emptyValues;
 
-	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	std::optional<std::size_t> findEntry(const C4Value &key, std::size_t hash) const;
+	void insertSlot(std::size_t index);
+	void removeEntry(std::size_t index);
+	void rehash(std::size_t slotCount);
+	void compact();
 
 public:
 
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
+		std::size_t index;
 		C4ValueHash *map;
 		std::optional<pair_type> current;
 
-		void update();
+		std::size_t position() const; // skips entries that have been removed since the iterator was advanced
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		Iterator(C4ValueHash *map, std::size_t index);
 
 		Iterator &operator++();
 		pair_type &operator*();
@@ -82,9 +92,14 @@ public:
 	virtual const C4Value &operator[](const C4Value &key) const;
 	Iterator begin();
 	Iterator end();
+	// advances index to the entry after the next one that hasn't been removed; returns false if there is none
+	bool nextEntry(std::size_t &index, C4Value *&key, C4Value *&value);
+
+	static void CompactPending();
 
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { return entries.size() - removedEntries; }
+	auto storedEntries() const { return entries.size(); } // including removed entries that haven't been compacted away yet
 	void clear();
 };
@@ -44,7 +44,7 @@ CStdFile::~CStdFile()
 	Close();
 }
 
-bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable, bool exclusive)
+bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable, bool exclusive, bool seekable)
 {
 	SCopy(szFilename, Name, _MAX_PATH);
 	// Set modes
@@ -54,7 +54,7 @@ bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable
 	{
 		try
 		{
-			writeCompressedFile.reset(new StdGzCompressedFile::Write{szFilename});
+			writeCompressedFile.reset(new StdGzCompressedFile::Write{szFilename, seekable});
 		}
 		catch (const StdGzCompressedFile::Exception &)
 		{
@@ -288,12 +288,29 @@ bool CStdFile::Advance(size_t iOffset)
 		else
 		{
 			if (hFile) return !fseek(hFile, iOffset, SEEK_CUR); // uncompressed: Just skip
+			if (IsSeekable()) return readCompressedFile->Seek(readCompressedFile->Position() + iOffset); // seekable: Jump to the chunk
 			if (LoadBuffer() <= 0) return false; // compressed: Read...
 		}
 	}
 	return true;
 }
 
+bool CStdFile::ChunkBoundary()
+{
+	if (!writeCompressedFile) return true;
+	// the chunk must contain everything written so far
+	if (BufferLoad && !SaveBuffer()) return false;
+	try
+	{
+		writeCompressedFile->ChunkBoundary();
+	}
+	catch (const StdGzCompressedFile::Exception &)
+	{
+		return false;
+	}
+	return true;
+}
+
 bool CStdFile::Save(const char *szFilename, const uint8_t *bpBuf,
 					size_t iSize, bool fCompressed, bool executable, bool exclusive)
 {
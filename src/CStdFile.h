@@ -43,7 +43,7 @@ protected:
 	bool ModeWrite;
 
 public:
-	bool Create(const char *szFileName, bool fCompressed = false, bool fExecutable = false, bool exclusive = false);
+	bool Create(const char *szFileName, bool fCompressed = false, bool fExecutable = false, bool exclusive = false, bool seekable = false);
 	bool Open(const char *szFileName, bool fCompressed = false);
 	bool Append(const char *szFilename); // append (uncompressed only)
 	bool Close();
@@ -54,6 +54,9 @@ public:
 	bool WriteString(const char *szStr);
 	bool Rewind();
 	bool Advance(size_t iOffset);
+	bool IsSeekable() const { return readCompressedFile && readCompressedFile->IsSeekable(); } // compressed file in the seekable format
+	bool ChunkBoundary(); // seekable compressed file: a new independently compressed chunk may start here
+	bool GetStoredRange(size_t position, size_t size, uint64_t &fileOffset) const { return readCompressedFile && readCompressedFile->GetStoredRange(position, size, fileOffset); } // seekable compressed file: file offset of uncompressed data that is stored as is
 	// Single line commands
 	bool Load(const char *szFileName, uint8_t **lpbpBuf,
 		size_t *ipSize = nullptr, int iAppendZeros = 0,
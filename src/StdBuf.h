@@ -106,6 +106,8 @@ protected:
 #endif
 	};
 	size_t iSize;
+	// Allocated size of held data
+	size_t iCapacity{0};
 
 public:
 	// *** Getters
@@ -142,7 +144,7 @@ public:
 		Clear();
 		if (pnData)
 		{
-			fRef = false; pMData = pnData; iSize = inSize;
+			fRef = false; pMData = pnData; iCapacity = iSize = inSize;
 		}
 	}
 
@@ -153,7 +155,7 @@ public:
 		// Do not give out a buffer which someone else will free
 		if (fRef) Copy();
 		void *pMData = getMData();
-		pData = pMData; fRef = true;
+		pData = pMData; fRef = true; iCapacity = 0;
 		return pMData;
 	}
 
@@ -163,7 +165,7 @@ public:
 	void New(size_t inSize)
 	{
 		Clear();
-		pMData = malloc(iSize = inSize);
+		pMData = malloc(iCapacity = iSize = inSize);
 		fRef = false;
 	}
 
@@ -194,8 +196,10 @@ public:
 		// Grow dereferences
 		if (fRef) { Copy(iSize + iGrow); return; }
 		if (!iGrow) return;
-		// Realloc
-		pMData = realloc(pMData, iSize += iGrow);
+		// Realloc geometrically, so repeated appending takes amortized constant time
+		if (iSize + iGrow > iCapacity)
+			pMData = realloc(pMData, iCapacity = (std::max)(iSize + iGrow, iCapacity + iCapacity / 2));
+		iSize += iGrow;
 	}
 
 	// Shrink the buffer
@@ -205,15 +209,17 @@ public:
 		// Shrink dereferences
 		if (fRef) { Copy(iSize - iShrink); return; }
 		if (!iShrink) return;
-		// Realloc
-		pMData = realloc(pMData, iSize -= iShrink);
+		// Only give memory back once most of it is unused
+		iSize -= iShrink;
+		if (iSize < iCapacity / 4)
+			pMData = realloc(pMData, iCapacity = iSize);
 	}
 
 	// Clear buffer
 	void Clear()
 	{
 		if (!fRef) free(pMData);
-		pMData = nullptr; fRef = true; iSize = 0;
+		pMData = nullptr; fRef = true; iSize = 0; iCapacity = 0;
 	}
 
 	// Free buffer that had been grabbed
@@ -306,12 +312,14 @@ public:
 	// take over another buffer's contents
 	void Take(StdBuf &Buf2)
 	{
+		const size_t inCapacity = Buf2.isRef() ? Buf2.getSize() : Buf2.iCapacity;
 		Take(Buf2.GrabPointer(), Buf2.getSize());
+		if (!fRef) iCapacity = inCapacity;
 	}
 
 	void Take(StdBuf &&Buf2)
 	{
-		Take(Buf2.GrabPointer(), Buf2.getSize());
+		Take(Buf2);
 	}
 
 	// * File support
@@ -126,36 +126,61 @@ template <class T>
 void StdCompilerBinWrite::WriteValue(const T &rValue)
 {
 	// Copy data
-	if (fSecondPass)
-		*Buf.getMPtr<T>(iPos) = rValue;
-	iPos += sizeof(rValue);
+	memcpy(Reserve(sizeof(rValue)), &rValue, sizeof(rValue));
 }
 
 void StdCompilerBinWrite::WriteData(const void *pData, size_t iSize)
 {
 	// Copy data
-	if (fSecondPass)
-		Buf.Write(pData, iSize, iPos);
-	iPos += iSize;
+	if (iSize) memcpy(Reserve(iSize), pData, iSize);
 }
 
 void StdCompilerBinWrite::Raw(void *pData, size_t iSize, RawCompileType eType)
 {
-	// Copy data
-	if (fSecondPass)
-		Buf.Write(pData, iSize, iPos);
+	WriteData(pData, iSize);
+}
+
+void *StdCompilerBinWrite::Reserve(size_t iSize)
+{
+	// The scratch buffer grows geometrically and is never shrunk while in use
+	if (iPos + iSize > pScratch->getSize())
+		pScratch->Grow(iPos + iSize - pScratch->getSize());
+	void *pWrite = pScratch->getMPtr(iPos);
 	iPos += iSize;
+	return pWrite;
 }
 
 void StdCompilerBinWrite::Begin()
 {
-	fSecondPass = false; iPos = 0;
+	// Use the thread's arena unless an outer decompilation is still writing to it
+	if (!pScratch)
+	{
+		if (ArenaInUse)
+		{
+			pScratch = &OwnScratch;
+		}
+		else
+		{
+			pScratch = &Arena;
+			ArenaInUse = true;
+		}
+	}
+	Buf.Clear();
+	iPos = 0;
+}
+
+void StdCompilerBinWrite::End()
+{
+	Buf.Ref(pScratch->getData(), iPos);
 }
 
-void StdCompilerBinWrite::BeginSecond()
+StdCompilerBinWrite::~StdCompilerBinWrite()
 {
-	Buf.New(iPos);
-	fSecondPass = true; iPos = 0;
+	if (pScratch == &Arena)
+	{
+		if (Arena.getSize() > ArenaMaxKeptSize) Arena.Clear();
+		ArenaInUse = false;
+	}
 }
 
 // *** StdCompilerBinRead
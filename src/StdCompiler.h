@@ -434,13 +434,12 @@ public:
 class StdCompilerBinWrite : public StdCompiler
 {
 public:
-	// Result
+	~StdCompilerBinWrite();
+
+	// Result (references the scratch buffer, so copy it before the compiler is gone)
 	typedef StdBuf OutT;
 	inline const OutT &getOutput() { return Buf; }
 
-	// Properties
-	virtual bool isDoublePass() override { return true; }
-
 	// Data writers
 	virtual void QWord(int64_t &rInt) override;
 	virtual void QWord(uint64_t &rInt) override;
@@ -458,17 +457,24 @@ public:
 
 	// Passes
 	virtual void Begin() override;
-	virtual void BeginSecond() override;
+	virtual void End() override;
 
 protected:
 	// Process data
-	bool fSecondPass;
 	size_t iPos;
 	StdBuf Buf;
+	StdBuf *pScratch{nullptr}; // data is written here in a single pass
+	StdBuf OwnScratch; // used if an outer decompilation holds the thread's arena
+
+	// Scratch buffer reused by the decompilations of each thread, so it rarely has to grow
+	static inline thread_local StdBuf Arena;
+	static inline thread_local bool ArenaInUse{false};
+	static constexpr size_t ArenaMaxKeptSize{4 * 1024 * 1024}; // larger arenas are freed after use
 
 	// Helpers
 	template <class T> void WriteValue(const T &rValue);
 	void WriteData(const void *pData, size_t iSize);
+	void *Reserve(size_t iSize); // returns the write position for the next iSize bytes
 };
 
 // binary read
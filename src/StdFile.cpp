@@ -25,9 +25,11 @@
 #include <stdio.h>
 #ifdef _WIN32
 #include <direct.h>
+#include "C4Windows.h"
 #endif
 #ifndef _WIN32
 #include <unistd.h>
+#include <sys/mman.h>
 #endif
 #include <errno.h>
 #include <stdlib.h>
@@ -918,3 +920,63 @@ void AdvanceFileLine(FILE *fhnd)
 		if (cread == EOF) { rewind(fhnd); loops++; }
 	} while ((cread != 0x0A) && (loops < 2));
 }
+
+bool StdFileMapping::Map(const char *const filename, const std::uint64_t offset, const std::size_t size)
+{
+	Unmap();
+	if (!size) return false;
+
+#ifdef _WIN32
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	const std::uint64_t viewOffset{offset - offset % systemInfo.dwAllocationGranularity};
+	const std::size_t viewSize{static_cast<std::size_t>(offset - viewOffset) + size};
+
+	const HANDLE file{CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+	if (file == INVALID_HANDLE_VALUE) return false;
+	const HANDLE fileMapping{CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+	CloseHandle(file);
+	if (!fileMapping) return false;
+	// the view keeps the mapping alive
+	void *const mapped{MapViewOfFile(fileMapping, FILE_MAP_READ, static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset), viewSize)};
+	CloseHandle(fileMapping);
+	if (!mapped) return false;
+#else
+	const auto pageSize = static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+	const std::uint64_t viewOffset{offset - offset % pageSize};
+	const std::size_t viewSize{static_cast<std::size_t>(offset - viewOffset) + size};
+
+	const int fd{open(filename, O_RDONLY)};
+	if (fd == -1) return false;
+	struct stat info;
+	if (fstat(fd, &info) || static_cast<std::uint64_t>(info.st_size) < offset + size)
+	{
+		close(fd);
+		return false;
+	}
+	// the mapping stays valid after closing the file
+	void *const mapped{mmap(nullptr, viewSize, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(viewOffset))};
+	close(fd);
+	if (mapped == MAP_FAILED) return false;
+#endif
+
+	view = mapped;
+	this->viewSize = viewSize;
+	data = static_cast<const uint8_t *>(mapped) + (offset - viewOffset);
+	this->size = size;
+	return true;
+}
+
+void StdFileMapping::Unmap()
+{
+	if (!view) return;
+#ifdef _WIN32
+	UnmapViewOfFile(view);
+#else
+	munmap(view, viewSize);
+#endif
+	view = nullptr;
+	viewSize = 0;
+	data = nullptr;
+	size = 0;
+}
@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <ctime>
 
 #include <stdio.h>
@@ -125,5 +127,28 @@ protected:
 #endif
 };
 
+// read-only view of a part of a file mapped into memory
+class StdFileMapping
+{
+public:
+	StdFileMapping() = default;
+	~StdFileMapping() { Unmap(); }
+	StdFileMapping(const StdFileMapping &) = delete;
+	StdFileMapping &operator=(const StdFileMapping &) = delete;
+
+	bool Map(const char *filename, std::uint64_t offset, std::size_t size);
+	void Unmap();
+
+	const void *GetData() const { return data; }
+	std::size_t GetSize() const { return size; }
+	explicit operator bool() const { return data; }
+
+private:
+	void *view{nullptr}; // starts at the allocation granularity boundary before data
+	std::size_t viewSize{0};
+	const void *data{nullptr};
+	std::size_t size{0};
+};
+
 bool ReadFileLine(FILE *fhnd, char *tobuf, int maxlen);
 void AdvanceFileLine(FILE *fhnd);
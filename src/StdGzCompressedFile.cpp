@@ -36,7 +36,16 @@ Read::Read(const std::string &filename)
 
 	try
 	{
-		PrepareInflate();
+		uint8_t magicBytes[2];
+		if (fread(magicBytes, 1, sizeof(magicBytes), file) == sizeof(magicBytes) && std::equal(magicBytes, std::end(magicBytes), C4GroupSeekableMagic))
+		{
+			ReadIndex();
+		}
+		else
+		{
+			rewind(file);
+			PrepareInflate();
+		}
 	}
 	catch (...)
 	{
@@ -135,8 +144,136 @@ void Read::PrepareInflate()
 	gzStreamValid = true;
 }
 
+void Read::ReadIndex()
+{
+	SeekableTrailer trailer;
+	if (fseek(file, 0, SEEK_END)) throw Exception("fseek failed");
+	const auto fileSize = static_cast<uint64_t>(ftell(file));
+	if (fileSize < sizeof(C4GroupSeekableMagic) + sizeof(trailer)
+		|| fseek(file, -static_cast<long>(sizeof(trailer)), SEEK_END)
+		|| fread(&trailer, sizeof(trailer), 1, file) != 1
+		|| !std::equal(trailer.ID, std::end(trailer.ID), SeekableTrailerID))
+	{
+		throw Exception("Invalid seekable file trailer");
+	}
+
+	if (trailer.IndexOffset < sizeof(C4GroupSeekableMagic)
+		|| trailer.IndexOffset + uint64_t{trailer.ChunkCount} * sizeof(SeekableChunk) + sizeof(trailer) != fileSize)
+	{
+		throw Exception("Invalid seekable file index");
+	}
+
+	chunks.resize(trailer.ChunkCount);
+	if (fseek(file, checked_cast<long>(trailer.IndexOffset), SEEK_SET)
+		|| fread(chunks.data(), sizeof(SeekableChunk), chunks.size(), file) != chunks.size())
+	{
+		throw Exception("Reading the seekable file index failed");
+	}
+
+	chunkStarts.reserve(chunks.size() + 1);
+	size_t start = 0;
+	for (const auto &chunk : chunks)
+	{
+		if (chunk.UncompressedSize > ChunkSize || chunk.FileOffset + chunk.CompressedSize > trailer.IndexOffset)
+		{
+			throw Exception("Invalid seekable file chunk");
+		}
+
+		chunkStarts.push_back(start);
+		start += chunk.UncompressedSize;
+	}
+	chunkStarts.push_back(start);
+
+	seekable = true;
+}
+
+void Read::LoadChunk(const size_t index)
+{
+	if (bufferedChunk == index) return;
+	bufferedChunk = SIZE_MAX;
+
+	const auto &chunk = chunks[index];
+	if (fseek(file, checked_cast<long>(chunk.FileOffset), SEEK_SET)) throw Exception("fseek failed");
+
+	if (chunk.Stored)
+	{
+		if (chunk.CompressedSize != chunk.UncompressedSize
+			|| fread(buffer.get(), 1, chunk.CompressedSize, file) != chunk.CompressedSize)
+		{
+			throw Exception("Reading stored chunk failed");
+		}
+	}
+	else
+	{
+		compressedChunk.resize(chunk.CompressedSize);
+		if (fread(compressedChunk.data(), 1, chunk.CompressedSize, file) != chunk.CompressedSize)
+		{
+			throw Exception("Reading compressed chunk failed");
+		}
+
+		uLongf size = chunk.UncompressedSize;
+		if (const auto ret = uncompress(buffer.get(), &size, compressedChunk.data(), chunk.CompressedSize); ret != Z_OK || size != chunk.UncompressedSize)
+		{
+			throw Exception(std::string{"uncompress failed: "} + zError(ret));
+		}
+	}
+
+	if (crc32(0, buffer.get(), chunk.UncompressedSize) != chunk.CRC)
+	{
+		throw Exception("Chunk checksum mismatch");
+	}
+
+	bufferedChunk = index;
+}
+
+size_t Read::ReadSeekable(uint8_t *const toBuffer, const size_t size)
+{
+	size_t readSize = 0;
+	while (readSize < size && position < chunkStarts.back())
+	{
+		// last chunk starting at or before the current position
+		const auto index = static_cast<size_t>(std::upper_bound(chunkStarts.begin(), chunkStarts.end() - 1, position) - chunkStarts.begin()) - 1;
+		LoadChunk(index);
+
+		const size_t offset = position - chunkStarts[index];
+		const size_t transfer = std::min<size_t>(size - readSize, chunks[index].UncompressedSize - offset);
+		std::memcpy(toBuffer + readSize, buffer.get() + offset, transfer);
+		readSize += transfer;
+		position += transfer;
+	}
+
+	return readSize;
+}
+
+bool Read::Seek(const size_t newPosition)
+{
+	if (!seekable) throw Exception("Seek is only supported for seekable files");
+	if (newPosition > chunkStarts.back()) return false;
+	position = newPosition;
+	return true;
+}
+
+bool Read::GetStoredRange(const size_t position, const size_t size, uint64_t &fileOffset) const
+{
+	if (!seekable || !size || position + size > chunkStarts.back()) return false;
+
+	auto index = static_cast<size_t>(std::upper_bound(chunkStarts.begin(), chunkStarts.end() - 1, position) - chunkStarts.begin()) - 1;
+	fileOffset = chunks[index].FileOffset + (position - chunkStarts[index]);
+
+	// all chunks of the range have to be stored and follow each other in the file
+	for (; ; ++index)
+	{
+		const auto &chunk = chunks[index];
+		if (!chunk.Stored) return false;
+		if (chunkStarts[index + 1] >= position + size) return true;
+		if (chunks[index + 1].FileOffset != chunk.FileOffset + chunk.CompressedSize) return false;
+	}
+}
+
 size_t Read::UncompressedSize()
 {
+	if (seekable) return chunkStarts.back();
+
 	std::unique_ptr<uint8_t[]> buffer{new uint8_t[ChunkSize]};
 	size_t size = 0;
 	for (;;)
@@ -151,6 +288,8 @@ size_t Read::UncompressedSize()
 
 size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 {
+	if (seekable) return ReadSeekable(toBuffer, size);
+
 	size_t readSize = 0;
 	gzStream.next_out = toBuffer;
 	gzStream.avail_out = checked_cast<unsigned int>(size);
@@ -211,9 +350,64 @@ void Read::RefillBuffer()
 	bufferPtr = buffer.get();
 }
 
+Read::Checkpoint::~Checkpoint()
+{
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+	}
+}
+
+std::unique_ptr<Read::Checkpoint> Read::SaveCheckpoint() const
+{
+	if (seekable) throw Exception("Checkpoints are only supported for non-seekable files");
+
+	auto checkpoint = std::make_unique<Checkpoint>();
+	checkpoint->position = position;
+	// the unread part of the buffer is read from the file again
+	checkpoint->fileOffset = ftell(file) - static_cast<long>(bufferedSize);
+	if (checkpoint->fileOffset < 0) throw Exception("ftell failed");
+	if (gzStreamValid)
+	{
+		if (const auto ret = inflateCopy(&checkpoint->gzStream, const_cast<z_stream *>(&gzStream)); ret != Z_OK)
+		{
+			throw Exception(std::string{"inflateCopy failed: "} + zError(ret));
+		}
+		checkpoint->gzStreamValid = true;
+	}
+	return checkpoint;
+}
+
+void Read::RestoreCheckpoint(const Checkpoint &checkpoint)
+{
+	if (seekable) throw Exception("Checkpoints are only supported for non-seekable files");
+
+	if (fseek(file, checkpoint.fileOffset, SEEK_SET)) throw Exception("fseek failed");
+	bufferedSize = 0;
+	position = checkpoint.position;
+
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+		gzStreamValid = false;
+	}
+	if (checkpoint.gzStreamValid)
+	{
+		if (const auto ret = inflateCopy(&gzStream, const_cast<z_stream *>(&checkpoint.gzStream)); ret != Z_OK)
+		{
+			throw Exception(std::string{"inflateCopy failed: "} + zError(ret));
+		}
+		gzStreamValid = true;
+	}
+	gzStream.next_in = nullptr;
+	gzStream.avail_in = 0;
+}
+
 void Read::Rewind()
 {
 	position = 0;
+	if (seekable) return;
+
 	fseek(file, 0, SEEK_SET);
 
 	inflateEnd(&gzStream);
@@ -224,7 +418,7 @@ void Read::Rewind()
 	PrepareInflate();
 }
 
-Write::Write(const std::string &filename)
+Write::Write(const std::string &filename, const bool seekable) : seekable{seekable}
 {
 	file = fopen(filename.c_str(), "wb");
 	if (!file)
@@ -232,6 +426,16 @@ Write::Write(const std::string &filename)
 		throw Exception{std::format("Opening \"{}\": {}", filename, std::strerror(errno))};
 	}
 
+	if (seekable)
+	{
+		if (fwrite(C4GroupSeekableMagic, 1, sizeof(C4GroupSeekableMagic), file) != sizeof(C4GroupSeekableMagic))
+		{
+			fclose(file);
+			throw Exception("fwrite failed");
+		}
+		return;
+	}
+
 	gzStream.zalloc = nullptr;
 	gzStream.zfree = nullptr;
 	gzStream.opaque = nullptr;
@@ -249,6 +453,14 @@ Write::Write(const std::string &filename)
 
 Write::~Write() noexcept(false)
 {
+	if (seekable)
+	{
+		if (bufferedSize) WriteChunk();
+		WriteIndex();
+		fclose(file);
+		return;
+	}
+
 	if (file)
 	{
 		DeflateToBuffer(nullptr, 0, Z_FINISH, Z_STREAM_END);
@@ -260,6 +472,53 @@ Write::~Write() noexcept(false)
 	deflateEnd(&gzStream);
 }
 
+void Write::WriteChunk()
+{
+	SeekableChunk chunk{fileOffset, 0, bufferedSize, static_cast<uint32_t>(crc32(0, buffer.get(), bufferedSize)), 0};
+
+	uLongf compressedSize = compressBound(bufferedSize);
+	compressedChunk.resize(compressedSize);
+	const uint8_t *data;
+	if (compress2(compressedChunk.data(), &compressedSize, buffer.get(), bufferedSize, CompressionLevel) == Z_OK && compressedSize < bufferedSize)
+	{
+		data = compressedChunk.data();
+		chunk.CompressedSize = static_cast<uint32_t>(compressedSize);
+	}
+	else
+	{
+		data = buffer.get();
+		chunk.CompressedSize = bufferedSize;
+		chunk.Stored = 1;
+	}
+
+	if (fwrite(data, 1, chunk.CompressedSize, file) != chunk.CompressedSize)
+	{
+		throw Exception("fwrite failed");
+	}
+
+	fileOffset += chunk.CompressedSize;
+	chunks.push_back(chunk);
+	bufferedSize = 0;
+}
+
+void Write::WriteIndex()
+{
+	const SeekableTrailer trailer{fileOffset, checked_cast<uint32_t>(chunks.size()), {SeekableTrailerID[0], SeekableTrailerID[1], SeekableTrailerID[2], SeekableTrailerID[3]}};
+	if (fwrite(chunks.data(), sizeof(SeekableChunk), chunks.size(), file) != chunks.size()
+		|| fwrite(&trailer, sizeof(trailer), 1, file) != 1)
+	{
+		throw Exception("Writing the seekable file index failed");
+	}
+}
+
+void Write::ChunkBoundary()
+{
+	if (seekable && bufferedSize >= SeekableMinChunkSize)
+	{
+		WriteChunk();
+	}
+}
+
 void Write::FlushBuffer()
 {
 	if (static_cast<unsigned int>(fwrite(buffer.get(), 1, bufferedSize, file)) != bufferedSize)
@@ -324,6 +583,23 @@ void Write::DeflateToBuffer(const uint8_t *const fromBuffer, const size_t size,
 
 void Write::WriteData(const uint8_t *const fromBuffer, const size_t size)
 {
-	DeflateToBuffer(fromBuffer, size, Z_NO_FLUSH, Z_OK);
+	if (!seekable)
+	{
+		DeflateToBuffer(fromBuffer, size, Z_NO_FLUSH, Z_OK);
+		return;
+	}
+
+	for (size_t written = 0; written < size;)
+	{
+		const auto transfer = std::min<size_t>(size - written, ChunkSize - bufferedSize);
+		std::memcpy(buffer.get() + bufferedSize, fromBuffer + written, transfer);
+		bufferedSize += static_cast<unsigned int>(transfer);
+		written += transfer;
+
+		if (bufferedSize == ChunkSize)
+		{
+			WriteChunk();
+		}
+	}
 }
 }
@@ -14,6 +14,7 @@
  */
 
 // wraps zlib's inflate for reading and deflate for writing gzip compressed group files with C4Group magic bytes
+// files in the seekable format consist of independently compressed chunks followed by an index of these chunks
 
 #pragma once
 
@@ -24,6 +25,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <zlib.h>
 
@@ -35,8 +37,52 @@ static constexpr uint8_t C4GroupMagic[2] = {0x1e, 0x8c};
 static constexpr uint8_t GZMagic[2] = {0x1f, 0x8b};
 static constexpr auto ChunkSize = 1024 * 1024;
 
+static constexpr uint8_t C4GroupSeekableMagic[2] = {0x1e, 0x8d};
+static constexpr char SeekableTrailerID[4] = {'C', '4', 'G', 'I'};
+static constexpr auto SeekableMinChunkSize = 64 * 1024; // chunks are only ended at boundaries once they reach this size
+
+#pragma pack (push, 1)
+
+// index record of an independently compressed chunk of at most ChunkSize bytes
+struct SeekableChunk
+{
+	uint64_t FileOffset;
+	uint32_t CompressedSize;
+	uint32_t UncompressedSize;
+	uint32_t CRC; // crc32 of the uncompressed data
+	uint8_t Stored; // not compressed, because compression did not pay off
+};
+
+// last bytes of a seekable file
+struct SeekableTrailer
+{
+	uint64_t IndexOffset;
+	uint32_t ChunkCount;
+	char ID[4];
+};
+
+#pragma pack (pop)
+
 class Read
 {
+public:
+	// decompression state at an uncompressed position, from which non-seekable files can be read again without starting over
+	class Checkpoint
+	{
+		friend class Read;
+		size_t position = 0;
+		long fileOffset = 0; // of the next compressed byte
+		z_stream gzStream;
+		bool gzStreamValid = false;
+
+	public:
+		Checkpoint() = default;
+		Checkpoint(const Checkpoint &) = delete;
+		Checkpoint &operator=(const Checkpoint &) = delete;
+		~Checkpoint();
+	};
+
+private:
 	std::unique_ptr<uint8_t[]> buffer{new uint8_t[ChunkSize]};
 	uint8_t *bufferPtr = nullptr;
 
@@ -49,6 +95,13 @@ class Read
 	z_stream gzStream;
 	bool gzStreamValid = false;
 
+	// seekable format only; buffer holds the uncompressed data of chunk bufferedChunk
+	bool seekable = false;
+	std::vector<SeekableChunk> chunks;
+	std::vector<size_t> chunkStarts; // uncompressed offset of each chunk, followed by the total size
+	std::vector<uint8_t> compressedChunk;
+	size_t bufferedChunk = SIZE_MAX;
+
 public:
 	Read(const std::string &filename);
 	~Read();
@@ -56,10 +109,20 @@ public:
 	size_t ReadData(uint8_t *toBuffer, size_t size);
 	void Rewind();
 
+	bool IsSeekable() const { return seekable; }
+	size_t Position() const { return position; }
+	bool Seek(size_t newPosition); // seekable format only
+	std::unique_ptr<Checkpoint> SaveCheckpoint() const; // non-seekable format only
+	void RestoreCheckpoint(const Checkpoint &checkpoint);
+	bool GetStoredRange(size_t position, size_t size, uint64_t &fileOffset) const; // seekable format: whether the range is stored uncompressed and contiguously in the file, and where
+
 private:
 	void CheckMagicBytes();
 	void PrepareInflate();
 	void RefillBuffer();
+	void ReadIndex();
+	size_t ReadSeekable(uint8_t *toBuffer, size_t size);
+	void LoadChunk(size_t index);
 };
 
 class Write
@@ -72,14 +135,23 @@ class Write
 	unsigned int bufferedSize = 0;
 	bool magicBytesDone = false;
 
+	// seekable format only; buffer collects the uncompressed data of the current chunk
+	bool seekable;
+	std::vector<SeekableChunk> chunks;
+	std::vector<uint8_t> compressedChunk;
+	uint64_t fileOffset = sizeof(C4GroupSeekableMagic);
+
 public:
-	Write(const std::string &filename);
+	Write(const std::string &filename, bool seekable = false);
 	~Write() noexcept(false);
 	void WriteData(const uint8_t *const fromBuffer, const size_t size);
+	void ChunkBoundary(); // seekable format: a new chunk may start here, e.g. at the start of a group entry
 
 private:
 	void FlushBuffer();
 	void DeflateToBuffer(const uint8_t *const fromBuffer, const size_t size, int flushMode, int expectedRet);
+	void WriteChunk();
+	void WriteIndex();
 
 private:
 	static constexpr auto CompressionLevel = 2;
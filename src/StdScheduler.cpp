@@ -44,12 +44,55 @@
 
 // *** StdScheduler
 
+#ifdef __linux__
+
+namespace
+{
+	std::uint32_t ToEpollEvents(const short events)
+	{
+		return (events & POLLIN ? EPOLLIN : 0) | (events & POLLOUT ? EPOLLOUT : 0);
+	}
+}
+
+StdScheduler::StdScheduler() : epollFD{epoll_create1(EPOLL_CLOEXEC)}
+{
+	if (epollFD == -1)
+	{
+		// Execute falls back to poll
+		printf("StdScheduler: epoll_create1 failed %s\n", strerror(errno));
+		return;
+	}
+
+	// Unblocker is the only descriptor without a proc
+	epoll_event event{.events = EPOLLIN, .data = {.ptr = nullptr}};
+	epoll_ctl(epollFD, EPOLL_CTL_ADD, unblocker.GetFD(), &event);
+}
+
+StdScheduler::~StdScheduler()
+{
+	if (epollFD != -1) close(epollFD);
+}
+
+#else
+
+StdScheduler::StdScheduler() = default;
+StdScheduler::~StdScheduler() = default;
+
+#endif
+
 void StdScheduler::Clear()
 {
 	procs.clear();
 #ifdef _WIN32
 	eventHandles.clear();
 	eventProcs.clear();
+#elif defined(__linux__)
+	for (const auto &[fd, proc] : registeredFDs)
+	{
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+	}
+	registeredFDs.clear();
+	procFDs.clear();
 #endif
 }
 
@@ -61,8 +104,87 @@ void StdScheduler::Add(StdSchedulerProc *const proc)
 void StdScheduler::Remove(StdSchedulerProc *const proc)
 {
 	procs.erase(proc);
+#ifdef __linux__
+	if (const auto it = procFDs.find(proc); it != procFDs.end())
+	{
+		for (const auto &fd : it->second.FDs)
+		{
+			UnregisterFD(proc, fd.fd);
+		}
+		procFDs.erase(it);
+	}
+#endif
+}
+
+#ifdef __linux__
+
+void StdScheduler::UpdateFDs()
+{
+	changedProcs.clear();
+
+	// Remove descriptors that are gone first, so one that moved to another proc can be added again afterwards
+	for (auto *const proc : procs)
+	{
+		// Read the revision first: a change while collecting is picked up next time
+		const std::uint32_t revision{proc->GetFDsRevision()};
+		const auto [it, inserted] = procFDs.try_emplace(proc, ProcFDs{{}, revision});
+		auto &[procFDList, procRevision] = it->second;
+
+		// Procs call FDsChanged whenever their set changes
+		if (!inserted && procRevision == revision) continue;
+
+		fds.clear();
+		proc->GetFDs(fds);
+
+		for (const auto &fd : procFDList)
+		{
+			if (std::ranges::find(fds, fd.fd, &pollfd::fd) == fds.end())
+			{
+				UnregisterFD(proc, fd.fd);
+			}
+		}
+
+		procFDList.swap(fds);
+		procRevision = revision;
+		changedProcs.emplace_back(proc);
+	}
+
+	for (auto *const proc : changedProcs)
+	{
+		for (const auto &fd : procFDs[proc].FDs)
+		{
+			// A descriptor reported by several procs is only signaled to the last one
+			const auto [it, inserted] = registeredFDs.try_emplace(fd.fd, proc);
+			it->second = proc;
+
+			// A descriptor that was closed and reopened with the same number has been removed from epoll in between
+			epoll_event event{.events = ToEpollEvents(fd.events), .data = {.ptr = proc}};
+			int result{inserted ? -1 : epoll_ctl(epollFD, EPOLL_CTL_MOD, fd.fd, &event)};
+			if (result == -1 && (inserted || errno == ENOENT))
+			{
+				result = epoll_ctl(epollFD, EPOLL_CTL_ADD, fd.fd, &event);
+			}
+
+			if (result == -1)
+			{
+				printf("StdScheduler::Execute: epoll_ctl failed %s\n", strerror(errno));
+			}
+		}
+	}
 }
 
+void StdScheduler::UnregisterFD(StdSchedulerProc *const proc, const int fd)
+{
+	if (const auto it = registeredFDs.find(fd); it != registeredFDs.end() && it->second == proc)
+	{
+		// Fails if the descriptor is closed already, which removed it from epoll anyway
+		epoll_ctl(epollFD, EPOLL_CTL_DEL, fd, nullptr);
+		registeredFDs.erase(it);
+	}
+}
+
+#endif
+
 bool StdScheduler::Execute(int iTimeout)
 {
 	// Needs at least one process to work properly
@@ -119,7 +241,96 @@ bool StdScheduler::Execute(int iTimeout)
 	}
 
 #else
-	fds.resize(1);
+	bool success;
+
+#ifdef __linux__
+	if (epollFD != -1)
+	{
+		success = ExecuteEpoll(iTimeout);
+	}
+	else
+#endif
+	{
+		success = ExecutePoll(iTimeout);
+	}
+
+#endif
+
+	for (auto *const proc : procs)
+	{
+		if (proc->GetTimeout() == 0)
+		{
+			if (!proc->Execute())
+			{
+				OnError(proc);
+				success = false;
+			}
+		}
+	}
+
+	return success;
+}
+
+#ifndef _WIN32
+
+#ifdef __linux__
+
+bool StdScheduler::ExecuteEpoll(const int iTimeout)
+{
+	UpdateFDs();
+
+	// Wait for something to happen
+	events.resize(registeredFDs.size() + 1);
+	int cnt;
+	do
+	{
+		cnt = epoll_wait(epollFD, events.data(), static_cast<int>(events.size()), iTimeout < 0 ? -1 : iTimeout);
+	}
+	while (cnt == -1 && errno == EINTR);
+
+	bool success{true};
+
+	if (cnt > 0)
+	{
+		// Execute each signaled proc once
+		readyProcs.clear();
+		for (const auto &event : std::span{events}.first(cnt))
+		{
+			auto *const proc = static_cast<StdSchedulerProc *>(event.data.ptr);
+
+			// Unblocker? Flush
+			if (!proc)
+			{
+				unblocker.Reset();
+			}
+			else if (std::ranges::find(readyProcs, proc) == readyProcs.end())
+			{
+				readyProcs.emplace_back(proc);
+			}
+		}
+
+		for (auto *const proc : readyProcs)
+		{
+			if (!proc->Execute(0))
+			{
+				OnError(proc);
+				success = false;
+			}
+		}
+	}
+	else if (cnt < 0)
+	{
+		printf("StdScheduler::Execute: epoll_wait failed %s\n", strerror(errno));
+	}
+
+	return success;
+}
+
+#endif
+
+bool StdScheduler::ExecutePoll(const int iTimeout)
+{
+	fds.assign(1, {.fd = unblocker.GetFD(), .events = POLLIN});
 
 	struct FdRange
 	{
@@ -174,23 +385,11 @@ bool StdScheduler::Execute(int iTimeout)
 		printf("StdScheduler::Execute: poll failed %s\n", strerror(errno));
 	}
 
-#endif
-
-	for (auto *const proc : procs)
-	{
-		if (proc->GetTimeout() == 0)
-		{
-			if (!proc->Execute())
-			{
-				OnError(proc);
-				success = false;
-			}
-		}
-	}
-
 	return success;
 }
 
+#endif
+
 void StdScheduler::UnBlock()
 {
 	unblocker.Set();
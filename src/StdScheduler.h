@@ -28,6 +28,14 @@
 #include <poll.h>
 #endif
 
+#ifdef __linux__
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
 #include <thread>
 #include <unordered_set>
 
@@ -57,14 +65,21 @@ public:
 	// Call Execute() after this time has elapsed (no garantuees regarding accuracy)
 	// -1 means no timeout (infinity).
 	virtual int GetTimeout() { return -1; }
+
+	// Must be called whenever the set returned by GetFDs changes, including closing a descriptor, as its number might be reused by the next one (mt-safe)
+	void FDsChanged() { fdsRevision.fetch_add(1, std::memory_order_acq_rel); }
+	virtual std::uint32_t GetFDsRevision() const { return fdsRevision.load(std::memory_order_acquire); }
+
+private:
+	std::atomic_uint32_t fdsRevision{0};
 };
 
 // A simple process scheduler
 class StdScheduler
 {
 public:
-	StdScheduler() = default;
-	virtual ~StdScheduler() = default;
+	StdScheduler();
+	virtual ~StdScheduler();
 
 private:
 	// Process list
@@ -79,7 +94,28 @@ private:
 	std::vector<StdSchedulerProc *> eventProcs;
 #else
 	CStdEvent unblocker;
-	std::vector<pollfd> fds{{.fd = unblocker.GetFD(), .events = POLLIN}};
+
+	// Dummy list (preserved to reduce allocs)
+	std::vector<pollfd> fds;
+
+#ifdef __linux__
+	// Descriptors stay registered with epoll; only changes to the sets reported by GetFDs are applied
+	struct ProcFDs
+	{
+		std::vector<pollfd> FDs;
+		std::uint32_t Revision;
+	};
+
+	// -1 if epoll is not available, which falls back to poll
+	int epollFD{-1};
+	std::unordered_map<StdSchedulerProc *, ProcFDs> procFDs;
+	std::unordered_map<int, StdSchedulerProc *> registeredFDs;
+
+	// Dummy lists (preserved to reduce allocs)
+	std::vector<StdSchedulerProc *> changedProcs;
+	std::vector<epoll_event> events;
+	std::vector<StdSchedulerProc *> readyProcs;
+#endif
 #endif
 
 public:
@@ -95,6 +131,17 @@ public:
 protected:
 	// overridable
 	virtual void OnError(StdSchedulerProc *pProc) {}
+
+#ifndef _WIN32
+private:
+	bool ExecutePoll(int iTimeout);
+
+#ifdef __linux__
+	bool ExecuteEpoll(int iTimeout);
+	void UpdateFDs();
+	void UnregisterFD(StdSchedulerProc *proc, int fd);
+#endif
+#endif
 };
 
 // A simple process scheduler thread
@@ -342,6 +342,17 @@ bool ProcessGroup(const char *FilenamePar)
 							std::println(stderr, "Reopen failed: {}", hGroup.GetError());
 						}
 						break;
+					// Convert file format: -cs seekable, -cg single gzip stream
+					case 'c':
+						if (argv[iArg][2] != 's' && argv[iArg][2] != 'g')
+						{
+							std::println(stderr, "Missing file format for convert command (-cs or -cg)");
+						}
+						else if (!hGroup.SetSeekable(argv[iArg][2] == 's'))
+						{
+							std::println(stderr, "Convert failed: {}", hGroup.GetError());
+						}
+						break;
 					// Print maker
 					case 'k':
 						std::println("{}", hGroup.GetMaker());
@@ -657,6 +668,7 @@ int main(int argc, char *argv[])
 		std::println("          -v View  -l List  -d Delete  -r Rename  -s Sort");
 		std::println("          -p Pack  -u Unpack  -x Explode");
 		std::println("          -k Print maker");
+		std::println("          -cs Convert to seekable format  -cg Convert to gzip stream format");
 		std::println("          -g[a] [source] [target] [title] Make update [and allow missing target group when applying update]");
 		std::println("          -y[d] Apply update [and delete group file]");
 		std::println("");
@@ -671,6 +683,7 @@ int main(int argc, char *argv[])
 		std::println("          c4group pack.c4g -s \"*.bin|*.dat\"");
 		std::println("          c4group pack.c4g -x");
 		std::println("          c4group pack.c4g -k");
+		std::println("          c4group pack.c4g -cs");
 		std::println("          c4group update.c4u -g ver1.c4f ver2.c4f New_Version");
 		std::println("          c4group -i");
 	}
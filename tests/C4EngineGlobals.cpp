@@ -0,0 +1,27 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* Global engine objects for tests, which use their own entry point instead of C4WinMain.cpp */
+
+#include <C4Application.h>
+
+#include <C4Console.h>
+#include <C4FullScreen.h>
+
+C4Application Application;
+C4Console Console;
+C4FullScreen FullScreen;
+C4Game Game;
+C4Config Config;
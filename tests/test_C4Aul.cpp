@@ -0,0 +1,658 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Aul.h"
+#include "C4Config.h"
+#include "C4Game.h"
+#include "C4Script.h"
+#include "C4ValueHash.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// a global script that is parsed and linked into the game's script engine for the duration of a test
+	class TestScript : public C4AulScript
+	{
+	public:
+		// link can be turned off to register several scripts before linking them at once
+		TestScript(const char *const script, const char *const name = "TestScript", const bool link = true)
+		{
+			Script.Copy(script);
+			ScriptName = name;
+			Reg2List(&Game.ScriptEngine, &Game.ScriptEngine);
+			Preparse();
+			if (link)
+			{
+				Game.ScriptEngine.Link(&Game.Defs);
+			}
+		}
+
+		bool Delete() override { return false; }
+
+		C4Value Call(const char *const function, const C4AulParSet &pars = C4AulParSet{})
+		{
+			C4AulScriptFunc *const func{GetSFunc(function)};
+			REQUIRE(func);
+			return func->Exec(nullptr, pars, true);
+		}
+	};
+
+	// sets a config value for the lifetime of the object
+	template<typename T>
+	class ConfigOverride
+	{
+	public:
+		ConfigOverride(T &value, const T newValue) : value{value}, oldValue{value} { value = newValue; }
+		~ConfigOverride() { value = oldValue; }
+
+		ConfigOverride(const ConfigOverride &) = delete;
+		ConfigOverride &operator=(const ConfigOverride &) = delete;
+
+	private:
+		T &value;
+		const T oldValue;
+	};
+
+	// parses the script with the current config and returns the results of the given calls
+	std::vector<std::string> RunScript(const char *const script, const std::vector<std::pair<const char *, C4AulParSet>> &calls)
+	{
+		TestScript testScript{script};
+		std::vector<std::string> results;
+		for (const auto &[function, pars] : calls)
+		{
+			results.emplace_back(testScript.Call(function, pars).GetDataString());
+		}
+		return results;
+	}
+
+	// exercises fused compare and branch, fused increments and constant folding
+	constexpr auto OptimizerScript = R"(#strict 3
+func Sum(n)
+{
+	var sum = 0;
+	for (var i = 0; i < n; ++i) sum += i;
+	return sum;
+}
+
+func CountDown(n, step)
+{
+	var steps = 0;
+	for (var i = n; i > 0; i -= step) steps++;
+	for (var j = n; j >= 0; j -= 3) --steps;
+	return steps;
+}
+
+func Compare(a, b)
+{
+	var result = [];
+	if (a < b) result[] = -1;
+	if (a <= b) result[] = 0;
+	if (a > b) result[] = 1;
+	if (a >= 3) result[] = 3;
+	var limit = 7;
+	if (a < limit && limit <= b) result[] = limit;
+	if (a > 2 || b < -2) result[] = 2;
+	return result;
+}
+
+func Nested(n)
+{
+	var count = 0;
+	for (var i = 0; i < n; ++i)
+	{
+		for (var j = 0; j <= i; j++)
+		{
+			if (j > 5) break;
+			if (i + j < 4) continue;
+			count += 2;
+		}
+		while (count > 20) count -= 7;
+	}
+	return count;
+}
+
+func Loops(n)
+{
+	var sum = 0;
+	for (var value in [0, 1, n, 5]) for (var k = value; k < 3; ++k) sum += k;
+	for (var key, value in {a = 1, b = 2}) if (value >= 2) sum += 100;
+	return sum;
+}
+
+func Constants()
+{
+	return [1 + 2 * 3, -(4 - 10), 7 / 2, -7 % 3, 12 & 10, 12 | 3, 12 ^ 5, 2147483647 - 1, -2147483647 - 1, 5 / 0, 5 % 0, -(3), 1 << 4, 2 ** 10];
+}
+
+func NonInt(a)
+{
+	var n;
+	var result = [];
+	if (n < 1) result[] = "nil < 1";
+	if (a < 1) result[] = "a < 1";
+	if (n >= a) result[] = "nil >= a";
+	return result;
+}
+)";
+
+	// calls functions of the stock System.c4g scripts that need neither objects nor a landscape
+	constexpr auto StockWorkloadScript = R"(#strict 2
+func Workload(n)
+{
+	var result = 0;
+	for (var i = 0; i < n; ++i)
+	{
+		var rgb = RGBa(i * 7, i * 13, i * 29, i);
+		var value = RGB2HSL(rgb) ^ HSL2RGB(rgb) ^ SetRGBaValue(rgb, i, i % 4) ^ DoRGBaValue(rgb, 1, i % 4);
+		value ^= GetBit(SetBit(i, i % 31, true), i % 31) + ToggleBit(i, 3);
+		value ^= GetLength(Find_And(Find_Not(Find_OCF(i)), Find_Or(Find_OCF(1), Find_OCF(2))));
+		value ^= GetLength(CreateArray2(8, i % 2, i));
+		result = (result + (value & 65535)) % 1000003;
+	}
+	return result;
+}
+)";
+
+	// the global scripts of System.c4g, loaded from the source tree along with StockWorkloadScript
+	class StockScripts
+	{
+	public:
+		StockScripts()
+		{
+			// the stock scripts call engine functions
+			static const bool engineFunctions{(InitFunctionMap(&Game.ScriptEngine), true)};
+			static_cast<void>(engineFunctions);
+
+			std::vector<std::filesystem::path> files;
+			for (const auto &entry : std::filesystem::directory_iterator{LC_SYSTEM_GROUP_DIR})
+			{
+				if (entry.path().extension() == ".c")
+				{
+					files.emplace_back(entry.path());
+				}
+			}
+			std::ranges::sort(files);
+			REQUIRE(!files.empty());
+
+			for (const auto &file : files)
+			{
+				StdStrBuf source;
+				REQUIRE(source.LoadFromFile(file.string().c_str()));
+				scripts.emplace_back(std::make_unique<TestScript>(source.getData(), file.filename().string().c_str(), false));
+			}
+			workload = std::make_unique<TestScript>(StockWorkloadScript, "StockWorkload");
+		}
+
+		TestScript &Workload() { return *workload; }
+
+	private:
+		std::vector<std::unique_ptr<TestScript>> scripts;
+		std::unique_ptr<TestScript> workload;
+	};
+
+	// returns the number of bytecode instructions that are dispatched by the call, counted by the bytecode profiler
+	std::uint64_t CountDispatchedOps(TestScript &script, const char *const function, const C4AulParSet &pars)
+	{
+		C4AulProfiler::StartProfiling(&Game.ScriptEngine, true);
+		script.Call(function, pars);
+		const std::uint64_t count{C4AulProfiler::GetOpCount()};
+		C4AulProfiler::Abort();
+		return count;
+	}
+
+	// runs the call repeatedly for about a second and returns the number of dispatched instructions per second
+	double MeasureOpsPerSecond(TestScript &script, const char *const function, const C4AulParSet &pars)
+	{
+		const std::uint64_t ops{CountDispatchedOps(script, function, pars)};
+		std::uint64_t calls{0};
+		const auto start = std::chrono::steady_clock::now();
+		std::chrono::duration<double> elapsed;
+		do
+		{
+			script.Call(function, pars);
+			++calls;
+			elapsed = std::chrono::steady_clock::now() - start;
+		}
+		while (elapsed < std::chrono::seconds{1});
+		return static_cast<double>(ops * calls) / elapsed.count();
+	}
+
+	// the unordered_map and list based implementation that C4ValueHash replaced, kept as baseline for the benchmark
+	class LegacyValueHash
+	{
+		struct MapEntry
+		{
+			C4Value *value;
+			std::list<const C4Value *>::iterator keyOrderIterator;
+		};
+
+		struct KeyEqual
+		{
+			bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		};
+
+		std::unordered_map<C4Value, MapEntry, std::hash<C4Value>, KeyEqual> map;
+		std::list<const C4Value *> keyOrder;
+
+	public:
+		~LegacyValueHash()
+		{
+			for (auto &[key, entry] : map) delete entry.value;
+		}
+
+		C4Value &operator[](const C4Value &key)
+		{
+			try
+			{
+				return *map.at(key).value;
+			}
+			catch (const std::out_of_range &)
+			{
+				const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(MapEntry{new C4Value, {}})).first;
+				inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
+				return *inserted->second.value;
+			}
+		}
+
+		const C4Value &operator[](const C4Value &key) const
+		{
+			try
+			{
+				return *map.at(key).value;
+			}
+			catch (const std::out_of_range &)
+			{
+				return C4VNull;
+			}
+		}
+
+		// iterates in key order, looking up each value like the old iterator did
+		template<typename Function>
+		void forEach(Function function)
+		{
+			for (const C4Value *const key : keyOrder)
+			{
+				function(*key, (*this)[*key]);
+			}
+		}
+
+		// the old removal searched the whole map for the cleared value
+		void removeValue(C4Value *const value)
+		{
+			for (auto it = map.begin(); it != map.end(); ++it)
+			{
+				if (it->second.value == value)
+				{
+					keyOrder.erase(it->second.keyOrderIterator);
+					delete it->second.value;
+					map.erase(it);
+					return;
+				}
+			}
+		}
+
+		std::size_t size() const { return map.size(); }
+	};
+
+	constexpr C4ValueInt MapBenchmarkSize{10000};
+
+	// calls covering every function of OptimizerScript
+	const std::vector<std::pair<const char *, C4AulParSet>> &OptimizerCalls()
+	{
+		static const std::vector<std::pair<const char *, C4AulParSet>> calls
+		{
+			{"Sum", {C4VInt(0)}},
+			{"Sum", {C4VInt(100)}},
+			{"Sum", {C4VInt(-3)}},
+			{"CountDown", {C4VInt(10), C4VInt(1)}},
+			{"CountDown", {C4VInt(11), C4VInt(4)}},
+			{"Compare", {C4VInt(1), C4VInt(2)}},
+			{"Compare", {C4VInt(3), C4VInt(3)}},
+			{"Compare", {C4VInt(5), C4VInt(-4)}},
+			{"Compare", {C4VInt(6), C4VInt(8)}},
+			{"Compare", {C4VNull, C4VInt(7)}},
+			{"Compare", {C4VBool(true), C4VNull}},
+			{"Nested", {C4VInt(12)}},
+			{"Loops", {C4VInt(-2)}},
+			{"Loops", {C4VNull}},
+			{"Constants", {}},
+			{"NonInt", {C4VNull}},
+			{"NonInt", {C4VBool(false)}},
+			{"NonInt", {C4VInt(-5)}}
+		};
+		return calls;
+	}
+}
+
+TEST_CASE("Leaving a map loop early doesn't keep the map from being compacted", "[C4Aul][C4ValueHash]")
+{
+	TestScript script{R"(#strict 3
+func Fill(map, count)
+{
+	for (var i = 0; i < count; ++i) map[i] = i;
+	return map;
+}
+
+func FindKey(map, needle)
+{
+	for (var key, value in map) if (value == needle) return key;
+	return -1;
+}
+
+func Main()
+{
+	var map = Fill({}, 64);
+	for (var key, value in map) if (key == 3) break;
+	if (FindKey(map, 5) != 5) return;
+	for (var j = 0; j < 48; ++j) map[j] = nil;
+	map[64] = 64;
+	return map;
+}
+)"};
+
+	const C4Value result{script.Call("Main")};
+	REQUIRE(result.GetType() == C4V_Map);
+
+	C4ValueHash *const map{result._getMap()};
+	CHECK(map->size() == 17);
+	CHECK(map->storedEntries() == 17);
+
+	// compaction keeps the insertion order
+	C4ValueInt expected{48};
+	for (auto [key, value] : *map)
+	{
+		CHECK(key._getInt() == expected);
+		CHECK(value._getInt() == expected);
+		++expected;
+	}
+	CHECK(expected == 65);
+}
+
+TEST_CASE("Clearing map values removes their entries", "[C4Aul][C4ValueHash]")
+{
+	C4ValueHash map;
+	for (C4ValueInt i{0}; i < 1000; ++i)
+	{
+		map[C4VInt(i)].Set(C4VInt(i));
+	}
+
+	// removal finds the entries through the values
+	for (C4ValueInt i{0}; i < 1000; ++i)
+	{
+		if (i % 4 != 3) map[C4VInt(i)].Set0();
+	}
+	CHECK(map.size() == 250);
+	CHECK_FALSE(map.contains(C4VInt(0)));
+	CHECK(map.contains(C4VInt(3)));
+
+	// compaction moves the remaining entries, which must still be found through their values
+	map[C4VInt(1000)].Set(C4VInt(1000));
+	C4ValueHash::CompactPending();
+	CHECK(map.storedEntries() == 251);
+	for (C4ValueInt i{3}; i < 1000; i += 8)
+	{
+		map[C4VInt(i)].Set0();
+	}
+	CHECK(map.size() == 126);
+
+	std::vector<C4ValueInt> expected;
+	for (C4ValueInt i{7}; i < 1000; i += 8) expected.push_back(i);
+	expected.push_back(1000);
+
+	std::vector<C4ValueInt> keys;
+	for (auto [key, value] : map)
+	{
+		CHECK(key._getInt() == value._getInt());
+		keys.push_back(key._getInt());
+	}
+	CHECK(keys == expected);
+}
+
+TEST_CASE("C4ValueHash benchmark", "[C4ValueHash][.][benchmark]")
+{
+	const auto fill = [](auto &map)
+	{
+		for (C4ValueInt i{0}; i < MapBenchmarkSize; ++i)
+		{
+			map[C4VInt(i)].Set(C4VInt(i));
+		}
+	};
+
+	BENCHMARK("Legacy insert")
+	{
+		LegacyValueHash map;
+		fill(map);
+		return map.size();
+	};
+
+	BENCHMARK("Insert")
+	{
+		C4ValueHash map;
+		fill(map);
+		return map.size();
+	};
+
+	LegacyValueHash legacyMap;
+	fill(legacyMap);
+	C4ValueHash map;
+	fill(map);
+
+	BENCHMARK("Legacy lookup")
+	{
+		C4ValueInt sum{0};
+		for (C4ValueInt i{0}; i < MapBenchmarkSize; ++i) sum += std::as_const(legacyMap)[C4VInt(i)]._getInt();
+		return sum;
+	};
+
+	BENCHMARK("Lookup")
+	{
+		C4ValueInt sum{0};
+		for (C4ValueInt i{0}; i < MapBenchmarkSize; ++i) sum += std::as_const(map)[C4VInt(i)]._getInt();
+		return sum;
+	};
+
+	BENCHMARK("Legacy iterate")
+	{
+		C4ValueInt sum{0};
+		legacyMap.forEach([&sum](const C4Value &key, C4Value &value) { sum += key._getInt() ^ value._getInt(); });
+		return sum;
+	};
+
+	BENCHMARK("Iterate")
+	{
+		C4ValueInt sum{0};
+		for (auto [key, value] : map) sum += key._getInt() ^ value._getInt();
+		return sum;
+	};
+
+	BENCHMARK_ADVANCED("Legacy clear values")(Catch::Benchmark::Chronometer meter)
+	{
+		// every run needs a filled map
+		std::vector<std::unique_ptr<LegacyValueHash>> maps;
+		for (int run{0}; run < meter.runs(); ++run)
+		{
+			fill(*maps.emplace_back(std::make_unique<LegacyValueHash>()));
+		}
+		meter.measure([&maps](const int run)
+		{
+			LegacyValueHash &map{*maps[run]};
+			for (C4ValueInt i{0}; i < MapBenchmarkSize; ++i) map.removeValue(&map[C4VInt(i)]);
+			return map.size();
+		});
+	};
+
+	BENCHMARK_ADVANCED("Clear values")(Catch::Benchmark::Chronometer meter)
+	{
+		// every run needs a filled map
+		std::vector<std::unique_ptr<C4ValueHash>> maps;
+		for (int run{0}; run < meter.runs(); ++run)
+		{
+			fill(*maps.emplace_back(std::make_unique<C4ValueHash>()));
+		}
+		meter.measure([&maps](const int run)
+		{
+			C4ValueHash &map{*maps[run]};
+			for (C4ValueInt i{0}; i < MapBenchmarkSize; ++i) map[C4VInt(i)].Set0();
+			return map.size();
+		});
+	};
+}
+
+TEST_CASE("Optimized bytecode yields the same results as unoptimized bytecode", "[C4Aul]")
+{
+	const auto &calls = OptimizerCalls();
+	std::vector<std::string> unoptimized;
+	{
+		const ConfigOverride optimize{Config.Developer.OptimizeBytecode, false};
+		unoptimized = RunScript(OptimizerScript, calls);
+	}
+
+	std::vector<std::string> optimized;
+	{
+		const ConfigOverride optimize{Config.Developer.OptimizeBytecode, true};
+		optimized = RunScript(OptimizerScript, calls);
+	}
+
+	REQUIRE(unoptimized.size() == optimized.size());
+	for (std::size_t i{0}; i < unoptimized.size(); ++i)
+	{
+		INFO("Call " << i << ": " << calls[i].first);
+		CHECK(unoptimized[i] == optimized[i]);
+	}
+
+	CHECK(unoptimized[1] == "4950");
+}
+
+TEST_CASE("Optimized bytecode dispatches fewer instructions in stock scripts", "[C4Aul]")
+{
+	const C4AulParSet pars{C4VInt(100)};
+	std::string unoptimizedResult, optimizedResult;
+	std::uint64_t unoptimizedOps, optimizedOps;
+	{
+		const ConfigOverride optimize{Config.Developer.OptimizeBytecode, false};
+		StockScripts stock;
+		unoptimizedResult = stock.Workload().Call("Workload", pars).GetDataString();
+		unoptimizedOps = CountDispatchedOps(stock.Workload(), "Workload", pars);
+	}
+	{
+		const ConfigOverride optimize{Config.Developer.OptimizeBytecode, true};
+		StockScripts stock;
+		optimizedResult = stock.Workload().Call("Workload", pars).GetDataString();
+		optimizedOps = CountDispatchedOps(stock.Workload(), "Workload", pars);
+	}
+
+	INFO("Unoptimized: " << unoptimizedOps << " instructions, optimized: " << optimizedOps << " instructions");
+	CHECK(unoptimizedResult == optimizedResult);
+	CHECK(unoptimizedOps > 0);
+	CHECK(optimizedOps < unoptimizedOps);
+}
+
+TEST_CASE("Bytecode optimization benchmark", "[C4Aul][.][benchmark]")
+{
+	const auto benchmark = [](const char *const name, const bool optimize)
+	{
+		const ConfigOverride optimization{Config.Developer.OptimizeBytecode, optimize};
+		{
+			TestScript script{OptimizerScript};
+			BENCHMARK(std::format("{} Nested(200) ({} instructions)", name, CountDispatchedOps(script, "Nested", {C4VInt(200)})))
+			{
+				return script.Call("Nested", {C4VInt(200)});
+			};
+		}
+		{
+			StockScripts stock;
+			BENCHMARK(std::format("{} stock scripts ({} instructions)", name, CountDispatchedOps(stock.Workload(), "Workload", {C4VInt(100)})))
+			{
+				return stock.Workload().Call("Workload", {C4VInt(100)});
+			};
+		}
+	};
+
+	benchmark("Unoptimized", false);
+	benchmark("Optimized", true);
+}
+
+TEST_CASE("Threaded dispatch yields the same results as switch dispatch", "[C4Aul]")
+{
+	const auto &calls = OptimizerCalls();
+
+	std::vector<std::string> switchDispatch;
+	{
+		const ConfigOverride dispatch{Config.Developer.ThreadedDispatch, false};
+		switchDispatch = RunScript(OptimizerScript, calls);
+	}
+
+	std::vector<std::string> threadedDispatch;
+	{
+		const ConfigOverride dispatch{Config.Developer.ThreadedDispatch, true};
+		threadedDispatch = RunScript(OptimizerScript, calls);
+	}
+
+	REQUIRE(switchDispatch.size() == threadedDispatch.size());
+	for (std::size_t i{0}; i < switchDispatch.size(); ++i)
+	{
+		INFO("Call " << i << ": " << calls[i].first);
+		CHECK(switchDispatch[i] == threadedDispatch[i]);
+	}
+
+	StockScripts stock;
+	const C4AulParSet pars{C4VInt(100)};
+	std::string switchResult;
+	{
+		const ConfigOverride dispatch{Config.Developer.ThreadedDispatch, false};
+		switchResult = stock.Workload().Call("Workload", pars).GetDataString();
+	}
+	const ConfigOverride dispatch{Config.Developer.ThreadedDispatch, true};
+	CHECK(stock.Workload().Call("Workload", pars).GetDataString() == switchResult);
+}
+
+TEST_CASE("Script dispatch benchmark", "[C4Aul][.][benchmark]")
+{
+	TestScript script{OptimizerScript};
+	StockScripts stock;
+	const auto benchmark = [&script, &stock](const char *const name, const bool threaded)
+	{
+		const ConfigOverride dispatch{Config.Developer.ThreadedDispatch, threaded};
+		WARN(std::format("{} dispatch: {:.1f} M instructions/s in Nested(200), {:.1f} M instructions/s in stock scripts", name,
+			MeasureOpsPerSecond(script, "Nested", {C4VInt(200)}) / 1e6,
+			MeasureOpsPerSecond(stock.Workload(), "Workload", {C4VInt(100)}) / 1e6));
+		BENCHMARK(std::format("{} Nested(200)", name))
+		{
+			return script.Call("Nested", {C4VInt(200)});
+		};
+		BENCHMARK(std::format("{} stock scripts", name))
+		{
+			return stock.Workload().Call("Workload", {C4VInt(100)});
+		};
+	};
+
+	benchmark("Switch", false);
+	benchmark("Threaded", true);
+}
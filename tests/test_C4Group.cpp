@@ -0,0 +1,143 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Group.h"
+#include "StdBuf.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <vector>
+
+namespace
+{
+	constexpr int DefinitionCount{4};
+
+	// a packed Objects.c4d with definitions made of the stock graphics
+	class PackedDefinitions
+	{
+	public:
+		explicit PackedDefinitions(const bool seekable) : path{std::filesystem::temp_directory_path() / "C4GroupTest"}
+		{
+			std::filesystem::remove_all(path);
+			const std::filesystem::path source{path / "Objects"};
+			std::filesystem::create_directories(source);
+			for (int i{0}; i < DefinitionCount; ++i)
+			{
+				std::filesystem::copy(LC_GRAPHICS_GROUP_DIR, source / std::format("Def{}.c4d", i));
+			}
+
+			// like the engine, which sorts child groups while packing them
+			C4Group_SetSortList(C4CFN_FLS);
+			C4Group_SetTempPath(path.string().c_str());
+			filename = (path / "Objects.c4d").string();
+			REQUIRE(C4Group_PackDirectoryTo(source.string().c_str(), filename.c_str()));
+			C4Group_SetTempPath(nullptr);
+			C4Group_SetSortList(nullptr);
+
+			if (seekable)
+			{
+				C4Group group;
+				REQUIRE(group.Open(filename.c_str()));
+				REQUIRE(group.SetSeekable(true));
+				REQUIRE(group.Close());
+			}
+		}
+
+		~PackedDefinitions() { std::filesystem::remove_all(path); }
+
+		const char *GetFilename() const { return filename.c_str(); }
+
+	private:
+		std::filesystem::path path;
+		std::string filename;
+	};
+
+	// reads every entry of every definition like C4DefList::Load does
+	// out of order, the last entry is looked up first, which makes the file go back for the others
+	std::size_t LoadDefinitions(const char *const filename, const bool readAhead, const bool outOfOrder)
+	{
+		C4Group group;
+		REQUIRE(group.Open(filename));
+		if (readAhead)
+		{
+			REQUIRE(group.StartReadAhead());
+		}
+
+		std::size_t loaded{0};
+		char defName[_MAX_FNAME + 1];
+		group.ResetSearch();
+		while (group.FindNextEntry("*.c4d", defName))
+		{
+			C4Group def;
+			REQUIRE(def.OpenAsChild(&group, defName));
+
+			std::vector<std::string> entries;
+			char entryName[_MAX_FNAME + 1];
+			def.ResetSearch();
+			while (def.FindNextEntry("*", entryName))
+			{
+				entries.emplace_back(entryName);
+			}
+			if (outOfOrder)
+			{
+				entries.insert(entries.begin(), entries.back());
+				entries.pop_back();
+			}
+
+			for (const auto &entry : entries)
+			{
+				StdBuf buf;
+				REQUIRE(def.LoadEntry(entry.c_str(), buf));
+				loaded += buf.getSize();
+			}
+		}
+		return loaded;
+	}
+}
+
+TEST_CASE("Read-ahead reads the same as the group file", "[C4Group]")
+{
+	for (const bool seekable : {false, true})
+	{
+		PackedDefinitions packed{seekable};
+		for (const bool outOfOrder : {false, true})
+		{
+			CHECK(LoadDefinitions(packed.GetFilename(), true, outOfOrder) == LoadDefinitions(packed.GetFilename(), false, outOfOrder));
+		}
+	}
+}
+
+TEST_CASE("Definition group loading benchmark", "[C4Group][.][benchmark]")
+{
+	for (const bool seekable : {false, true})
+	{
+		PackedDefinitions packed{seekable};
+		for (const bool outOfOrder : {false, true})
+		{
+			for (const bool readAhead : {false, true})
+			{
+				BENCHMARK(std::format("{} definitions, {}, {}, {}", DefinitionCount, seekable ? "seekable" : "not seekable", outOfOrder ? "out of order" : "in order", readAhead ? "read-ahead" : "direct"))
+				{
+					return LoadDefinitions(packed.GetFilename(), readAhead, outOfOrder);
+				};
+			}
+		}
+	}
+}
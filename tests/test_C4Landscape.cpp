@@ -0,0 +1,83 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Landscape.h"
+#include "C4Material.h"
+#include "C4ThreadPool.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <random>
+
+namespace
+{
+	class TestLandscape : public C4Landscape
+	{
+	public:
+		using C4Landscape::ChunkOZoom;
+		using C4Landscape::ZoomInBands;
+	};
+}
+
+TEST_CASE("Zooming a map in row bands gives the same landscape as zooming it serially", "[C4Landscape]")
+{
+	if (!C4ThreadPool::Global) C4ThreadPool::Global = std::make_shared<C4ThreadPool>();
+
+	constexpr int MapWdt{48}, MapHgt{64}, Zoom{8};
+	constexpr std::array ChunkTypes{C4M_Flat, C4M_TopFlat, C4M_Smooth, C4M_Rough};
+
+	// random map using one texture per chunk type, some of them underground
+	CSurface8 map{MapWdt, MapHgt};
+	std::mt19937 random{42};
+	for (int y = 0; y < MapHgt; ++y)
+		for (int x = 0; x < MapWdt; ++x)
+		{
+			const auto texture = static_cast<uint8_t>(random() % (ChunkTypes.size() + 1));
+			map.SetPix(x, y, texture && random() % 2 ? texture | IFT : texture);
+		}
+
+	TestLandscape landscape;
+	landscape.MapZoom = Zoom;
+	landscape.MapSeed = 1234;
+
+	const auto zoom = [&](CSurface8 &target)
+	{
+		for (std::size_t texture = 1; texture <= ChunkTypes.size(); ++texture)
+			landscape.ChunkOZoom(target, &map, 0, 0, MapWdt, MapHgt, static_cast<int32_t>(texture), ChunkTypes[texture - 1]);
+	};
+
+	// part of a larger landscape, like MapToLandscape zooming a segment
+	CSurface8 serial{MapWdt * Zoom, MapHgt * Zoom}, banded{MapWdt * Zoom, MapHgt * Zoom};
+	for (CSurface8 *const surface : {&serial, &banded})
+	{
+		std::memset(surface->Bits, 0, surface->Pitch * surface->Hgt);
+		surface->Clip(Zoom, 3 * Zoom + 5, (MapWdt - 2) * Zoom, (MapHgt - 1) * Zoom - 3);
+	}
+
+	TestLandscape::ZoomInBands(serial, zoom, 1);
+	TestLandscape::ZoomInBands(banded, zoom, 7);
+
+	REQUIRE(serial.Pitch == banded.Pitch);
+	CHECK(std::memcmp(serial.Bits, banded.Bits, serial.Pitch * serial.Hgt) == 0);
+
+	// the zoom actually drew something
+	std::size_t drawn{0};
+	for (int i = 0; i < serial.Pitch * serial.Hgt; ++i)
+		if (serial.Bits[i]) ++drawn;
+	CHECK(drawn > 0);
+}
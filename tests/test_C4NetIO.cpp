@@ -0,0 +1,312 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4NetIO.h"
+#include "StdScheduler.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <initializer_list>
+#include <vector>
+
+namespace
+{
+	constexpr std::uint16_t BasePort{41100};
+
+	C4NetIO::addr_t LocalAddr(const std::uint16_t port)
+	{
+		return C4NetIO::addr_t{StdStrBuf{std::format("127.0.0.1:{}", port).c_str()}};
+	}
+
+	class Collector : public C4NetIO::CBClass
+	{
+	public:
+		std::vector<std::vector<std::uint8_t>> Packets;
+		C4NetIO::addr_t Peer;
+		bool Connected{false};
+
+	public:
+		bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO) override
+		{
+			Peer = AddrPeer;
+			Connected = true;
+			return true;
+		}
+
+		void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+		{
+			const auto data = rPacket.getPtr<std::uint8_t>();
+			Packets.emplace_back(data, data + rPacket.getSize());
+		}
+	};
+
+	// exposes the switch between batched and per-datagram socket i/o
+	template<typename NetIO>
+	class TestNetIO : public NetIO
+	{
+	public:
+#ifdef __linux__
+		using NetIO::SetBatchIO;
+#else
+		void SetBatchIO(bool) {}
+#endif
+	};
+
+	template<typename Condition>
+	bool ExecuteUntil(const std::initializer_list<C4NetIO *> netIOs, Condition &&condition)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+		while (!condition())
+		{
+			if (std::chrono::steady_clock::now() > deadline) return false;
+			for (C4NetIO *const netIO : netIOs) netIO->Execute(10);
+		}
+		return true;
+	}
+}
+
+TEST_CASE("C4NetIOSimpleUDP::SendBatch delivers every datagram", "[C4NetIO]")
+{
+	TestNetIO<C4NetIOSimpleUDP> sender, receiver;
+	Collector collector;
+	receiver.SetCallback(&collector);
+	REQUIRE(sender.Init(BasePort));
+	REQUIRE(receiver.Init(BasePort + 1));
+
+	bool batched{true};
+	SECTION("Batched") {}
+	SECTION("One datagram per system call, as when the kernel doesn't support batching")
+	{
+		batched = false;
+		sender.SetBatchIO(false);
+		receiver.SetBatchIO(false);
+	}
+
+	// more than two batches; recvmmsg must not cut a batch short at an empty datagram
+	// (reading one by one stops at empty datagrams, so they are only sent when batching)
+	constexpr std::size_t PacketCount{40}, EmptyPacket{20};
+	std::vector<C4NetIOPacket> packets;
+	for (std::size_t i = 0; i < PacketCount; ++i)
+	{
+		std::vector<std::uint8_t> data(i == EmptyPacket && batched ? 0 : 100 + i, static_cast<std::uint8_t>(i));
+		packets.emplace_back(data.data(), data.size(), true, LocalAddr(BasePort + 1));
+	}
+	const std::size_t expectedCount{batched ? PacketCount - 1 : PacketCount};
+
+	REQUIRE(sender.SendBatch(packets));
+	REQUIRE(ExecuteUntil({&receiver}, [&] { return collector.Packets.size() == expectedCount; }));
+
+	std::ranges::sort(collector.Packets, {}, [](const auto &packet) { return packet.size(); });
+	for (std::size_t i = 0, packet = 0; i < PacketCount; ++i)
+	{
+		if (i == EmptyPacket && batched) continue;
+		CHECK(collector.Packets[packet] == std::vector<std::uint8_t>(100 + i, static_cast<std::uint8_t>(i)));
+		++packet;
+	}
+
+	C4NetIO::BatchStatistic sendStat, recvStat;
+	REQUIRE(sender.GetStatistic(nullptr, &sendStat));
+	REQUIRE(receiver.GetStatistic(nullptr, &recvStat));
+	CHECK(sendStat.SendPackets == static_cast<int>(PacketCount));
+	CHECK(recvStat.RecvPackets >= static_cast<int>(expectedCount));
+#ifdef __linux__
+	if (batched)
+	{
+		CHECK(sendStat.SendCalls == 3);
+		CHECK(recvStat.RecvCalls < static_cast<int>(expectedCount));
+	}
+	else
+#endif
+	{
+		CHECK(sendStat.SendCalls == static_cast<int>(PacketCount));
+		CHECK(recvStat.RecvCalls >= static_cast<int>(expectedCount));
+	}
+}
+
+TEST_CASE("C4NetIOUDP delivers packets that are split into more fragments than fit into one batch", "[C4NetIO]")
+{
+	TestNetIO<C4NetIOUDP> host, client;
+	Collector hostCollector, clientCollector;
+	host.SetCallback(&hostCollector);
+	client.SetCallback(&clientCollector);
+	REQUIRE(host.Init(BasePort + 2));
+	REQUIRE(client.Init(BasePort + 3));
+
+	SECTION("Batched") {}
+	SECTION("One datagram per system call")
+	{
+		host.SetBatchIO(false);
+		client.SetBatchIO(false);
+	}
+
+	REQUIRE(client.Connect(LocalAddr(BasePort + 2)));
+	REQUIRE(ExecuteUntil({&host, &client}, [&] { return hostCollector.Connected && clientCollector.Connected; }));
+
+	// 16 KiB are a few dozen fragments
+	std::vector<std::uint8_t> data(16 * 1024);
+	for (std::size_t i = 0; i < data.size(); ++i) data[i] = static_cast<std::uint8_t>(i * 7);
+
+	REQUIRE(client.Send(C4NetIOPacket(data.data(), data.size(), true, clientCollector.Peer)));
+	REQUIRE(ExecuteUntil({&host, &client}, [&hostCollector] { return !hostCollector.Packets.empty(); }));
+	REQUIRE(hostCollector.Packets.size() == 1);
+	CHECK(hostCollector.Packets.front() == data);
+
+	C4NetIO::BatchStatistic stat;
+	REQUIRE(client.GetStatistic(nullptr, &stat));
+	CHECK(stat.SendPackets > 16);
+}
+
+#ifndef _WIN32
+
+namespace
+{
+	// checks that every change of a proc's descriptor set since the last check was announced by FDsChanged
+	class FDsTracker
+	{
+	public:
+		explicit FDsTracker(StdSchedulerProc &proc) : proc{proc}, revision{proc.GetFDsRevision()} { proc.GetFDs(fds); }
+
+		void Check()
+		{
+			const std::uint32_t newRevision{proc.GetFDsRevision()};
+			std::vector<pollfd> newFDs;
+			proc.GetFDs(newFDs);
+
+			if (!std::ranges::equal(newFDs, fds, [](const pollfd &fd1, const pollfd &fd2) { return fd1.fd == fd2.fd && fd1.events == fd2.events; }))
+			{
+				CHECK(newRevision != revision);
+			}
+
+			fds = std::move(newFDs);
+			revision = newRevision;
+		}
+
+	private:
+		StdSchedulerProc &proc;
+		std::vector<pollfd> fds;
+		std::uint32_t revision;
+	};
+
+	class PipeProc : public StdSchedulerProc
+	{
+	public:
+		int FD{-1};
+		int GetFDsCalls{0};
+		int Executions{0};
+
+	public:
+		bool Execute(int) override
+		{
+			char c;
+			CHECK(read(FD, &c, 1) == 1);
+			++Executions;
+			return true;
+		}
+
+		void GetFDs(std::vector<pollfd> &fds) override
+		{
+			++GetFDsCalls;
+			fds.push_back({.fd = FD, .events = POLLIN});
+		}
+	};
+}
+
+TEST_CASE("C4NetIOTCP announces every change of its descriptor set", "[C4NetIO][StdScheduler]")
+{
+	C4NetIOTCP host, client;
+	Collector hostCollector, clientCollector;
+	host.SetCallback(&hostCollector);
+	client.SetCallback(&clientCollector);
+
+	FDsTracker hostFDs{host}, clientFDs{client};
+	const auto execute = [&](auto &&condition)
+	{
+		return ExecuteUntil({&host, &client}, [&]
+		{
+			hostFDs.Check();
+			clientFDs.Check();
+			return condition();
+		});
+	};
+
+	REQUIRE(host.Init(BasePort + 4));
+	hostFDs.Check();
+	REQUIRE(client.Init());
+	clientFDs.Check();
+
+	// connect wait, then a peer
+	REQUIRE(client.Connect(LocalAddr(BasePort + 4)));
+	clientFDs.Check();
+	REQUIRE(execute([&] { return hostCollector.Connected && clientCollector.Connected; }));
+
+	// more than fits into the socket buffers, so the client waits for writeability for a while
+	std::vector<std::uint8_t> data(16 * 1024 * 1024, 42);
+	REQUIRE(client.Send(C4NetIOPacket(data.data(), data.size(), false, clientCollector.Peer)));
+	clientFDs.Check();
+	REQUIRE(execute([&] { return !hostCollector.Packets.empty(); }));
+	CHECK(hostCollector.Packets.front().size() == data.size());
+
+	REQUIRE(client.Close(clientCollector.Peer));
+	clientFDs.Check();
+	REQUIRE(host.Close());
+	hostFDs.Check();
+}
+
+TEST_CASE("StdScheduler only collects the descriptors of procs that changed them", "[StdScheduler]")
+{
+	int pipe1[2], pipe2[2];
+	REQUIRE(pipe(pipe1) == 0);
+	REQUIRE(pipe(pipe2) == 0);
+
+	StdScheduler scheduler;
+	PipeProc proc;
+	proc.FD = pipe1[0];
+	scheduler.Add(&proc);
+
+	const auto signal = [](const int fd)
+	{
+		const char c{1};
+		REQUIRE(write(fd, &c, 1) == 1);
+	};
+
+	scheduler.Execute(0);
+	scheduler.Execute(0);
+	signal(pipe1[1]);
+	scheduler.Execute(1000);
+	CHECK(proc.Executions == 1);
+#ifdef __linux__
+	CHECK(proc.GetFDsCalls == 1);
+#endif
+
+	// a new descriptor that might even have the number of a closed one
+	proc.FD = pipe2[0];
+	proc.FDsChanged();
+	scheduler.Execute(0);
+	signal(pipe2[1]);
+	scheduler.Execute(1000);
+	CHECK(proc.Executions == 2);
+#ifdef __linux__
+	CHECK(proc.GetFDsCalls == 2);
+#endif
+
+	scheduler.Remove(&proc);
+	for (const int fd : {pipe1[0], pipe1[1], pipe2[0], pipe2[1]}) close(fd);
+}
+
+#endif
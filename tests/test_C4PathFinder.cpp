@@ -0,0 +1,289 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Landscape.h"
+#include "C4Material.h"
+#include "C4Object.h"
+#include "C4PathFinder.h"
+#include "C4Surface.h"
+#include "C4TransferZone.h"
+#include "C4Wrappers.h"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr uint8_t PixFree{1}, PixSolid{2};
+
+	// landscape without materials and graphics: hills with a pillar every 256 pixels
+	class TestLandscape : public C4Landscape
+	{
+	public:
+		using C4Landscape::FinishChange;
+
+		TestLandscape(const int32_t wdt, const int32_t hgt)
+		{
+			Width = wdt; Height = hgt;
+			Surface8 = new CSurface8{wdt, hgt};
+			Surface32 = new C4Surface; // without textures, relighting does nothing
+			std::fill_n(Pix2Mat, 256, MNone);
+			std::fill_n(Pix2Dens, 256, 0);
+			std::fill_n(Pix2Place, 256, 0);
+			Pix2Dens[PixSolid] = C4M_Solid;
+			for (int32_t x = 0; x < wdt; ++x)
+				for (int32_t y = 0; y < hgt; ++y)
+					Surface8->SetPix(x, y, IsTerrainSolid(x, y) ? PixSolid : PixFree);
+			PixCntPitch = (hgt + 14) / 15;
+			PixCnt = new uint8_t[((wdt + 16) / 17) * PixCntPitch];
+			UpdatePixCnt(C4Rect(0, 0, wdt, hgt));
+			ScanColumnDirty.assign(wdt, false);
+			InitSyncHashes();
+		}
+
+		int32_t GroundY(const int32_t x) const
+		{
+			return Height * 2 / 3 + static_cast<int32_t>(Height / 8 * std::sin(x / 97.0) + Height / 16 * std::sin(x / 23.0));
+		}
+
+		static bool IsPillar(const int32_t x) { return x % 256 >= 128 && x % 256 < 144; }
+
+		bool IsTerrainSolid(const int32_t x, const int32_t y) const
+		{
+			const int32_t ground{GroundY(x)};
+			return y >= ground || (IsPillar(x) && y >= ground - Height / 3);
+		}
+
+		// free position a clonk could stand at, next to x
+		std::pair<int32_t, int32_t> SurfacePoint(int32_t x) const
+		{
+			if (IsPillar(x)) x += 16;
+			return {x, GroundY(x) - 5};
+		}
+
+		// fill a rectangle without _SetPix, like the landscape drawing functions
+		void DrawRect(const C4Rect &rect, const uint8_t pix)
+		{
+			for (int32_t x = rect.x; x < rect.x + rect.Wdt; ++x)
+				for (int32_t y = rect.y; y < rect.y + rect.Hgt; ++y)
+					Surface8->SetPix(x, y, pix);
+			FinishChange(rect);
+		}
+	};
+
+	TestLandscape *CurrentLandscape{nullptr};
+
+	bool TestLandscapeFree(const int32_t x, const int32_t y)
+	{
+		if (x < 0 || y < 0 || x >= CurrentLandscape->Width || y >= CurrentLandscape->Height) return false;
+		return !DensitySolid(CurrentLandscape->GetDensity(x, y));
+	}
+
+	using Waypoints = std::vector<std::tuple<int32_t, int32_t, intptr_t>>;
+
+	bool RecordWaypoint(const int32_t x, const int32_t y, const intptr_t transferTarget, const intptr_t waypoints)
+	{
+		reinterpret_cast<Waypoints *>(waypoints)->emplace_back(x, y, transferTarget);
+		return true;
+	}
+
+	struct PathResult
+	{
+		bool Found;
+		Waypoints Path;
+
+		bool operator==(const PathResult &) const = default;
+	};
+
+	PathResult FindPath(C4PathFinder &pathFinder, const int32_t fromX, const int32_t fromY, const int32_t toX, const int32_t toY)
+	{
+		PathResult result;
+		result.Found = pathFinder.Find(fromX, fromY, toX, toY, &RecordWaypoint, reinterpret_cast<intptr_t>(&result.Path));
+		return result;
+	}
+
+	// the same search without any cached results
+	PathResult FindPathUncached(C4TransferZones *const transferZones, const int32_t fromX, const int32_t fromY, const int32_t toX, const int32_t toY)
+	{
+		C4PathFinder pathFinder;
+		pathFinder.Init(&TestLandscapeFree, transferZones, CurrentLandscape);
+		return FindPath(pathFinder, fromX, fromY, toX, toY);
+	}
+
+	struct LandscapeScope
+	{
+		explicit LandscapeScope(TestLandscape &landscape) { CurrentLandscape = &landscape; }
+		~LandscapeScope() { CurrentLandscape = nullptr; }
+	};
+}
+
+TEST_CASE("Cached paths are the same as searched ones", "[C4PathFinder]")
+{
+	TestLandscape landscape{1024, 256};
+	LandscapeScope scope{landscape};
+	C4TransferZones transferZones;
+	C4PathFinder pathFinder;
+	pathFinder.Init(&TestLandscapeFree, &transferZones, &landscape);
+
+	std::vector<std::pair<int32_t, int32_t>> points;
+	for (int32_t x = 40; x < landscape.Width; x += 150)
+		points.emplace_back(landscape.SurfacePoint(x));
+
+	int found{0};
+	for (const auto &[fromX, fromY] : points)
+		for (const auto &[toX, toY] : points)
+		{
+			if (fromX == toX) continue;
+			const PathResult searched{FindPath(pathFinder, fromX, fromY, toX, toY)};
+			CHECK(searched == FindPathUncached(&transferZones, fromX, fromY, toX, toY));
+			if (searched.Found) ++found;
+
+			const uint32_t hits{pathFinder.GetCacheHits()};
+			CHECK(FindPath(pathFinder, fromX, fromY, toX, toY) == searched);
+			CHECK(pathFinder.GetCacheHits() == hits + 1);
+		}
+	// not all of them fail at the pillars
+	CHECK(found > 0);
+}
+
+TEST_CASE("Landscape changes invalidate cached paths", "[C4PathFinder]")
+{
+	TestLandscape landscape{1024, 256};
+	LandscapeScope scope{landscape};
+	C4TransferZones transferZones;
+	C4PathFinder pathFinder;
+	pathFinder.Init(&TestLandscapeFree, &transferZones, &landscape);
+
+	// over the first pillar
+	const auto [fromX, fromY] = landscape.SurfacePoint(40);
+	const auto [toX, toY] = landscape.SurfacePoint(240);
+	REQUIRE(FindPath(pathFinder, fromX, fromY, toX, toY).Found);
+
+	const auto expectCached = [&](const bool cached)
+	{
+		const uint32_t hits{pathFinder.GetCacheHits()};
+		const PathResult result{FindPath(pathFinder, fromX, fromY, toX, toY)};
+		CHECK(result == FindPathUncached(&transferZones, fromX, fromY, toX, toY));
+		CHECK(pathFinder.GetCacheHits() == hits + (cached ? 1 : 0));
+		return result;
+	};
+
+	SECTION("Pixels changed by _SetPix")
+	{
+		// a change far away doesn't matter
+		landscape._SetPix(900, 10, PixSolid);
+		expectCached(true);
+
+		// a hole through the pillar
+		const int32_t holeY{landscape.GroundY(136) - 8};
+		for (int32_t x = 128; x < 144; ++x)
+			for (int32_t y = holeY - 15; y < holeY; ++y)
+				landscape._SetPix(x, y, PixFree);
+		expectCached(false);
+		expectCached(true);
+	}
+
+	SECTION("Areas changed by FinishChange")
+	{
+		landscape.DrawRect(C4Rect(850, 10, 20, 20), PixSolid);
+		expectCached(true);
+
+		// a wall on top of the pillar
+		landscape.DrawRect(C4Rect(128, 0, 16, landscape.GroundY(136) - landscape.Height / 3), PixSolid);
+		expectCached(false);
+		expectCached(true);
+	}
+
+	SECTION("Transfer zones set")
+	{
+		auto object = std::make_unique<C4Object>();
+
+		// zones are ignored if disabled for the searching object
+		pathFinder.EnableTransferZones(false);
+		FindPath(pathFinder, fromX, fromY, toX, toY);
+		transferZones.Set(900, 10, 20, 20, object.get());
+		expectCached(true);
+		pathFinder.EnableTransferZones(true);
+
+		// the zone might be in the way
+		expectCached(false);
+		expectCached(true);
+		// moving it
+		transferZones.Set(920, 10, 20, 20, object.get());
+		expectCached(false);
+		// setting it to the same area again changes nothing
+		transferZones.Set(920, 10, 20, 20, object.get());
+		expectCached(true);
+		transferZones.ClearPointers(object.get());
+		expectCached(false);
+	}
+}
+
+TEST_CASE("Path finder benchmark", "[C4PathFinder][.][benchmark]")
+{
+	// a crew of clonks that repeat their MoveTo searches every Tick35, while the landscape is dug at random places
+	TestLandscape landscape{4096, 512};
+	LandscapeScope scope{landscape};
+	C4TransferZones transferZones;
+
+	constexpr int CrewSize{40};
+	std::vector<std::pair<int32_t, int32_t>> positions;
+	for (int i = 0; i < CrewSize; ++i)
+		positions.emplace_back(landscape.SurfacePoint(60 + i * 97 % (landscape.Width - 120)));
+	const std::pair<int32_t, int32_t> targets[]{landscape.SurfacePoint(300), landscape.SurfacePoint(2000), landscape.SurfacePoint(3500)};
+
+	for (const bool cached : {false, true})
+	{
+		C4PathFinder pathFinder;
+		pathFinder.Init(&TestLandscapeFree, &transferZones, &landscape);
+		std::mt19937 random{42};
+
+		BENCHMARK(std::format("Searches of {} clonks in one frame, {}", CrewSize, cached ? "cached" : "uncached"))
+		{
+			// dig a little like the clonks would between two searches
+			for (int i = 0; i < 5; ++i)
+			{
+				const int32_t x{static_cast<int32_t>(random() % landscape.Width)};
+				landscape._SetPix(x, landscape.GroundY(x) + static_cast<int32_t>(random() % 3), PixFree);
+			}
+
+			int found{0};
+			for (int i = 0; i < CrewSize; ++i)
+			{
+				if (!cached) pathFinder.Init(&TestLandscapeFree, &transferZones, &landscape);
+				const auto &[fromX, fromY] = positions[i];
+				const auto &[toX, toY] = targets[i % std::size(targets)];
+				if (FindPath(pathFinder, fromX, fromY, toX, toY).Found) ++found;
+			}
+			return found;
+		};
+
+		if (cached)
+		{
+			const uint32_t searches{pathFinder.GetCacheHits() + pathFinder.GetCacheMisses()};
+			WARN(std::format("Cache hit rate: {}% of {} searches", searches ? 100 * pathFinder.GetCacheHits() / searches : 0, searches));
+		}
+	}
+}
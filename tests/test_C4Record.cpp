@@ -0,0 +1,138 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Components.h"
+#include "C4Control.h"
+#include "C4Game.h"
+#include "C4Group.h"
+#include "C4Record.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	std::vector<C4PacketType> PacketTypes(const C4Control &control)
+	{
+		std::vector<C4PacketType> types;
+		for (C4IDPacket *pkt = control.firstPkt(); pkt; pkt = control.nextPkt(pkt))
+			types.push_back(pkt->getPktType());
+		return types;
+	}
+
+	// a savegame directory; the record only moves it around
+	std::filesystem::path CreateSavegame(const std::filesystem::path &path)
+	{
+		std::filesystem::create_directories(path);
+		std::ofstream{path / C4CFN_ScenarioCore} << "[Head]\n";
+		return path;
+	}
+
+	class TempDirectory
+	{
+	public:
+		TempDirectory() : path{std::filesystem::temp_directory_path() / "C4RecordTest"}
+		{
+			std::filesystem::remove_all(path);
+			std::filesystem::create_directories(path);
+		}
+
+		~TempDirectory() { std::filesystem::remove_all(path); }
+
+		const std::filesystem::path path;
+	};
+}
+
+TEST_CASE("Replays seek to record keyframes", "[C4Record]")
+{
+	TempDirectory temp;
+	const std::filesystem::path recordPath{CreateSavegame(temp.path / "Record.c4s")};
+
+	// control of frame 20 up to its synchronization is contained in the keyframe saved during that synchronization
+	{
+		C4Record record;
+		Game.FrameCounter = 0;
+		REQUIRE(record.Open(recordPath.string().c_str()));
+
+		C4Control control;
+		control.Add(CID_Script, new C4ControlScript("1"));
+		REQUIRE(record.Rec(control, 10));
+
+		control.Clear();
+		control.Add(CID_PlrCommand, new C4ControlPlayerCommand(0, 0, 0, 0, nullptr, nullptr, 0, 0));
+		control.Add(CID_Synchronize, new C4ControlSynchronize(false, false));
+		control.Add(CID_Script, new C4ControlScript("2"));
+		REQUIRE(record.Rec(control, 20));
+		Game.FrameCounter = 20;
+		REQUIRE(record.AddKeyframe(CreateSavegame(temp.path / "Keyframe.tmp").string().c_str()));
+
+		control.Clear();
+		control.Add(CID_Script, new C4ControlScript("3"));
+		REQUIRE(record.Rec(control, 30));
+	}
+	const std::string keyframeName{std::format(C4CFN_RecKeyframe, 20)};
+	REQUIRE(std::filesystem::is_directory(recordPath / keyframeName));
+	REQUIRE_FALSE(std::filesystem::exists(temp.path / "Keyframe.tmp"));
+
+	C4Group recordGrp;
+	REQUIRE(recordGrp.Open(recordPath.string().c_str()));
+
+	// seeking back behind the keyframe restarts from it, but only once the main loop gets to it
+	{
+		C4Playback playback{std::make_shared<spdlog::logger>("C4Playback")};
+		Game.FrameCounter = 0;
+		REQUIRE(playback.Open(recordGrp));
+
+		Game.FrameCounter = 35;
+		REQUIRE(playback.Seek(25));
+		CHECK(Game.SeekFrame == 25);
+		CHECK(std::filesystem::path{Game.SeekRestart} == recordPath / keyframeName);
+
+		// seeking back before the keyframe restarts from the record
+		REQUIRE(playback.Seek(15));
+		CHECK(Game.SeekFrame == 15);
+		CHECK(std::filesystem::path{Game.SeekRestart} == recordPath);
+		Game.SeekRestart.clear();
+
+		// seeking ahead without a keyframe in between just fast forwards
+		Game.FrameCounter = 20;
+		REQUIRE(playback.Seek(28));
+		CHECK(Game.SeekFrame == 28);
+		CHECK(Game.SeekRestart.empty());
+	}
+	Game.SeekFrame = 0;
+
+	// the restarted game continues after the synchronization
+	C4Group keyframeGrp;
+	REQUIRE(keyframeGrp.OpenAsChild(&recordGrp, keyframeName.c_str()));
+	C4Playback playback{std::make_shared<spdlog::logger>("C4Playback")};
+	Game.FrameCounter = 20;
+	REQUIRE(playback.Open(keyframeGrp));
+
+	C4Control control;
+	REQUIRE(playback.ExecuteControl(&control, 20));
+	CHECK(PacketTypes(control) == std::vector{CID_Script});
+
+	control.Clear();
+	REQUIRE(playback.ExecuteControl(&control, 30));
+	CHECK(PacketTypes(control) == std::vector{CID_Script});
+
+	Game.FrameCounter = 0;
+}
@@ -0,0 +1,86 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4SyncHash.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <unordered_set>
+
+TEST_CASE("C4SyncHashMix is the splitmix64 finalizer", "[C4SyncHash]")
+{
+	// sync hashes must be the same on every platform and compiler
+	STATIC_CHECK(C4SyncHashMix(0) == 0);
+	STATIC_CHECK(C4SyncHashMix(1) == 0x100b05e5);
+	STATIC_CHECK(C4SyncHashMix(2) == 0x3a2b148a);
+	STATIC_CHECK(C4SyncHashMix(0xdeadbeef) == 0xec929eea);
+	STATIC_CHECK(C4SyncHashMix(uint64_t{1} << 63) == 0x79cea98a);
+}
+
+TEST_CASE("C4SyncHashMix distributes similar keys", "[C4SyncHash]")
+{
+	// like neighbouring pixels and object numbers
+	std::unordered_set<uint32_t> hashes;
+	for (uint64_t key = 1; key <= 4096; ++key)
+		hashes.insert(C4SyncHashMix(key));
+	CHECK(hashes.size() == 4096);
+
+	// flipping a single key bit changes about half of the hash bits
+	int flipped{0}, samples{0};
+	for (uint64_t key = 1; key <= 256; ++key)
+		for (int bit = 0; bit < 64; ++bit)
+		{
+			flipped += std::popcount(C4SyncHashMix(key) ^ C4SyncHashMix(key ^ (uint64_t{1} << bit)));
+			++samples;
+		}
+	CHECK(flipped > samples * 15);
+	CHECK(flipped < samples * 17);
+}
+
+TEST_CASE("C4SyncHashOf depends on values and their order", "[C4SyncHash]")
+{
+	CHECK(C4SyncHashOf(1, 2, 3) == C4SyncHashOf(1, 2, 3));
+	CHECK(C4SyncHashOf(1, 2, 3) != C4SyncHashOf(3, 2, 1));
+	CHECK(C4SyncHashOf(1, 2, 3) != C4SyncHashOf(1, 2, 4));
+	// negative values hash like their two's complement bit pattern
+	CHECK(C4SyncHashOf(-1) == C4SyncHashOf(0xffffffffu));
+}
+
+TEST_CASE("Sync check regions partition positions consistently", "[C4SyncHash]")
+{
+	for (int32_t count = 1; count <= 200; ++count)
+	{
+		CHECK(C4SyncCheckRegionBegin(count, 0) == 0);
+		CHECK(C4SyncCheckRegionBegin(count, C4SyncCheckRegions) == count);
+		for (int32_t region = 0; region < C4SyncCheckRegions; ++region)
+		{
+			// regions are contiguous and evenly sized
+			const int32_t begin{C4SyncCheckRegionBegin(count, region)}, end{C4SyncCheckRegionBegin(count, region + 1)};
+			CHECK(begin <= end);
+			CHECK(end - begin <= count / C4SyncCheckRegions + 1);
+			// every position is mapped to the region whose range contains it, as logged on sync losses
+			for (int32_t pos = begin; pos < end; ++pos)
+				CHECK(C4SyncCheckRegionOf(pos, count) == region);
+		}
+	}
+
+	// object numbers beyond the enumeration index and without one end up in the outer regions
+	CHECK(C4SyncCheckRegionOf(-5, 100) == 0);
+	CHECK(C4SyncCheckRegionOf(100, 100) == C4SyncCheckRegions - 1);
+	CHECK(C4SyncCheckRegionOf(int64_t{1} << 40, 100) == C4SyncCheckRegions - 1);
+	CHECK(C4SyncCheckRegionOf(5, 0) == 0);
+}
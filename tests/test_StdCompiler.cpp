@@ -0,0 +1,144 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2023, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Control.h"
+#include "C4Def.h"
+#include "C4Game.h"
+#include "C4Object.h"
+#include "StdCompiler.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+namespace
+{
+	// a control like the ones sent each control tick, with a mix of small packets
+	void FillControl(C4Control &control, const int packetCount)
+	{
+		for (int i{0}; i < packetCount; ++i)
+		{
+			if (i % 4 == 3)
+			{
+				control.Add(CID_Script, new C4ControlScript(std::format("SetWealth({}, {})", i % 8, i).c_str()));
+			}
+			else
+			{
+				control.Add(CID_PlrCommand, new C4ControlPlayerCommand(i % 8, i % 16, i * 3, i * 5, nullptr, nullptr, i, 0));
+			}
+		}
+	}
+
+	// objects of a dummy definition in Game.Objects, which are saved like those of a running game
+	class SavedObjects
+	{
+	public:
+		explicit SavedObjects(const int count)
+		{
+			def.id = C4Id("TEST");
+			for (int i{0}; i < count; ++i)
+			{
+				auto &obj = objects.emplace_back(std::make_unique<C4Object>());
+				obj->Def = &def;
+				obj->id = def.id;
+				obj->pGraphics = &def.Graphics;
+				obj->Number = i + 1;
+				obj->x = i % 1000;
+				obj->y = i / 1000;
+				obj->Energy = i;
+				obj->Local.SetSize(4);
+				obj->Local[i % 4] = C4VInt(i);
+				REQUIRE(Game.Objects.C4ObjectList::Add(obj.get(), C4ObjectList::stNone));
+			}
+		}
+
+		~SavedObjects()
+		{
+			for (const auto &obj : objects)
+			{
+				Game.Objects.C4ObjectList::Remove(obj.get());
+			}
+		}
+
+		bool Save(const char *const filename) { return Game.Objects.Save(filename, true, false); }
+
+	private:
+		C4Def def;
+		std::vector<std::unique_ptr<C4Object>> objects;
+	};
+}
+
+TEST_CASE("Binary control packing survives a round trip", "[StdCompiler]")
+{
+	C4Control control;
+	FillControl(control, 200);
+	const StdBuf packed{DecompileToBuf<StdCompilerBinWrite>(control)};
+	REQUIRE(packed.getSize() > 0);
+
+	C4Control unpacked;
+	CompileFromBuf<StdCompilerBinRead>(unpacked, packed);
+	const StdBuf repacked{DecompileToBuf<StdCompilerBinWrite>(unpacked)};
+
+	REQUIRE(repacked.getSize() == packed.getSize());
+	CHECK(std::memcmp(repacked.getData(), packed.getData(), packed.getSize()) == 0);
+}
+
+TEST_CASE("Growing a buffer keeps its contents", "[StdCompiler][StdBuf]")
+{
+	StdBuf buf;
+	for (std::uint8_t i{0}; i < 200; ++i)
+	{
+		buf.Append(&i, sizeof(i));
+	}
+	REQUIRE(buf.getSize() == 200);
+	for (std::uint8_t i{0}; i < 200; ++i)
+	{
+		CHECK(*buf.getPtr<std::uint8_t>(i) == i);
+	}
+
+	buf.Shrink(150);
+	REQUIRE(buf.getSize() == 50);
+	CHECK(*buf.getPtr<std::uint8_t>(49) == 49);
+}
+
+TEST_CASE("Serialization benchmark", "[StdCompiler][.][benchmark]")
+{
+	for (const int packetCount : {8, 1000})
+	{
+		C4Control control;
+		FillControl(control, packetCount);
+		BENCHMARK(std::format("Pack C4Control with {} packets", packetCount))
+		{
+			return DecompileToBuf<StdCompilerBinWrite>(control);
+		};
+	}
+
+	const std::string filename{(std::filesystem::temp_directory_path() / "StdCompilerBenchmarkObjects.txt").string()};
+	{
+		SavedObjects objects{5000};
+		BENCHMARK("C4GameObjects::Save with 5000 objects")
+		{
+			return objects.Save(filename.c_str());
+		};
+	}
+	std::filesystem::remove(filename);
+}